@@ -0,0 +1,228 @@
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef _WIN32
+    #include <io.h>
+    #define isatty _isatty
+    #define fileno _fileno
+#else
+    #include <unistd.h>
+#endif
+
+#include "aot.h"
+#include "object.h"
+#include "optimizer.h"
+#include "resolver.h"
+#include "typer.h"
+
+const Value aotNull = { .type = VALUE_NULL };
+
+static void** nodes;
+
+typedef struct {
+    int count;
+    int capacity;
+    void** nodes;
+} NodeList;
+
+static void addNode(NodeList* list, void* node) {
+    if (list->count + 1 > list->capacity) {
+        list->capacity = list->capacity < 8 ? 8 : list->capacity * 2;
+        list->nodes = realloc(list->nodes, sizeof(void*) * list->capacity);
+    }
+    list->nodes[list->count++] = node;
+}
+
+static void collectExpr(NodeList* list, Expr* expr) {
+    switch (expr->type) {
+        case EXPR_BINARY:
+            collectExpr(list, ((ExprBinary*)expr)->left);
+            collectExpr(list, ((ExprBinary*)expr)->right);
+            break;
+
+        case EXPR_UNARY:
+            collectExpr(list, ((ExprUnary*)expr)->right);
+            break;
+
+        case EXPR_POWMOD: {
+            ExprPowMod* powMod = (ExprPowMod*)expr;
+            collectExpr(list, powMod->base);
+            collectExpr(list, powMod->exponent);
+            collectExpr(list, powMod->modulus);
+            break;
+        }
+
+        case EXPR_IN: {
+            ExprIn* in = (ExprIn*)expr;
+            addNode(list, in);
+            collectExpr(list, in->element);
+            break;
+        }
+
+        case EXPR_MORPHISM: {
+            ExprMorphism* morph = (ExprMorphism*)expr;
+            collectExpr(list, morph->from);
+            collectExpr(list, morph->to);
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+static void collectStmts(NodeList* list, Stmt* stmt) {
+    for (; stmt != NULL; stmt = stmt->next) {
+        switch (stmt->type) {
+            case STMT_ASSIGN: {
+                StmtAssign* assign = (StmtAssign*)stmt;
+                if (assign->right->type == EXPR_CAT_INIT) {
+                    addNode(list, assign->right);
+                } else {
+                    collectExpr(list, assign->right);
+                }
+                break;
+            }
+
+            case STMT_PRINT:
+                collectExpr(list, ((StmtPrint*)stmt)->expr);
+                break;
+
+            case STMT_IF: {
+                StmtIf* ifStmt = (StmtIf*)stmt;
+                collectExpr(list, ifStmt->condition);
+                collectStmts(list, ifStmt->thenBranch);
+                collectStmts(list, ifStmt->elseBranch);
+                break;
+            }
+
+            case STMT_WHILE: {
+                StmtWhile* whileStmt = (StmtWhile*)stmt;
+                collectExpr(list, whileStmt->condition);
+                collectStmts(list, whileStmt->body);
+                break;
+            }
+
+            case STMT_CAT:
+                addNode(list, stmt);
+                break;
+        }
+    }
+}
+
+int aotCollectNodes(Stmt* stmts, void*** nodes) {
+    NodeList list = {0};
+    collectStmts(&list, stmts);
+    *nodes = list.nodes;
+    return list.count;
+}
+
+int aotMain(const char* source, size_t length, void (*program)(void), void (*release)(void)) {
+    OutputMode outputMode = isatty(fileno(stdout)) ? OUTPUT_LINE_BUFFERED
+                                                   : OUTPUT_BLOCK_BUFFERED;
+    initInterp(outputMode, ENGINE_TREE, JIT_OFF);
+
+    // The generator already parsed this source, so it cannot fail here
+    Ast* ast;
+    if (!parse(source, length, &ast)) return 70;
+    optimize(ast);
+    Stmt* stmts = ast->stmts;
+    resolve(stmts);
+    inferTypes(stmts);      // Already passed when the C was generated
+    aotCollectNodes(stmts, &nodes);
+
+    if (setjmp(interp.errJmpBuf) == 0) {
+        program();
+    } else {
+        abortStatement();
+        fprintf(stderr, "Runtime error occurred. Aborting interpretation.\n");
+    }
+
+    release();
+    free(nodes);
+    releaseAst(ast);
+    freeInterp();
+    return 0;
+}
+
+void aotUndefined(const char* name) {
+    runtimeError("Undefined variable '%s'.", name);
+}
+
+const Value* aotGlobal(int slot) {
+    Value* value = &interp.globals.values[slot];
+    if (value->type == VALUE_NULL) {
+        ObjString* name = interp.globals.names[slot];
+        runtimeError("Undefined variable '%.*s'.", name->length, name->chars);
+    }
+    return value;
+}
+
+void aotSetGlobal(int slot, const BigInt* num) {
+    Value value = { .type = VALUE_NUMBER, .number = bigint_copy(num) };
+    setGlobal(&interp.globals, slot, value);
+}
+
+void aotCheckNumbers(ValueType left, ValueType right) {
+    if (left != VALUE_NUMBER || right != VALUE_NUMBER) {
+        runtimeError("Binary operators can only be applied to numbers.\n"
+                        "But got values of types '%s' and '%s'",
+                        typeName(left), typeName(right));
+    }
+}
+
+void aotCheckUnary(ValueType type) {
+    if (type != VALUE_NUMBER) {
+        runtimeError("Unary operator can only be applied to numbers.\n"
+                        "But got value of type '%s'",
+                        typeName(type));
+    }
+}
+
+void aotDivide(BigInt* result, const BigInt* a, const BigInt* b) {
+    if (!bigint_divmod(result, NULL, a, b)) runtimeError("Division by zero.");
+}
+
+void aotModulo(BigInt* result, const BigInt* a, const BigInt* b) {
+    if (!bigint_divmod(NULL, result, a, b)) runtimeError("Division by zero.");
+}
+
+void aotPower(BigInt* result, const BigInt* a, const BigInt* b) {
+    if (bigint_is_negative(b)) runtimeError("Negative exponent.");
+    if (!bigint_pow(result, a, b)) runtimeError("Exponent too large.");
+}
+
+void aotPowMod(BigInt* result, const BigInt* base, const BigInt* exponent, const BigInt* modulus) {
+    if (bigint_is_negative(exponent)) runtimeError("Negative exponent.");
+    if (!bigint_powmod(result, base, exponent, modulus)) runtimeError("Division by zero.");
+}
+
+void aotPrint(const BigInt* num) {
+    writeNumber(&interp.out, num);
+    writeNewline(&interp.out);
+}
+
+void aotDefineTemplate(int node) {
+    interpretCategoryTemplate((StmtCat*)nodes[node]);
+}
+
+void aotInitCategory(int node, int slot) {
+    interpretCategory((ExprCatInit*)nodes[node], interp.globals.names[slot]);
+}
+
+RuntimeCategory* aotCategory(int node) {
+    return getCategory(((ExprIn*)nodes[node])->name);
+}
+
+bool aotInObject(RuntimeCategory* cat, const Value* obj) {
+    Value canonical;
+    return canonicalValue(obj, &canonical) && isObjectInCategory(cat, &canonical);
+}
+
+bool aotInMorphism(RuntimeCategory* cat, const Value* from, const Value* to) {
+    Value canonicalFrom, canonicalTo;
+    if (!canonicalValue(from, &canonicalFrom) || !canonicalValue(to, &canonicalTo)) return false;
+
+    return valuesEqual(canonicalFrom, canonicalTo)
+        ? isObjectInCategory(cat, &canonicalFrom)
+        : isMorphismInCategory(cat, &canonicalFrom, &canonicalTo);
+}
@@ -0,0 +1,145 @@
+#ifndef cryton_aot_h
+#define cryton_aot_h
+
+#include "interpreter.h"
+
+// Runtime for the C that `cryton --emit-c` writes. Variables that only hold
+// numbers are BigInts in the generated file; everything category code can
+// see stays in interp.globals, and categories themselves are built by the
+// interpreter from the program's own AST, parsed again at startup.
+
+// No BigInt is ever the null word, so it marks a variable not yet assigned
+#define AOT_UNDEFINED { 0 }
+#define AOT_NUMBER_VALUE(num) (&(Value){ .type = VALUE_NUMBER, .number = *(num) })
+
+// Stands for expressions that have no value, such as a bare morphism
+extern const Value aotNull;
+
+// Parses `source` for its category nodes, runs `program` and reports a
+// runtime error like the interpreter does. `release` frees the program's
+// variables either way.
+int aotMain(const char* source, size_t length, void (*program)(void), void (*release)(void));
+// The category nodes of a program in the order the code generator numbers
+// them: templates, category constructions and `in` expressions, pre-order
+int aotCollectNodes(Stmt* stmts, void*** nodes);
+
+void aotUndefined(const char* name);
+const Value* aotGlobal(int slot);
+void aotSetGlobal(int slot, const BigInt* num);
+
+void aotCheckNumbers(ValueType left, ValueType right);
+void aotCheckUnary(ValueType type);
+
+void aotDivide(BigInt* result, const BigInt* a, const BigInt* b);
+void aotModulo(BigInt* result, const BigInt* a, const BigInt* b);
+void aotPower(BigInt* result, const BigInt* a, const BigInt* b);
+void aotPowMod(BigInt* result, const BigInt* base, const BigInt* exponent, const BigInt* modulus);
+void aotPrint(const BigInt* num);
+
+void aotDefineTemplate(int node);
+void aotInitCategory(int node, int slot);
+// Looked up before the element, so its errors come first as in the interpreter
+RuntimeCategory* aotCategory(int node);
+bool aotInObject(RuntimeCategory* cat, const Value* obj);
+bool aotInMorphism(RuntimeCategory* cat, const Value* from, const Value* to);
+
+// Inline values are handled here so the C compiler sees the common case
+
+static inline void aotDefined(const BigInt* var, const char* name) {
+    if (var->bits == 0) aotUndefined(name);
+}
+
+// For variables the type checker proved assigned
+static inline const Value* aotValue(int slot) {
+    return &interp.globals.values[slot];
+}
+
+static inline const BigInt* aotNumber(int slot) {
+    return &interp.globals.values[slot].number;
+}
+
+static inline void aotFree(BigInt* num) {
+    if (num->bits != 0) bigint_free(num);
+}
+
+static inline void aotAssign(BigInt* var, const BigInt* num) {
+    BigInt value = bigint_copy(num);
+    aotFree(var);
+    *var = value;
+}
+
+static inline void aotAdd(BigInt* result, const BigInt* a, const BigInt* b) {
+    if (BIGINT_IS_SMALL(a) && BIGINT_IS_SMALL(b)) {
+        int64_t sum = BIGINT_SMALL_VALUE(a) + BIGINT_SMALL_VALUE(b);
+        if (sum >= BIGINT_SMALL_MIN && sum <= BIGINT_SMALL_MAX) {
+            bigint_free(result);
+            *result = BIGINT_SMALL(sum);
+            return;
+        }
+    }
+
+    // Accumulating reuses the limbs when nothing else shares them
+    if (result == a) {
+        bigint_add_inplace(result, b);
+    } else {
+        bigint_add(result, a, b);
+    }
+}
+
+static inline void aotSubtract(BigInt* result, const BigInt* a, const BigInt* b) {
+    if (BIGINT_IS_SMALL(a) && BIGINT_IS_SMALL(b)) {
+        int64_t difference = BIGINT_SMALL_VALUE(a) - BIGINT_SMALL_VALUE(b);
+        if (difference >= BIGINT_SMALL_MIN && difference <= BIGINT_SMALL_MAX) {
+            bigint_free(result);
+            *result = BIGINT_SMALL(difference);
+            return;
+        }
+    }
+
+    if (result == a) {
+        bigint_sub_inplace(result, b);
+    } else {
+        bigint_sub(result, a, b);
+    }
+}
+
+static inline void aotMultiply(BigInt* result, const BigInt* a, const BigInt* b) {
+#if defined(__GNUC__) && !defined(__COMPCERT__)
+    int64_t product;
+    if (BIGINT_IS_SMALL(a) && BIGINT_IS_SMALL(b) &&
+        !__builtin_mul_overflow(BIGINT_SMALL_VALUE(a), BIGINT_SMALL_VALUE(b), &product) &&
+        product >= BIGINT_SMALL_MIN && product <= BIGINT_SMALL_MAX) {
+        bigint_free(result);
+        *result = BIGINT_SMALL(product);
+        return;
+    }
+#endif
+    bigint_mul(result, a, b);
+}
+
+static inline void aotNegate(BigInt* result, const BigInt* num) {
+    BigInt value = bigint_copy(num);
+    bigint_negate(&value);
+    bigint_free(result);
+    *result = value;
+}
+
+static inline int aotCompare(const BigInt* a, const BigInt* b) {
+    if (BIGINT_IS_SMALL(a) && BIGINT_IS_SMALL(b)) {
+        int64_t x = BIGINT_SMALL_VALUE(a);
+        int64_t y = BIGINT_SMALL_VALUE(b);
+        return (x > y) - (x < y);
+    }
+    return bigint_abs_compare(a, b);
+}
+
+static inline bool aotEqual(const BigInt* a, const BigInt* b) {
+    if (BIGINT_IS_SMALL(a) && BIGINT_IS_SMALL(b)) return a->bits == b->bits;
+    return bigint_equal(a, b);
+}
+
+static inline bool aotTruthy(const BigInt* num) {
+    return num->bits != BIGINT_ZERO.bits;
+}
+
+#endif
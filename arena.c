@@ -0,0 +1,85 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+
+struct ArenaBlock {
+    ArenaBlock* next;
+    size_t size;
+    char data[];
+};
+
+#define ARENA_ALIGN sizeof(void*)
+
+static size_t align(size_t size) {
+    return (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+}
+
+void initArena(Arena* arena) {
+    arena->blocks = NULL;
+    arena->next = NULL;
+    arena->end = NULL;
+}
+
+void freeArena(Arena* arena) {
+    ArenaBlock* block = arena->blocks;
+    while (block != NULL) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    initArena(arena);
+}
+
+static void addBlock(Arena* arena, size_t blockSize) {
+    ArenaBlock* block = malloc(sizeof(ArenaBlock) + blockSize);
+    block->next = arena->blocks;
+    block->size = blockSize;
+    arena->blocks = block;
+    arena->next = block->data;
+    arena->end = block->data + blockSize;
+}
+
+// Blocks double up to a limit, so big sources take few of them
+static void newBlock(Arena* arena, size_t size) {
+    size_t blockSize = arena->blocks == NULL ? ARENA_BLOCK_SIZE : arena->blocks->size * 2;
+    if (blockSize > 64 * ARENA_BLOCK_SIZE) blockSize = 64 * ARENA_BLOCK_SIZE;
+    if (blockSize < size) blockSize = size;
+    addBlock(arena, blockSize);
+}
+
+void arenaReserve(Arena* arena, size_t size) {
+    size = align(size);
+    if ((size_t)(arena->end - arena->next) >= size) return;
+
+    if (arena->blocks == NULL) {
+        addBlock(arena, size);
+    } else {
+        newBlock(arena, size);
+    }
+}
+
+void* arenaAlloc(Arena* arena, size_t size) {
+    size = align(size);
+    if ((size_t)(arena->end - arena->next) < size) newBlock(arena, size);
+
+    void* ptr = arena->next;
+    arena->next += size;
+    return ptr;
+}
+
+void* arenaGrow(Arena* arena, void* ptr, size_t oldSize, size_t newSize) {
+    if (ptr == NULL) return arenaAlloc(arena, newSize);
+
+    char* start = ptr;
+    oldSize = align(oldSize);
+    if (start + oldSize == arena->next &&
+        (size_t)(arena->end - start) >= align(newSize)) {
+        arena->next = start + align(newSize);
+        return ptr;
+    }
+
+    void* grown = arenaAlloc(arena, newSize);
+    memcpy(grown, ptr, oldSize < newSize ? oldSize : newSize);
+    return grown;
+}
@@ -0,0 +1,27 @@
+#ifndef cryton_arena_h
+#define cryton_arena_h
+
+#include "common.h"
+
+#define ARENA_BLOCK_SIZE (16 * 1024)
+
+typedef struct ArenaBlock ArenaBlock;
+
+// Bump allocator for memory that is all freed at once. Allocations are laid
+// out in the order they are made, and nothing is freed on its own.
+typedef struct {
+    ArenaBlock* blocks;     // Newest first
+    char* next;             // Free space left in the newest block
+    char* end;
+} Arena;
+
+void initArena(Arena* arena);
+void freeArena(Arena* arena);
+void* arenaAlloc(Arena* arena, size_t size);
+// Makes room for `size` more bytes in one block. An empty arena takes a
+// block of exactly that size, so small arenas known up front stay small.
+void arenaReserve(Arena* arena, size_t size);
+// Resizes an allocation, in place when it is the newest one
+void* arenaGrow(Arena* arena, void* ptr, size_t oldSize, size_t newSize);
+
+#endif
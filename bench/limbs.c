@@ -0,0 +1,110 @@
+// Compares the scalar and SIMD limb kernels for add, subtract and compare
+// across operand sizes, after checking every variant against the scalar one.
+// Build and run with `make bench`.
+
+#include <time.h>
+
+#include "../limbs.h"
+
+#define MAX_LIMBS 4096
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static limb_t randomLimb() {
+    limb_t x = 0;
+    for (int i = 0; i < 4; ++i) x = (x << 16) ^ (limb_t)(rand() & 0xffff);
+    return x;
+}
+
+// Mostly runs of 0 and all-ones limbs, which make carries travel far
+static limb_t edgeLimb() {
+    switch (rand() % 4) {
+        case 0:  return 0;
+        case 1:  return ~(limb_t)0;
+        case 2:  return rand() % 2;
+        default: return randomLimb();
+    }
+}
+
+static bool verify(const LimbKernels* kernels, const LimbKernels* scalar) {
+    static limb_t a[64], b[64], expected[64], got[64];
+
+    for (int round = 0; round < 20000; ++round) {
+        int n = rand() % 64;
+        for (int i = 0; i < n; ++i) {
+            a[i] = edgeLimb();
+            b[i] = round % 3 == 0 ? ~a[i] : edgeLimb();
+        }
+
+        if (scalar->add(expected, a, b, n) != kernels->add(got, a, b, n) ||
+            memcmp(expected, got, sizeof(limb_t) * n) != 0) return false;
+        if (scalar->sub(expected, a, b, n) != kernels->sub(got, a, b, n) ||
+            memcmp(expected, got, sizeof(limb_t) * n) != 0) return false;
+        if (scalar->compare(a, b, n) != kernels->compare(a, b, n)) return false;
+
+        // In place, as bigint_add_inplace uses them
+        memcpy(got, a, sizeof(limb_t) * n);
+        kernels->add(got, got, b, n);
+        scalar->add(expected, a, b, n);
+        if (memcmp(expected, got, sizeof(limb_t) * n) != 0) return false;
+    }
+
+    return true;
+}
+
+int main() {
+    srand(42);
+
+    const LimbKernels* kernels[4];
+    int count = availableLimbKernels(kernels, 4);
+
+    for (int k = 1; k < count; ++k) {
+        if (!verify(kernels[k], kernels[0])) {
+            fprintf(stderr, "Kernel '%s' disagrees with the scalar one.\n", kernels[k]->name);
+            return 1;
+        }
+    }
+
+    limb_t* a = malloc(sizeof(limb_t) * MAX_LIMBS);
+    limb_t* b = malloc(sizeof(limb_t) * MAX_LIMBS);
+    limb_t* r = malloc(sizeof(limb_t) * MAX_LIMBS);
+    for (int i = 0; i < MAX_LIMBS; ++i) a[i] = randomLimb();
+
+    printf("%8s %8s %12s %12s %12s\n", "limbs", "kernel", "add (ns)", "sub (ns)", "compare (ns)");
+
+    for (int n = 4; n <= MAX_LIMBS; n *= 4) {
+        // Equal operands make compare scan every limb, like a failed lookup
+        // against a number that differs only in its last digits
+        memcpy(b, a, sizeof(limb_t) * n);
+        int reps = 20000000 / n;
+        volatile limb_t sink = 0;
+
+        for (int k = 0; k < count; ++k) {
+            const LimbKernels* kernel = kernels[k];
+
+            double start = now();
+            for (int i = 0; i < reps; ++i) sink += kernel->add(r, a, b, n);
+            double add = (now() - start) / reps;
+
+            start = now();
+            for (int i = 0; i < reps; ++i) sink += kernel->sub(r, a, b, n);
+            double sub = (now() - start) / reps;
+
+            start = now();
+            for (int i = 0; i < reps; ++i) sink += kernel->compare(a, b, n);
+            double compare = (now() - start) / reps;
+
+            printf("%8d %8s %12.1f %12.1f %12.1f\n", n, kernel->name,
+                   add * 1e9, sub * 1e9, compare * 1e9);
+        }
+    }
+
+    free(a);
+    free(b);
+    free(r);
+    return 0;
+}
@@ -0,0 +1,63 @@
+// Throughput of decimal string <-> BigInt conversion for 10^3 to 10^6 digits.
+// Build and run with `make bench`.
+
+#include <time.h>
+
+#include "../bigint.h"
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static char* randomDigits(int digits) {
+    char* str = malloc(digits + 1);
+    str[0] = '1' + rand() % 9;
+    for (int i = 1; i < digits; ++i)
+        str[i] = '0' + rand() % 10;
+    str[digits] = '\0';
+    return str;
+}
+
+int main() {
+    srand(42);
+    printf("%10s %12s %14s %12s %14s\n", "digits", "parse (s)", "parse (MB/s)", "print (s)", "print (MB/s)");
+
+    for (int digits = 1000; digits <= 1000000; digits *= 10) {
+        char* str = randomDigits(digits);
+        int reps = 1000000 / digits;
+        if (reps < 1) reps = 1;
+
+        double start = now();
+        BigInt num = bigint_from_str(str, digits);
+        for (int i = 1; i < reps; ++i) {
+            bigint_free(&num);
+            num = bigint_from_str(str, digits);
+        }
+        double parse = (now() - start) / reps;
+
+        char* out = NULL;
+        start = now();
+        for (int i = 0; i < reps; ++i) {
+            free(out);
+            out = bigint_to_str(&num);
+        }
+        double print = (now() - start) / reps;
+
+        if (strcmp(out, str) != 0) {
+            fprintf(stderr, "Round trip mismatch at %d digits.\n", digits);
+            return 1;
+        }
+
+        printf("%10d %12.6f %14.2f %12.6f %14.2f\n", digits,
+               parse, digits / parse / 1e6, print, digits / print / 1e6);
+
+        free(out);
+        free(str);
+        bigint_free(&num);
+    }
+
+    bigint_release_caches();
+    return 0;
+}
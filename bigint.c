@@ -1,184 +1,1634 @@
 #include "bigint.h"
+#include "limbs.h"
 
-// Reverse a string (helper function)
-void reverse(char* str, int len) {
-    for (int i = 0; i < len / 2; ++i) {
-        char temp = str[i];
-        str[i] = str[len - i - 1];
-        str[len - i - 1] = temp;
+#define DEC_LIMB_BASE   10000000000000000000ULL  // 10^19, the largest power of ten in a limb
+#define DEC_LIMB_DIGITS 19
+
+// Double-width limb helpers
+#ifdef __SIZEOF_INT128__
+typedef unsigned __int128 dlimb_t;
+
+static inline limb_t mulWide(limb_t a, limb_t b, limb_t* hi) {
+    dlimb_t product = (dlimb_t)a * b;
+    *hi = (limb_t)(product >> 64);
+    return (limb_t)product;
+}
+
+// Divides hi:lo by d, requires hi < d
+static inline limb_t divWide(limb_t hi, limb_t lo, limb_t d, limb_t* rem) {
+    dlimb_t n = ((dlimb_t)hi << 64) | lo;
+    *rem = (limb_t)(n % d);
+    return (limb_t)(n / d);
+}
+#else
+static limb_t mulWide(limb_t a, limb_t b, limb_t* hi) {
+    limb_t aLo = a & 0xffffffffu, aHi = a >> 32;
+    limb_t bLo = b & 0xffffffffu, bHi = b >> 32;
+    limb_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+    limb_t mid = (ll >> 32) + (lh & 0xffffffffu) + (hl & 0xffffffffu);
+    *hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    return (mid << 32) | (ll & 0xffffffffu);
+}
+
+// Divides hi:lo by d, requires hi < d
+static limb_t divWide(limb_t hi, limb_t lo, limb_t d, limb_t* rem) {
+    limb_t q = 0;
+    for (int i = 0; i < 64; ++i) {
+        limb_t top = hi >> 63;
+        hi = (hi << 1) | (lo >> 63);
+        lo <<= 1;
+        q <<= 1;
+        if (top || hi >= d) {
+            hi -= d;
+            q |= 1;
+        }
     }
+    *rem = hi;
+    return q;
 }
+#endif
 
-// Initialize BigInt from an integer
-void bigint_init(BigInt* num, int value) {
-    num->sign = (value < 0) ? -1 : 1;  
-    if (value < 0) value = -value;  // Work with absolute value
+// Read-only view of a number's magnitude, inline values get a one limb array
+typedef struct {
+    const limb_t* limbs;
+    int length;
+    int sign;
+    limb_t inlineLimb;
+} Magnitude;
 
-    snprintf(num->digits, BIGINT_MAX_DIGITS, "%d", value);
-    num->length = strlen(num->digits);
+static inline BigInt makeSmall(int64_t value) {
+    BigInt num;
+    num.bits = ((uint64_t)value << 2) | 1;
+    return num;
+}
 
-    // Reverse digits for easier arithmetic
-    reverse(num->digits, num->length);
+static inline BigInt makeHeap(BigNum* num) {
+    BigInt result;
+    result.bits = (uint64_t)(uintptr_t)num;
+    return result;
 }
 
-BigInt bigint_from_int(int value) {
-    BigInt num;
+static void viewOf(const BigInt* num, Magnitude* mag) {
+    if (BIGINT_IS_SMALL(num)) {
+        int64_t value = BIGINT_SMALL_VALUE(num);
+        mag->sign = value < 0 ? -1 : 1;
+        mag->inlineLimb = value < 0 ? (limb_t)-value : (limb_t)value;
+        mag->limbs = &mag->inlineLimb;
+        mag->length = value != 0;
+    } else {
+        BigNum* heap = BIGINT_AS_NUM(num);
+        mag->sign = heap->sign;
+        mag->limbs = heap->limbs;
+        mag->length = heap->length;
+    }
+}
 
-    num.sign = (value < 0) ? -1 : 1;
-    if (value < 0) value = -value;
+static BigNum* allocNum(int capacity) {
+    if (capacity < 1) capacity = 1;
 
-    snprintf(num.digits, BIGINT_MAX_DIGITS, "%d", value);
-    num.length = strlen(num.digits);
+    BigNum* num = malloc(sizeof(BigNum) + sizeof(limb_t) * capacity);
+    num->refCount = 1;
+    num->sign = 1;
+    num->length = 0;
+    num->capacity = capacity;
+    num->hash = 0;
+    num->id = 0;
+    return num;
+}
 
-    // Reverse digits for easier arithmetic
-    reverse(num.digits, num.length);
+static BigNum* growNum(BigNum* num, int capacity) {
+    if (capacity <= num->capacity) return num;
+    if (capacity < num->capacity * 2) capacity = num->capacity * 2;
 
+    num = realloc(num, sizeof(BigNum) + sizeof(limb_t) * capacity);
+    num->capacity = capacity;
     return num;
 }
 
+// Trims leading zero limbs and demotes values that fit back to the inline form
+static BigInt finishNum(BigNum* num) {
+    while (num->length > 0 && num->limbs[num->length - 1] == 0)
+        num->length--;
+
+    if (num->length == 0) {
+        free(num);
+        return makeSmall(0);
+    }
+
+    if (num->length == 1) {
+        limb_t mag = num->limbs[0];
+        limb_t limit = num->sign > 0 ? (limb_t)BIGINT_SMALL_MAX : (limb_t)1 << (BIGINT_SMALL_BITS - 1);
+
+        if (mag <= limit) {
+            int64_t value = num->sign > 0 ? (int64_t)mag : -(int64_t)mag;
+            free(num);
+            return makeSmall(value);
+        }
+    }
+
+    return makeHeap(num);
+}
+
+// r = a + b where an >= bn, r may alias a or b, returns the carry
+static limb_t limbsAdd(limb_t* r, const limb_t* a, int an, const limb_t* b, int bn) {
+    limb_t carry = limbKernels->add(r, a, b, bn);
+    int i = bn;
+
+    for (; i < an; ++i) {
+        limb_t sum = a[i] + carry;
+        carry = sum < carry;
+        r[i] = sum;
+    }
+
+    return carry;
+}
+
+// r = a - b where |a| >= |b|, r may alias a or b, returns the borrow
+static limb_t limbsSub(limb_t* r, const limb_t* a, int an, const limb_t* b, int bn) {
+    limb_t borrow = limbKernels->sub(r, a, b, bn);
+    int i = bn;
+
+    for (; i < an; ++i) {
+        limb_t ai = a[i];
+        r[i] = ai - borrow;
+        borrow = ai < borrow;
+    }
+
+    return borrow;
+}
+
+static int limbsCompare(const limb_t* a, int an, const limb_t* b, int bn) {
+    if (an != bn) return an > bn ? 1 : -1;
+    return limbKernels->compare(a, b, an);
+}
+
+// num = num * mul + add
+static BigNum* mulAddSmall(BigNum* num, limb_t mul, limb_t add) {
+    limb_t carry = add;
+
+    for (int i = 0; i < num->length; ++i) {
+        limb_t hi;
+        limb_t lo = mulWide(num->limbs[i], mul, &hi);
+        lo += carry;
+        hi += lo < carry;
+        num->limbs[i] = lo;
+        carry = hi;
+    }
+
+    if (carry != 0) {
+        num = growNum(num, num->length + 1);
+        num->limbs[num->length++] = carry;
+    }
+    return num;
+}
+
+// Computes a + sign * |b| into a fresh number
+static BigInt addSigned(const Magnitude* a, const Magnitude* b, int bSign) {
+    BigNum* num;
+
+    if (a->sign == bSign) {
+        const Magnitude* longer = a->length >= b->length ? a : b;
+        const Magnitude* shorter = a->length >= b->length ? b : a;
+
+        num = allocNum(longer->length + 1);
+        num->sign = bSign;
+        num->limbs[longer->length] = limbsAdd(num->limbs, longer->limbs, longer->length,
+                                              shorter->limbs, shorter->length);
+        num->length = longer->length + 1;
+    } else {
+        int cmp = limbsCompare(a->limbs, a->length, b->limbs, b->length);
+        if (cmp == 0) return makeSmall(0);
+
+        const Magnitude* larger = cmp > 0 ? a : b;
+        const Magnitude* smaller = cmp > 0 ? b : a;
+
+        num = allocNum(larger->length);
+        num->sign = cmp > 0 ? a->sign : bSign;
+        limbsSub(num->limbs, larger->limbs, larger->length, smaller->limbs, smaller->length);
+        num->length = larger->length;
+    }
+
+    return finishNum(num);
+}
+
+// acc = acc + bSign * |b|, reusing acc's storage when it can
+static void addInPlace(BigInt* acc, const BigInt* b, int negate) {
+    if (BIGINT_IS_SMALL(acc) && BIGINT_IS_SMALL(b)) {
+        int64_t bv = BIGINT_SMALL_VALUE(b);
+        *acc = bigint_from_i64(BIGINT_SMALL_VALUE(acc) + (negate ? -bv : bv));
+        return;
+    }
+
+    Magnitude mb;
+    viewOf(b, &mb);
+    int bSign = negate ? -mb.sign : mb.sign;
+
+    // Growing acc could move the limbs b is reading from
+    if (!BIGINT_IS_SMALL(acc) && acc->bits != b->bits &&
+        BIGINT_AS_NUM(acc)->refCount == 1) {
+        BigNum* num = BIGINT_AS_NUM(acc);
+
+        if (num->sign == bSign) {
+            int length = num->length > mb.length ? num->length : mb.length;
+            num = growNum(num, length + 1);
+            for (int i = num->length; i < length; ++i) num->limbs[i] = 0;
+
+            num->limbs[length] = limbsAdd(num->limbs, num->limbs, length, mb.limbs, mb.length);
+            num->length = length + 1;
+            *acc = finishNum(num);
+            return;
+        }
+
+        if (limbsCompare(num->limbs, num->length, mb.limbs, mb.length) >= 0) {
+            limbsSub(num->limbs, num->limbs, num->length, mb.limbs, mb.length);
+            *acc = finishNum(num);
+            return;
+        }
+
+        if (num->capacity >= mb.length) {
+            limbsSub(num->limbs, mb.limbs, mb.length, num->limbs, num->length);
+            num->length = mb.length;
+            num->sign = bSign;
+            *acc = finishNum(num);
+            return;
+        }
+    }
+
+    Magnitude ma;
+    viewOf(acc, &ma);
+    BigInt result = addSigned(&ma, &mb, bSign);
+    bigint_free(acc);
+    *acc = result;
+}
+
+// Multiplication
+
+#define KARATSUBA_THRESHOLD 32   // limbs, below this schoolbook wins
+#define TOOM3_THRESHOLD     160
+#define RECURSIVE_DIV_THRESHOLD 64
+
+static BigInt fromLimbs(const limb_t* limbs, int length, int sign) {
+    while (length > 0 && limbs[length - 1] == 0) length--;
+    if (length == 0) return makeSmall(0);
+
+    BigNum* num = allocNum(length);
+    num->sign = sign;
+    num->length = length;
+    memcpy(num->limbs, limbs, sizeof(limb_t) * length);
+    return finishNum(num);
+}
+
+// r[0, an + bn) = a * b, r must not alias a or b
+static void mulBasecase(limb_t* r, const limb_t* a, int an, const limb_t* b, int bn) {
+    memset(r, 0, sizeof(limb_t) * (an + bn));
+
+    for (int j = 0; j < bn; ++j) {
+        limb_t carry = 0;
+        limb_t bj = b[j];
+        if (bj == 0) continue;
+
+        for (int i = 0; i < an; ++i) {
+            limb_t hi;
+            limb_t lo = mulWide(a[i], bj, &hi);
+            lo += carry;
+            hi += lo < carry;
+            lo += r[i + j];
+            hi += lo < r[i + j];
+            r[i + j] = lo;
+            carry = hi;
+        }
+        r[j + an] = carry;
+    }
+}
+
+// r += a at offset, propagating the carry up to rn limbs
+static void addAt(limb_t* r, int rn, const limb_t* a, int an) {
+    limb_t carry = limbsAdd(r, r, an, a, an);
+    for (int i = an; carry != 0 && i < rn; ++i) {
+        r[i] += carry;
+        carry = r[i] == 0;
+    }
+}
+
+// |x - y| for zero extended operands of n limbs, returns the sign of x - y
+static int limbsAbsDiff(limb_t* r, const limb_t* x, int xn, const limb_t* y, int yn, int n) {
+    int xl = xn, yl = yn;
+    while (xl > 0 && x[xl - 1] == 0) xl--;
+    while (yl > 0 && y[yl - 1] == 0) yl--;
+
+    int cmp = limbsCompare(x, xl, y, yl);
+    const limb_t* big = cmp >= 0 ? x : y;
+    const limb_t* small = cmp >= 0 ? y : x;
+    int bigLen = cmp >= 0 ? xl : yl, smallLen = cmp >= 0 ? yl : xl;
+
+    limbsSub(r, big, bigLen, small, smallLen);
+    for (int i = bigLen; i < n; ++i) r[i] = 0;
+    return cmp >= 0 ? 1 : -1;
+}
+
+static void mulLimbs(limb_t* r, const limb_t* a, int an, const limb_t* b, int bn);
+
+// Splits both operands at m limbs and recurses on three half-size products
+static void mulKaratsuba(limb_t* r, const limb_t* a, int an, const limb_t* b, int bn, int m) {
+    int ah = an - m, bh = bn - m;
+
+    mulLimbs(r, a, m, b, m);
+    mulLimbs(r + 2 * m, a + m, ah, b + m, bh);
+
+    limb_t* da = malloc(sizeof(limb_t) * (6 * m + 1));
+    limb_t* db = da + m;
+    limb_t* t = db + m;
+    limb_t* mid = t + 2 * m;
+
+    int sign = limbsAbsDiff(da, a, m, a + m, ah, m) *
+               limbsAbsDiff(db, b, m, b + m, bh, m);
+    mulLimbs(t, da, m, db, m);
+
+    // mid = z0 + z2 - sign * |a0 - a1| * |b0 - b1| = a0 * b1 + a1 * b0
+    memcpy(mid, r, sizeof(limb_t) * 2 * m);
+    mid[2 * m] = 0;
+    addAt(mid, 2 * m + 1, r + 2 * m, ah + bh);
+    if (sign > 0) {
+        limbsSub(mid, mid, 2 * m + 1, t, 2 * m);
+    } else {
+        addAt(mid, 2 * m + 1, t, 2 * m);
+    }
+
+    int midLen = 2 * m + 1;
+    while (midLen > 0 && mid[midLen - 1] == 0) midLen--;
+    addAt(r + m, an + bn - m, mid, midLen);
+    free(da);
+}
+
+static void divExactSmall(BigInt* num, limb_t divisor) {
+    Magnitude mag;
+    viewOf(num, &mag);
+
+    BigNum* quot = allocNum(mag.length);
+    quot->sign = mag.sign;
+    quot->length = mag.length;
+
+    limb_t rem = 0;
+    for (int i = mag.length - 1; i >= 0; --i)
+        quot->limbs[i] = divWide(rem, mag.limbs[i], divisor, &rem);
+
+    bigint_free(num);
+    *num = finishNum(quot);
+}
+
+// p(0), p(1), p(-1), p(-2) and p(inf) for p(x) = c2 x^2 + c1 x + c0
+static void toomEvaluate(BigInt points[5], const limb_t* c, int n, int k) {
+    int len0 = n < k ? n : k;
+    int len1 = n < 2 * k ? n - len0 : k;
+    int len2 = n - len0 - len1;
+
+    BigInt c0 = fromLimbs(c, len0, 1);
+    BigInt c1 = fromLimbs(c + k, len1, 1);
+    BigInt c2 = fromLimbs(c + 2 * k, len2, 1);
+
+    BigInt even = bigint_from_int(0);
+    bigint_add(&even, &c0, &c2);
+
+    points[0] = c0;
+    points[1] = bigint_from_int(0);
+    bigint_add(&points[1], &even, &c1);
+    points[2] = even;
+    bigint_sub_inplace(&points[2], &c1);
+
+    // p(-2) = 2 (p(-1) + c2) - c0
+    points[3] = bigint_from_int(0);
+    bigint_add(&points[3], &points[2], &c2);
+    bigint_add_inplace(&points[3], &points[3]);
+    bigint_sub_inplace(&points[3], &c0);
+
+    points[4] = c2;
+    bigint_free(&c1);
+}
+
+// Toom-Cook 3-way: five third-size products and Bodrato's interpolation
+static void mulToom3(limb_t* r, const limb_t* a, int an, const limb_t* b, int bn) {
+    int k = (an + 2) / 3;
+    BigInt pa[5], pb[5], w[5];
+
+    toomEvaluate(pa, a, an, k);
+    toomEvaluate(pb, b, bn, k);
+
+    for (int i = 0; i < 5; ++i) {
+        w[i] = bigint_from_int(0);
+        bigint_mul(&w[i], &pa[i], &pb[i]);
+        bigint_free(&pa[i]);
+        bigint_free(&pb[i]);
+    }
+
+    // w = r(0), r(1), r(-1), r(-2), r(inf) -> coefficients r0..r4
+    BigInt r0 = w[0], r4 = w[4];
+    BigInt r3 = bigint_from_int(0), r1 = bigint_from_int(0), r2 = bigint_from_int(0);
+
+    bigint_sub(&r3, &w[3], &w[1]);
+    divExactSmall(&r3, 3);
+    bigint_sub(&r1, &w[1], &w[2]);
+    divExactSmall(&r1, 2);
+    bigint_sub(&r2, &w[2], &w[0]);
+
+    bigint_sub(&r3, &r2, &r3);
+    divExactSmall(&r3, 2);
+    bigint_add_inplace(&r3, &r4);
+    bigint_add_inplace(&r3, &r4);
+
+    bigint_add_inplace(&r2, &r1);
+    bigint_sub_inplace(&r2, &r4);
+    bigint_sub_inplace(&r1, &r3);
+
+    bigint_free(&w[1]);
+    bigint_free(&w[2]);
+    bigint_free(&w[3]);
+
+    // Every coefficient of a product of non-negative pieces is non-negative
+    BigInt coeffs[5] = { r0, r1, r2, r3, r4 };
+    memset(r, 0, sizeof(limb_t) * (an + bn));
+
+    for (int i = 0; i < 5; ++i) {
+        Magnitude mag;
+        viewOf(&coeffs[i], &mag);
+        if (mag.length > 0)
+            addAt(r + i * k, an + bn - i * k, mag.limbs, mag.length);
+        bigint_free(&coeffs[i]);
+    }
+}
+
+// r[0, an + bn) = a * b, r must not alias a or b
+static void mulLimbs(limb_t* r, const limb_t* a, int an, const limb_t* b, int bn) {
+    if (an < bn) {
+        const limb_t* tmp = a; a = b; b = tmp;
+        int tmpLen = an; an = bn; bn = tmpLen;
+    }
+
+    if (bn < KARATSUBA_THRESHOLD) {
+        mulBasecase(r, a, an, b, bn);
+        return;
+    }
+
+    int m = (an + 1) / 2;
+    if (bn > m) {
+        if (bn >= TOOM3_THRESHOLD && 3 * bn > 2 * an)
+            mulToom3(r, a, an, b, bn);
+        else
+            mulKaratsuba(r, a, an, b, bn, m);
+        return;
+    }
+
+    // Unbalanced: multiply b by bn-sized slices of a
+    limb_t* tmp = malloc(sizeof(limb_t) * 2 * bn);
+    memset(r, 0, sizeof(limb_t) * (an + bn));
+
+    for (int i = 0; i < an; i += bn) {
+        int len = an - i < bn ? an - i : bn;
+        mulLimbs(tmp, a + i, len, b, bn);
+        addAt(r + i, an + bn - i, tmp, len + bn);
+    }
+    free(tmp);
+}
+
+// Division
+
+static inline int leadingZeros(limb_t x) {
+    int n = 0;
+    while (!(x & ((limb_t)1 << 63))) {
+        x <<= 1;
+        n++;
+    }
+    return n;
+}
+
+// r = a << shift for 0 <= shift < 64, returns the bits shifted out
+static limb_t shiftLeftBits(limb_t* r, const limb_t* a, int n, int shift) {
+    if (shift == 0) {
+        memmove(r, a, sizeof(limb_t) * n);
+        return 0;
+    }
+
+    limb_t out = a[n - 1] >> (64 - shift);
+    for (int i = n - 1; i > 0; --i)
+        r[i] = (a[i] << shift) | (a[i - 1] >> (64 - shift));
+    r[0] = a[0] << shift;
+    return out;
+}
+
+static void shiftRightBits(limb_t* r, const limb_t* a, int n, int shift) {
+    if (shift == 0) {
+        memmove(r, a, sizeof(limb_t) * n);
+        return;
+    }
+
+    for (int i = 0; i < n - 1; ++i)
+        r[i] = (a[i] >> shift) | (a[i + 1] << (64 - shift));
+    r[n - 1] = a[n - 1] >> shift;
+}
+
+// Knuth's algorithm D. u has un limbs and its top limb is below v's, v has
+// vn >= 2 limbs with the top bit set. Stores un - vn quotient limbs in q and
+// leaves the remainder in the low vn limbs of u.
+static void divKnuth(limb_t* q, limb_t* u, int un, const limb_t* v, int vn) {
+    limb_t vTop = v[vn - 1], vNext = v[vn - 2];
+
+    for (int j = un - vn - 1; j >= 0; --j) {
+        limb_t qhat, rhat;
+        bool rhatOverflow = false;
+
+        if (u[j + vn] >= vTop) {
+            qhat = ~(limb_t)0;
+            rhat = u[j + vn - 1] + vTop;
+            rhatOverflow = rhat < vTop;
+        } else {
+            qhat = divWide(u[j + vn], u[j + vn - 1], vTop, &rhat);
+        }
+
+        while (!rhatOverflow) {
+            limb_t hi;
+            limb_t lo = mulWide(qhat, vNext, &hi);
+            if (hi < rhat || (hi == rhat && lo <= u[j + vn - 2])) break;
+
+            qhat--;
+            rhat += vTop;
+            rhatOverflow = rhat < vTop;
+        }
+
+        // u[j, j + vn] -= qhat * v
+        limb_t carry = 0;
+        for (int i = 0; i < vn; ++i) {
+            limb_t hi;
+            limb_t lo = mulWide(qhat, v[i], &hi);
+            lo += carry;
+            hi += lo < carry;
+            hi += u[j + i] < lo;
+            u[j + i] -= lo;
+            carry = hi;
+        }
+
+        bool negative = u[j + vn] < carry;
+        u[j + vn] -= carry;
+
+        if (negative) {
+            qhat--;
+            u[j + vn] += limbsAdd(u + j, u + j, vn, v, vn);
+        }
+        q[j] = qhat;
+    }
+}
+
+static bool isNegative(const BigInt* num) {
+    if (BIGINT_IS_SMALL(num)) return BIGINT_SMALL_VALUE(num) < 0;
+    return BIGINT_AS_NUM(num)->sign < 0;
+}
+
+static int limbLength(const BigInt* num) {
+    if (BIGINT_IS_SMALL(num)) return BIGINT_SMALL_VALUE(num) != 0;
+    return BIGINT_AS_NUM(num)->length;
+}
+
+// num div β^k for non-negative num
+static BigInt highLimbs(const BigInt* num, int k) {
+    Magnitude mag;
+    viewOf(num, &mag);
+    if (mag.length <= k) return makeSmall(0);
+    return fromLimbs(mag.limbs + k, mag.length - k, 1);
+}
+
+// num mod β^k for non-negative num
+static BigInt lowLimbs(const BigInt* num, int k) {
+    Magnitude mag;
+    viewOf(num, &mag);
+    return fromLimbs(mag.limbs, mag.length < k ? mag.length : k, 1);
+}
+
+// num * β^k
+static BigInt shiftLimbsUp(const BigInt* num, int k) {
+    Magnitude mag;
+    viewOf(num, &mag);
+    if (mag.length == 0) return makeSmall(0);
+
+    BigNum* shifted = allocNum(mag.length + k);
+    shifted->sign = mag.sign;
+    shifted->length = mag.length + k;
+    memset(shifted->limbs, 0, sizeof(limb_t) * k);
+    memcpy(shifted->limbs + k, mag.limbs, sizeof(limb_t) * mag.length);
+    return finishNum(shifted);
+}
+
+// Schoolbook division of non-negative a by b, b normalized with two or more limbs
+static void divBasecase(BigInt* q, BigInt* r, const BigInt* a, const BigInt* b) {
+    Magnitude ma, mb;
+    viewOf(a, &ma);
+    viewOf(b, &mb);
+
+    if (limbsCompare(ma.limbs, ma.length, mb.limbs, mb.length) < 0) {
+        *q = makeSmall(0);
+        *r = bigint_copy(a);
+        return;
+    }
+
+    int un = ma.length + 1;
+    limb_t* u = malloc(sizeof(limb_t) * un);
+    memcpy(u, ma.limbs, sizeof(limb_t) * ma.length);
+    u[ma.length] = 0;
+
+    BigNum* quot = allocNum(un - mb.length);
+    quot->length = un - mb.length;
+    divKnuth(quot->limbs, u, un, mb.limbs, mb.length);
+
+    *q = finishNum(quot);
+    *r = fromLimbs(u, mb.length, 1);
+    free(u);
+}
+
+// Recursive division (Burnikel-Ziegler, as in Brent & Zimmermann's
+// RecursiveDivRem). a is non-negative with at most 2n limbs and b is
+// normalized with n limbs.
+static void divRecursive(BigInt* q, BigInt* r, const BigInt* a, const BigInt* b) {
+    int n = limbLength(b);
+    int m = limbLength(a) - n;
+
+    if (m < RECURSIVE_DIV_THRESHOLD || n < RECURSIVE_DIV_THRESHOLD) {
+        divBasecase(q, r, a, b);
+        return;
+    }
+
+    int k = m / 2;
+    BigInt b1 = highLimbs(b, k);
+    BigInt b0 = lowLimbs(b, k);
+    BigInt scaledB = shiftLimbsUp(b, k);
+    BigInt tmp = makeSmall(0);
+
+    // High half of the quotient from the top limbs of a
+    BigInt q1, r1, q0, r0;
+    BigInt aHigh = highLimbs(a, 2 * k);
+    divRecursive(&q1, &r1, &aHigh, &b1);
+    bigint_free(&aHigh);
+
+    BigInt rest = shiftLimbsUp(&r1, 2 * k);
+    BigInt aLow = lowLimbs(a, 2 * k);
+    bigint_add_inplace(&rest, &aLow);
+    bigint_mul(&tmp, &q1, &b0);
+    BigInt shiftedTmp = shiftLimbsUp(&tmp, k);
+    bigint_sub_inplace(&rest, &shiftedTmp);
+    bigint_free(&shiftedTmp);
+    bigint_free(&aLow);
+    bigint_free(&r1);
+
+    BigInt one = makeSmall(1);
+    while (isNegative(&rest)) {
+        bigint_sub_inplace(&q1, &one);
+        bigint_add_inplace(&rest, &scaledB);
+    }
+
+    // Low half of the quotient from what is left
+    BigInt restHigh = highLimbs(&rest, k);
+    divRecursive(&q0, &r0, &restHigh, &b1);
+    bigint_free(&restHigh);
+
+    BigInt rem = shiftLimbsUp(&r0, k);
+    BigInt restLow = lowLimbs(&rest, k);
+    bigint_add_inplace(&rem, &restLow);
+    bigint_mul(&tmp, &q0, &b0);
+    bigint_sub_inplace(&rem, &tmp);
+    bigint_free(&restLow);
+    bigint_free(&r0);
+    bigint_free(&rest);
+
+    while (isNegative(&rem)) {
+        bigint_sub_inplace(&q0, &one);
+        bigint_add_inplace(&rem, b);
+    }
+
+    *q = shiftLimbsUp(&q1, k);
+    bigint_add_inplace(q, &q0);
+    *r = rem;
+
+    bigint_free(&q1);
+    bigint_free(&q0);
+    bigint_free(&tmp);
+    bigint_free(&b1);
+    bigint_free(&b0);
+    bigint_free(&scaledB);
+}
+
+// Divides non-negative a by normalized b a block of n limbs at a time
+static void divUnbalanced(BigInt* q, BigInt* r, const BigInt* a, const BigInt* b) {
+    int n = limbLength(b);
+    int m = limbLength(a) - n;
+
+    BigInt quot = makeSmall(0);
+    BigInt rem = bigint_copy(a);
+
+    while (m > n) {
+        BigInt top = highLimbs(&rem, m - n);
+        BigInt low = lowLimbs(&rem, m - n);
+        BigInt qBlock, rBlock;
+        divRecursive(&qBlock, &rBlock, &top, b);
+
+        BigInt shiftedQuot = shiftLimbsUp(&quot, n);
+        bigint_add_inplace(&shiftedQuot, &qBlock);
+        bigint_free(&quot);
+        quot = shiftedQuot;
+
+        bigint_free(&rem);
+        rem = shiftLimbsUp(&rBlock, m - n);
+        bigint_add_inplace(&rem, &low);
+
+        bigint_free(&top);
+        bigint_free(&low);
+        bigint_free(&qBlock);
+        bigint_free(&rBlock);
+        m -= n;
+    }
+
+    BigInt qLast;
+    divRecursive(&qLast, r, &rem, b);
+    *q = shiftLimbsUp(&quot, m);
+    bigint_add_inplace(q, &qLast);
+
+    bigint_free(&qLast);
+    bigint_free(&quot);
+    bigint_free(&rem);
+}
+
+// Truncated division of magnitudes, b must be non-zero
+static void divmodMagnitude(BigInt* q, BigInt* r, const Magnitude* a, const Magnitude* b) {
+    if (limbsCompare(a->limbs, a->length, b->limbs, b->length) < 0) {
+        *q = makeSmall(0);
+        *r = fromLimbs(a->limbs, a->length, 1);
+        return;
+    }
+
+    if (b->length == 1) {
+        BigNum* quot = allocNum(a->length);
+        quot->length = a->length;
+
+        limb_t rem = 0;
+        for (int i = a->length - 1; i >= 0; --i)
+            quot->limbs[i] = divWide(rem, a->limbs[i], b->limbs[0], &rem);
+
+        *q = finishNum(quot);
+        *r = fromLimbs(&rem, 1, 1);
+        return;
+    }
+
+    // Normalize so the divisor's top bit is set
+    int shift = leadingZeros(b->limbs[b->length - 1]);
+    int vn = b->length, un = a->length + 1;
+    limb_t* v = malloc(sizeof(limb_t) * (vn + un));
+    limb_t* u = v + vn;
+
+    shiftLeftBits(v, b->limbs, vn, shift);
+    u[un - 1] = shiftLeftBits(u, a->limbs, a->length, shift);
+
+    if (vn < RECURSIVE_DIV_THRESHOLD || un - vn < RECURSIVE_DIV_THRESHOLD) {
+        BigNum* quot = allocNum(un - vn);
+        quot->length = un - vn;
+        divKnuth(quot->limbs, u, un, v, vn);
+        *q = finishNum(quot);
+    } else {
+        BigInt na = fromLimbs(u, un, 1);
+        BigInt nb = fromLimbs(v, vn, 1);
+        BigInt nr;
+        divUnbalanced(q, &nr, &na, &nb);
+
+        Magnitude mr;
+        viewOf(&nr, &mr);
+        memset(u, 0, sizeof(limb_t) * vn);
+        memcpy(u, mr.limbs, sizeof(limb_t) * mr.length);
+
+        bigint_free(&na);
+        bigint_free(&nb);
+        bigint_free(&nr);
+    }
+
+    shiftRightBits(u, u, vn, shift);
+    *r = fromLimbs(u, vn, 1);
+    free(v);
+}
+
+// Powers
+
+#define MONTGOMERY_MAX_LIMBS 64   // larger odd moduli use Barrett with fast multiplication
+
+static inline int bitAt(const Magnitude* mag, int i) {
+    return (mag->limbs[i / 64] >> (i % 64)) & 1;
+}
+
+static int bitLength(const Magnitude* mag) {
+    if (mag->length == 0) return 0;
+    return mag->length * 64 - leadingZeros(mag->limbs[mag->length - 1]);
+}
+
+// Window size for an exponent of `bits` bits, trading the odd powers
+// precomputed against the multiplications saved
+static int windowSize(int bits) {
+    if (bits > 671) return 6;
+    if (bits > 239) return 5;
+    if (bits > 79)  return 4;
+    if (bits > 23)  return 3;
+    if (bits > 6)   return 2;
+    return 1;
+}
+
+// Sliding window: consumes the exponent bits from *bit downward. A zero bit
+// is a window of its own with value 0, otherwise the window is the longest
+// run of at most k bits that ends in a one, so its value is odd. Returns the
+// window's width.
+static int nextWindow(const Magnitude* exponent, int* bit, int k, int* value) {
+    int top = *bit;
+    if (!bitAt(exponent, top)) {
+        *bit = top - 1;
+        *value = 0;
+        return 1;
+    }
+
+    int low = top - k + 1;
+    if (low < 0) low = 0;
+    while (!bitAt(exponent, low)) low++;
+
+    int v = 0;
+    for (int i = top; i >= low; --i)
+        v = (v << 1) | bitAt(exponent, i);
+
+    *bit = low - 1;
+    *value = v;
+    return top - low + 1;
+}
+
+// Montgomery arithmetic on fixed n-limb residues modulo an odd m
+
+typedef struct {
+    const limb_t* m;
+    int n;
+    limb_t mInv;     // -m^-1 mod 2^64
+    limb_t* t;       // n + 2 limbs of scratch
+} Montgomery;
+
+static limb_t negInverse(limb_t m0) {
+    // Newton's iteration doubles the correct low bits each step
+    limb_t inv = m0;
+    for (int i = 0; i < 6; ++i) inv *= 2 - m0 * inv;
+    return -inv;
+}
+
+// r = a * b / 2^(64n) mod m, coarsely integrated (CIOS). r may alias a or b.
+static void montMul(const Montgomery* mont, limb_t* r, const limb_t* a, const limb_t* b) {
+    const limb_t* m = mont->m;
+    int n = mont->n;
+    limb_t* t = mont->t;
+    memset(t, 0, sizeof(limb_t) * (n + 2));
+
+    for (int i = 0; i < n; ++i) {
+        limb_t carry = 0, hi;
+        for (int j = 0; j < n; ++j) {
+            limb_t lo = mulWide(a[i], b[j], &hi);
+            lo += carry;
+            hi += lo < carry;
+            t[j] += lo;
+            hi += t[j] < lo;
+            carry = hi;
+        }
+        t[n] += carry;
+        t[n + 1] = t[n] < carry;
+
+        // Add u * m so the low limb cancels, then shift down a limb
+        limb_t u = t[0] * mont->mInv;
+        limb_t lo = mulWide(u, m[0], &hi);
+        lo += t[0];
+        carry = hi + (lo < t[0]);
+        for (int j = 1; j < n; ++j) {
+            lo = mulWide(u, m[j], &hi);
+            lo += carry;
+            hi += lo < carry;
+            t[j - 1] = t[j] + lo;
+            hi += t[j - 1] < lo;
+            carry = hi;
+        }
+        t[n - 1] = t[n] + carry;
+        t[n] = t[n + 1] + (t[n - 1] < carry);
+    }
+
+    if (t[n] != 0 || limbsCompare(t, n, m, n) >= 0)
+        limbsSub(t, t, n, m, n);
+    memcpy(r, t, sizeof(limb_t) * n);
+}
+
+// Zero extends a non-negative number below 2^(64n) to n limbs
+static void toFixed(limb_t* out, const BigInt* num, int n) {
+    Magnitude mag;
+    viewOf(num, &mag);
+    memcpy(out, mag.limbs, sizeof(limb_t) * mag.length);
+    memset(out + mag.length, 0, sizeof(limb_t) * (n - mag.length));
+}
+
+// base^exponent mod m for 0 <= base < m and odd m of at most
+// MONTGOMERY_MAX_LIMBS limbs
+static BigInt powModMontgomery(const BigInt* base, const Magnitude* exponent, const BigInt* m) {
+    Magnitude mm;
+    viewOf(m, &mm);
+    int n = mm.length;
+
+    int bits = bitLength(exponent);
+    int k = windowSize(bits);
+    int tableSize = 1 << (k - 1);
+
+    limb_t* storage = malloc(sizeof(limb_t) * (n * (tableSize + 3) + 2));
+    limb_t* table = storage;                  // base^1, base^3, ... in Montgomery form
+    limb_t* acc = table + n * tableSize;
+    limb_t* square = acc + n;
+    Montgomery mont = { mm.limbs, n, negInverse(mm.limbs[0]), square + n };
+
+    // Into Montgomery form: x * 2^(64n) mod m
+    BigInt one = makeSmall(1);
+    BigInt x = shiftLimbsUp(base, n);
+    bigint_divmod(NULL, &x, &x, m);
+    toFixed(table, &x, n);
+    bigint_free(&x);
+
+    x = shiftLimbsUp(&one, n);
+    bigint_divmod(NULL, &x, &x, m);
+    toFixed(acc, &x, n);
+    bigint_free(&x);
+
+    montMul(&mont, square, table, table);
+    for (int i = 1; i < tableSize; ++i)
+        montMul(&mont, table + i * n, table + (i - 1) * n, square);
+
+    bool started = false;
+    for (int bit = bits - 1; bit >= 0;) {
+        int value;
+        int width = nextWindow(exponent, &bit, k, &value);
+
+        if (!started) {
+            if (value == 0) continue;
+            memcpy(acc, table + (value >> 1) * n, sizeof(limb_t) * n);
+            started = true;
+            continue;
+        }
+
+        for (int i = 0; i < width; ++i) montMul(&mont, acc, acc, acc);
+        if (value != 0) montMul(&mont, acc, acc, table + (value >> 1) * n);
+    }
+
+    // Out of Montgomery form: multiply by plain 1
+    memset(square, 0, sizeof(limb_t) * n);
+    square[0] = 1;
+    montMul(&mont, acc, acc, square);
+
+    BigInt result = fromLimbs(acc, n, 1);
+    free(storage);
+    return result;
+}
+
+// Barrett reduction modulo m of n limbs, with mu = floor(2^(128n) / m)
+typedef struct {
+    const BigInt* m;
+    int n;
+    BigInt mu;
+} Barrett;
+
+// x = x mod m for 0 <= x < m^2
+static void barrettReduce(const Barrett* barrett, BigInt* x) {
+    BigInt q = highLimbs(x, barrett->n - 1);
+    bigint_mul(&q, &q, &barrett->mu);
+
+    BigInt estimate = highLimbs(&q, barrett->n + 1);
+    bigint_mul(&estimate, &estimate, barrett->m);
+    bigint_sub_inplace(x, &estimate);
+
+    // The estimate is at most two short
+    while (bigint_abs_compare(x, barrett->m) >= 0)
+        bigint_sub_inplace(x, barrett->m);
+
+    bigint_free(&q);
+    bigint_free(&estimate);
+}
+
+static void barrettMul(const Barrett* barrett, BigInt* r, const BigInt* a, const BigInt* b) {
+    bigint_mul(r, a, b);
+    barrettReduce(barrett, r);
+}
+
+// base^exponent mod m for 0 <= base < m and m > 1
+static BigInt powModBarrett(const BigInt* base, const Magnitude* exponent, const BigInt* m) {
+    Barrett barrett = { m, limbLength(m), makeSmall(0) };
+    BigInt one = makeSmall(1);
+    barrett.mu = shiftLimbsUp(&one, 2 * barrett.n);
+    bigint_divmod(&barrett.mu, NULL, &barrett.mu, m);
+
+    int bits = bitLength(exponent);
+    int k = windowSize(bits);
+    int tableSize = 1 << (k - 1);
+
+    BigInt* table = malloc(sizeof(BigInt) * tableSize);
+    BigInt square = makeSmall(0);
+    table[0] = bigint_copy(base);
+    barrettMul(&barrett, &square, base, base);
+    for (int i = 1; i < tableSize; ++i) {
+        table[i] = makeSmall(0);
+        barrettMul(&barrett, &table[i], &table[i - 1], &square);
+    }
+
+    BigInt acc = makeSmall(1);
+    bool started = false;
+    for (int bit = bits - 1; bit >= 0;) {
+        int value;
+        int width = nextWindow(exponent, &bit, k, &value);
+
+        if (!started) {
+            if (value == 0) continue;
+            bigint_free(&acc);
+            acc = bigint_copy(&table[value >> 1]);
+            started = true;
+            continue;
+        }
+
+        for (int i = 0; i < width; ++i) barrettMul(&barrett, &acc, &acc, &acc);
+        if (value != 0) barrettMul(&barrett, &acc, &acc, &table[value >> 1]);
+    }
+
+    for (int i = 0; i < tableSize; ++i) bigint_free(&table[i]);
+    free(table);
+    bigint_free(&square);
+    bigint_free(&barrett.mu);
+    return acc;
+}
+
+// base^exponent by sliding-window multiplication
+static BigInt powWindowed(const BigInt* base, const Magnitude* exponent) {
+    int bits = bitLength(exponent);
+    int k = windowSize(bits);
+    int tableSize = 1 << (k - 1);
+
+    BigInt* table = malloc(sizeof(BigInt) * tableSize);
+    BigInt square = makeSmall(0);
+    table[0] = bigint_copy(base);
+    if (tableSize > 1) bigint_mul(&square, base, base);
+    for (int i = 1; i < tableSize; ++i) {
+        table[i] = makeSmall(0);
+        bigint_mul(&table[i], &table[i - 1], &square);
+    }
+
+    BigInt acc = makeSmall(1);
+    bool started = false;
+    for (int bit = bits - 1; bit >= 0;) {
+        int value;
+        int width = nextWindow(exponent, &bit, k, &value);
+
+        if (!started) {
+            if (value == 0) continue;
+            bigint_free(&acc);
+            acc = bigint_copy(&table[value >> 1]);
+            started = true;
+            continue;
+        }
+
+        for (int i = 0; i < width; ++i) bigint_mul(&acc, &acc, &acc);
+        if (value != 0) bigint_mul(&acc, &acc, &table[value >> 1]);
+    }
+
+    for (int i = 0; i < tableSize; ++i) bigint_free(&table[i]);
+    free(table);
+    bigint_free(&square);
+    return acc;
+}
+
+// Radix conversion
+
+#define RADIX_THRESHOLD 32   // limbs, below this digits are converted one limb at a time
+#define MAX_POW10_LEVELS 40
+
+// pow10Cache[i] = 10^(19 * 2^i), squared up on demand and kept for reuse
+static BigInt pow10Cache[MAX_POW10_LEVELS];
+static int pow10Levels = 0;
+
+static const BigInt* powerOfTen(int level) {
+    while (pow10Levels <= level) {
+        if (pow10Levels == 0) {
+            limb_t base = DEC_LIMB_BASE;
+            pow10Cache[0] = fromLimbs(&base, 1, 1);
+        } else {
+            pow10Cache[pow10Levels] = makeSmall(0);
+            bigint_mul(&pow10Cache[pow10Levels], &pow10Cache[pow10Levels - 1],
+                       &pow10Cache[pow10Levels - 1]);
+        }
+        pow10Levels++;
+    }
+    return &pow10Cache[level];
+}
+
+static BigInt parseBasecase(const char* p, int digits) {
+    BigNum* num = allocNum(digits / DEC_LIMB_DIGITS + 1);
+
+    // Consume the digits in chunks of 19, leading with the short chunk
+    int chunk = digits % DEC_LIMB_DIGITS;
+    if (chunk == 0) chunk = DEC_LIMB_DIGITS;
+
+    while (digits > 0) {
+        limb_t value = 0;
+        for (int i = 0; i < chunk; ++i)
+            value = value * 10 + (p[i] - '0');
+
+        num = mulAddSmall(num, DEC_LIMB_BASE, value);
+        p += chunk;
+        digits -= chunk;
+        chunk = DEC_LIMB_DIGITS;
+    }
+
+    return finishNum(num);
+}
+
+// Splits off the low 19 * 2^level digits, the largest such block shorter
+// than the whole, and joins the halves as high * 10^(19 * 2^level) + low
+static BigInt parseDigits(const char* p, int digits) {
+    if (digits <= RADIX_THRESHOLD * DEC_LIMB_DIGITS)
+        return parseBasecase(p, digits);
+
+    int level = 0;
+    while ((DEC_LIMB_DIGITS << (level + 1)) < digits) level++;
+    int lowDigits = DEC_LIMB_DIGITS << level;
+
+    BigInt high = parseDigits(p, digits - lowDigits);
+    BigInt low = parseDigits(p + digits - lowDigits, lowDigits);
+
+    bigint_mul(&high, &high, powerOfTen(level));
+    bigint_add_inplace(&high, &low);
+    bigint_free(&low);
+    return high;
+}
+
+// Writes the digits of a magnitude so they end at `end`, zero padded to
+// `width`, and returns where they start
+static char* formatBasecase(const limb_t* limbs, int length, char* end, int width) {
+    char* p = end;
+    limb_t* work = malloc(sizeof(limb_t) * (length > 0 ? length : 1));
+    memcpy(work, limbs, sizeof(limb_t) * length);
+
+    // Peel off 19 digits at a time from the least significant end
+    while (length > 0) {
+        limb_t rem = 0;
+        for (int i = length - 1; i >= 0; --i)
+            work[i] = divWide(rem, work[i], DEC_LIMB_BASE, &rem);
+
+        while (length > 0 && work[length - 1] == 0) length--;
+
+        int written = 0;
+        do {
+            *--p = '0' + rem % 10;
+            rem /= 10;
+            written++;
+        } while (length > 0 ? written < DEC_LIMB_DIGITS : rem != 0);
+    }
+
+    while (end - p < width) *--p = '0';
+
+    free(work);
+    return p;
+}
+
+// num < 10^(19 * 2^(level + 1)) is split by 10^(19 * 2^level) and both
+// halves written recursively, the low one always zero padded
+static char* formatDigits(const BigInt* num, int level, char* end, bool pad) {
+    if (level < 0 || limbLength(num) <= RADIX_THRESHOLD) {
+        Magnitude mag;
+        viewOf(num, &mag);
+        return formatBasecase(mag.limbs, mag.length, end, pad ? DEC_LIMB_DIGITS << (level + 1) : 0);
+    }
+
+    BigInt q = makeSmall(0), r = makeSmall(0);
+    bigint_divmod(&q, &r, num, powerOfTen(level));
+
+    char* p;
+    if (!pad && bigint_is_zero(&q)) {
+        p = formatDigits(&r, level - 1, end, false);
+    } else {
+        p = formatDigits(&r, level - 1, end, true);
+        p = formatDigits(&q, level - 1, p, pad);
+    }
+
+    bigint_free(&q);
+    bigint_free(&r);
+    return p;
+}
+
+// Initialize BigInt from an integer
+void bigint_init(BigInt* num, int value) {
+    *num = makeSmall(value);
+}
+
+BigInt bigint_from_int(int value) {
+    return makeSmall(value);
+}
+
+BigInt bigint_from_i64(int64_t value) {
+    if (value >= BIGINT_SMALL_MIN && value <= BIGINT_SMALL_MAX)
+        return makeSmall(value);
+
+    BigNum* num = allocNum(1);
+    num->sign = value < 0 ? -1 : 1;
+    num->limbs[0] = value < 0 ? -(limb_t)value : (limb_t)value;
+    num->length = 1;
+    return makeHeap(num);
+}
+
 BigInt bigint_from_str(const char* str, int len) {
-    BigInt num;
     int start = 0;
+    int sign = 1;
 
     // Handle sign
-    if (str[0] == '-') {
-        num.sign = -1;
+    if (len > 0 && str[0] == '-') {
+        sign = -1;
         start = 1;
-    } else {
-        num.sign = 1;
-        if (str[0] == '+') start = 1;
+    } else if (len > 0 && str[0] == '+') {
+        start = 1;
+    }
+
+    for (int i = start; i < len; ++i) {
+        if (!isdigit((unsigned char)str[i]))
+            return makeSmall(0);  // Optional: handle invalid input
     }
 
     // Skip leading zeros
-    while (str[start] == '0' && start < len - 1) start++;
+    while (start < len - 1 && str[start] == '0') start++;
 
-    num.length = len - start;
+    int digits = len - start;
+    const char* p = str + start;
 
-    // Copy digits in reverse order
-    for (int i = 0; i < num.length; i++) {
-        char c = str[len - 1 - i];
-        if (!isdigit(c)) {
-            num.length = 0;
-            num.sign = 1;
-            num.digits[0] = '0';
-            num.digits[1] = '\0';
-            return num;  // Optional: handle invalid input
-        }
-        num.digits[i] = c;
+    // Up to 18 digits always fit inline
+    if (digits < DEC_LIMB_DIGITS) {
+        int64_t value = 0;
+        for (int i = 0; i < digits; ++i)
+            value = value * 10 + (p[i] - '0');
+        return makeSmall(sign * value);
     }
 
-    num.digits[num.length] = '\0';
+    BigInt num = parseDigits(p, digits);
+    if (sign < 0) bigint_negate(&num);
     return num;
 }
 
+static BigNum* cloneNum(const BigNum* src) {
+    BigNum* dst = allocNum(src->length);
+    dst->sign = src->sign;
+    dst->length = src->length;
+    memcpy(dst->limbs, src->limbs, sizeof(limb_t) * src->length);
+    return dst;
+}
 
-// Print BigInt properly
-void bigint_print(BigInt* num) {
-    if (num->sign == -1) putchar('-');
-    for (int i = num->length - 1; i >= 0; --i) {
-        putchar(num->digits[i]);
+BigInt bigint_copy(const BigInt* num) {
+    if (!BIGINT_IS_SMALL(num)) BIGINT_AS_NUM(num)->refCount++;
+    return *num;
+}
+
+void bigint_free(BigInt* num) {
+    if (!BIGINT_IS_SMALL(num)) {
+        BigNum* heap = BIGINT_AS_NUM(num);
+        if (--heap->refCount == 0) free(heap);
     }
-    // putchar('\n');
+    *num = makeSmall(0);
 }
 
-// Compare absolute values of two BigInts (returns 1 if a > b, -1 if a < b, 0 if equal)
-int bigint_abs_compare(BigInt* a, BigInt* b) {
-    // First check signs
-    if (a->sign > b->sign) return 1;
-    if (a->sign < b->sign) return -1;
+// Add two BigInts, handling sign properly
+void bigint_add(BigInt* result, const BigInt* a, const BigInt* b) {
+    BigInt sum;
 
-    // If both are same sign, compare absolute values
-    int sign = a->sign;
-    if (a->length > b->length) return 1 * sign;
-    if (a->length < b->length) return -1 * sign;
-    for (int i = a->length - 1; i >= 0; --i) {
-        if (a->digits[i] > b->digits[i]) return 1 * sign;
-        if (a->digits[i] < b->digits[i]) return -1 * sign;
+    if (BIGINT_IS_SMALL(a) && BIGINT_IS_SMALL(b)) {
+        sum = bigint_from_i64(BIGINT_SMALL_VALUE(a) + BIGINT_SMALL_VALUE(b));
+    } else {
+        Magnitude ma, mb;
+        viewOf(a, &ma);
+        viewOf(b, &mb);
+        sum = addSigned(&ma, &mb, mb.sign);
     }
-    return 0;
+
+    bigint_free(result);
+    *result = sum;
 }
 
-// Add two BigInts, handling sign properly
-void bigint_add(BigInt* result, BigInt* a, BigInt* b) {
-    if (a->sign == b->sign) {
-        result->sign = a->sign;
-        int carry = 0, i;
-        result->length = (a->length > b->length ? a->length : b->length);
-        
-        for (i = 0; i < result->length || carry; ++i) {
-            int sum = carry + (i < a->length ? a->digits[i] - '0' : 0) + (i < b->length ? b->digits[i] - '0' : 0);
-            result->digits[i] = (sum % 10) + '0';
-            carry = sum / 10;
-        }
-        result->length = i;
+// Subtract two BigInts, handling sign properly
+void bigint_sub(BigInt* result, const BigInt* a, const BigInt* b) {
+    BigInt diff;
+
+    if (BIGINT_IS_SMALL(a) && BIGINT_IS_SMALL(b)) {
+        diff = bigint_from_i64(BIGINT_SMALL_VALUE(a) - BIGINT_SMALL_VALUE(b));
+    } else {
+        Magnitude ma, mb;
+        viewOf(a, &ma);
+        viewOf(b, &mb);
+        diff = addSigned(&ma, &mb, -mb.sign);
+    }
+
+    bigint_free(result);
+    *result = diff;
+}
+
+void bigint_add_inplace(BigInt* acc, const BigInt* b) {
+    addInPlace(acc, b, 0);
+}
+
+void bigint_sub_inplace(BigInt* acc, const BigInt* b) {
+    addInPlace(acc, b, 1);
+}
+
+// Multiply two BigInts, switching to Karatsuba and Toom-3 as operands grow
+void bigint_mul(BigInt* result, const BigInt* a, const BigInt* b) {
+    BigInt product;
+
+    if (BIGINT_IS_SMALL(a) && BIGINT_IS_SMALL(b)) {
+        int64_t av = BIGINT_SMALL_VALUE(a), bv = BIGINT_SMALL_VALUE(b);
+        limb_t hi;
+        limb_t lo = mulWide(av < 0 ? (limb_t)-av : (limb_t)av,
+                            bv < 0 ? (limb_t)-bv : (limb_t)bv, &hi);
+        limb_t limbs[2] = { lo, hi };
+        product = fromLimbs(limbs, 2, (av < 0) != (bv < 0) ? -1 : 1);
     } else {
-        // Convert subtraction of absolute values
-        if (a->sign == -1) {
-            a->sign = 1;
-            bigint_sub(result, b, a);
-            a->sign = -1;
+        Magnitude ma, mb;
+        viewOf(a, &ma);
+        viewOf(b, &mb);
+
+        if (ma.length == 0 || mb.length == 0) {
+            product = makeSmall(0);
         } else {
-            b->sign = 1;
-            bigint_sub(result, a, b);
-            b->sign = -1;
+            BigNum* num = allocNum(ma.length + mb.length);
+            num->sign = ma.sign * mb.sign;
+            num->length = ma.length + mb.length;
+            mulLimbs(num->limbs, ma.limbs, ma.length, mb.limbs, mb.length);
+            product = finishNum(num);
         }
     }
+
+    bigint_free(result);
+    *result = product;
 }
 
-// Subtract two BigInts, handling sign properly
-void bigint_sub(BigInt* result, BigInt* a, BigInt* b) {
-    if (a->sign != b->sign) {
-        b->sign *= -1;
-        bigint_add(result, a, b);
-        b->sign *= -1;
-        return;
+// Floor division, the remainder takes the sign of the divisor
+bool bigint_divmod(BigInt* quotient, BigInt* remainder, const BigInt* a, const BigInt* b) {
+    if (bigint_is_zero(b)) return false;
+
+    BigInt q, r;
+
+    if (BIGINT_IS_SMALL(a) && BIGINT_IS_SMALL(b)) {
+        int64_t av = BIGINT_SMALL_VALUE(a), bv = BIGINT_SMALL_VALUE(b);
+        int64_t qv = av / bv, rv = av % bv;
+
+        if (rv != 0 && (rv < 0) != (bv < 0)) {
+            qv--;
+            rv += bv;
+        }
+        q = bigint_from_i64(qv);
+        r = bigint_from_i64(rv);
+    } else {
+        Magnitude ma, mb;
+        viewOf(a, &ma);
+        viewOf(b, &mb);
+        divmodMagnitude(&q, &r, &ma, &mb);
+
+        if (ma.sign != mb.sign) bigint_negate(&q);
+        if (ma.sign < 0) bigint_negate(&r);
+
+        if (!bigint_is_zero(&r) && ma.sign != mb.sign) {
+            BigInt one = makeSmall(1);
+            bigint_sub_inplace(&q, &one);
+            bigint_add_inplace(&r, b);
+        }
     }
 
-    // Ensure we subtract the smaller from the larger (in absolute value)
-    int cmp = bigint_abs_compare(a, b);
-    if (cmp == 0) {
-        result->length = 1;
-        result->digits[0] = '0';
-        result->sign = 1;
-        return;
+    if (quotient != NULL) {
+        bigint_free(quotient);
+        *quotient = q;
+    } else {
+        bigint_free(&q);
     }
 
-    const BigInt* larger = (cmp > 0) ? a : b;
-    const BigInt* smaller = (cmp > 0) ? b : a;
-    result->sign = (cmp > 0) ? a->sign : -a->sign;
+    if (remainder != NULL) {
+        bigint_free(remainder);
+        *remainder = r;
+    } else {
+        bigint_free(&r);
+    }
+    return true;
+}
 
-    int borrow = 0;
-    result->length = larger->length;
-    for (int i = 0; i < result->length; ++i) {
-        int diff = (larger->digits[i] - '0') - borrow - (i < smaller->length ? smaller->digits[i] - '0' : 0);
-        if (diff < 0) {
-            diff += 10;
-            borrow = 1;
-        } else {
-            borrow = 0;
+void bigint_negate(BigInt* num) {
+    if (BIGINT_IS_SMALL(num)) {
+        *num = bigint_from_i64(-BIGINT_SMALL_VALUE(num));
+    } else {
+        // -(2^61) is the one heap magnitude that becomes inline once negated
+        BigNum* heap = BIGINT_AS_NUM(num);
+        if (heap->refCount > 1) {
+            heap->refCount--;
+            heap = cloneNum(heap);
         }
-        result->digits[i] = diff + '0';
+        heap->sign = -heap->sign;
+        *num = finishNum(heap);
+    }
+}
+
+bool bigint_is_zero(const BigInt* num) {
+    return BIGINT_IS_SMALL(num) && BIGINT_SMALL_VALUE(num) == 0;
+}
+
+bool bigint_is_negative(const BigInt* num) {
+    return isNegative(num);
+}
+
+// Exponentiation by sliding windows
+bool bigint_pow(BigInt* result, const BigInt* base, const BigInt* exponent) {
+    if (isNegative(exponent)) return false;
+
+    BigInt value;
+    if (BIGINT_IS_SMALL(base) && BIGINT_SMALL_VALUE(base) >= -1 && BIGINT_SMALL_VALUE(base) <= 1) {
+        // Powers of 0, 1 and -1 stay small for any exponent
+        Magnitude e;
+        viewOf(exponent, &e);
+        int64_t b = BIGINT_SMALL_VALUE(base);
+        if (e.length == 0) value = makeSmall(1);
+        else if (b == -1) value = makeSmall(e.limbs[0] & 1 ? -1 : 1);
+        else value = makeSmall(b);
+    } else {
+        // The result needs about bits(base) * exponent bits, which must fit
+        // in a BigNum's int limb count
+        Magnitude b, e;
+        viewOf(base, &b);
+        viewOf(exponent, &e);
+        if (e.length > 1 || e.limbs[0] > (uint64_t)INT32_MAX * 64 / bitLength(&b))
+            return false;
+
+        value = powWindowed(base, &e);
+    }
+
+    bigint_free(result);
+    *result = value;
+    return true;
+}
+
+// Modular exponentiation, Montgomery for odd moduli and Barrett otherwise
+bool bigint_powmod(BigInt* result, const BigInt* base, const BigInt* exponent, const BigInt* modulus) {
+    if (bigint_is_zero(modulus) || isNegative(exponent)) return false;
+
+    BigInt m = bigint_copy(modulus);
+    if (isNegative(&m)) bigint_negate(&m);
+
+    BigInt value;
+    Magnitude mm;
+    viewOf(&m, &mm);
+    if (mm.length == 1 && mm.limbs[0] == 1) {
+        value = makeSmall(0);
+    } else {
+        BigInt b = makeSmall(0);
+        bigint_divmod(NULL, &b, base, &m);
+
+        Magnitude e;
+        viewOf(exponent, &e);
+        if ((mm.limbs[0] & 1) && mm.length <= MONTGOMERY_MAX_LIMBS)
+            value = powModMontgomery(&b, &e, &m);
+        else
+            value = powModBarrett(&b, &e, &m);
+        bigint_free(&b);
+    }
+
+    // Floor semantics as with %, a non-zero result takes the modulus' sign
+    if (isNegative(modulus) && !bigint_is_zero(&value))
+        bigint_sub_inplace(&value, &m);
+
+    bigint_free(&m);
+    bigint_free(result);
+    *result = value;
+    return true;
+}
+
+// Whether two numbers have the same value. Interned numbers are unique per
+// value, so two of them are equal only if they are the same word.
+bool bigint_equal(const BigInt* a, const BigInt* b) {
+    if (a->bits == b->bits) return true;
+    if (BIGINT_IS_CANONICAL(a) && BIGINT_IS_CANONICAL(b)) return false;
+    return bigint_abs_compare(a, b) == 0;
+}
+
+uint32_t bigint_hash(const BigInt* num) {
+    if (BIGINT_IS_SMALL(num)) {
+        uint64_t h = num->bits * 0x9e3779b97f4a7c15ULL;
+        return (uint32_t)(h >> 32);
+    }
+
+    // FNV-1a over whole limbs
+    BigNum* heap = BIGINT_AS_NUM(num);
+    uint64_t h = 14695981039346656037ULL ^ (uint64_t)heap->sign;
+    for (int i = 0; i < heap->length; ++i) {
+        h ^= heap->limbs[i];
+        h *= 1099511628211ULL;
+    }
+    return (uint32_t)(h ^ (h >> 32));
+}
+
+int bigint_abs_compare(const BigInt* a, const BigInt* b) {
+    if (BIGINT_IS_SMALL(a) && BIGINT_IS_SMALL(b)) {
+        int64_t av = BIGINT_SMALL_VALUE(a), bv = BIGINT_SMALL_VALUE(b);
+        return (av > bv) - (av < bv);
+    }
+
+    Magnitude ma, mb;
+    viewOf(a, &ma);
+    viewOf(b, &mb);
+
+    // First check signs
+    if (ma.sign != mb.sign) return ma.sign > mb.sign ? 1 : -1;
+
+    // If both are same sign, compare absolute values
+    return ma.sign * limbsCompare(ma.limbs, ma.length, mb.limbs, mb.length);
+}
+
+// Writes the digits of an inline value to the end of `end`, returns the start
+static char* formatSmall(int64_t value, char* end) {
+    limb_t mag = value < 0 ? (limb_t)-value : (limb_t)value;
+
+    *--end = '\0';
+    do {
+        *--end = '0' + mag % 10;
+        mag /= 10;
+    } while (mag != 0);
+
+    if (value < 0) *--end = '-';
+    return end;
+}
+
+size_t bigint_str_bound(const BigInt* num) {
+    if (BIGINT_IS_SMALL(num)) return 21;
+
+    // A limb holds fewer than 20 decimal digits
+    return (size_t)BIGINT_AS_NUM(num)->length * 20 + 1;
+}
+
+size_t bigint_format(const BigInt* num, char* out) {
+    if (BIGINT_IS_SMALL(num)) {
+        char buf[24];
+        char* start = formatSmall(BIGINT_SMALL_VALUE(num), buf + sizeof(buf));
+        size_t length = buf + sizeof(buf) - 1 - start;
+        memcpy(out, start, length);
+        return length;
     }
 
-    // Remove leading zeros
-    while (result->length > 1 && result->digits[result->length - 1] == '0') {
-        result->length--;
+    BigNum* heap = BIGINT_AS_NUM(num);
+
+    // Fill the bound from its end, then slide the digits down
+    char* end = out + bigint_str_bound(num);
+    char* p;
+
+    if (heap->length <= RADIX_THRESHOLD) {
+        p = formatBasecase(heap->limbs, heap->length, end, 0);
+    } else {
+        // Pick the level whose square has room for every digit
+        int level = 0;
+        while ((DEC_LIMB_DIGITS << (level + 1)) < heap->length * 20) level++;
+
+        BigInt mag = fromLimbs(heap->limbs, heap->length, 1);
+        p = formatDigits(&mag, level, end, false);
+        bigint_free(&mag);
     }
+
+    if (heap->sign == -1) *--p = '-';
+
+    memmove(out, p, end - p);
+    return end - p;
 }
 
-char* bigint_to_str_buf(BigInt* num, char* buffer, int buffer_size) {
-    int totalLen = num->length + (num->sign == -1 ? 1 : 0);
-    if (buffer_size <= totalLen) return NULL;  // Not enough space
+char* bigint_to_str(const BigInt* num) {
+    char* str = malloc(bigint_str_bound(num) + 1);
+    str[bigint_format(num, str)] = '\0';
+    return str;
+}
 
-    int i = 0;
-    if (num->sign == -1) {
-        buffer[i++] = '-';
+// Print BigInt properly
+void bigint_print(const BigInt* num) {
+    if (BIGINT_IS_SMALL(num)) {
+        char buf[24];
+        fputs(formatSmall(BIGINT_SMALL_VALUE(num), buf + sizeof(buf)), stdout);
+        return;
     }
 
-    for (int j = num->length - 1; j >= 0; --j) {
-        buffer[i++] = num->digits[j];
+    char* str = bigint_to_str(num);
+    fputs(str, stdout);
+    free(str);
+}
+
+char* bigint_to_str_buf(const BigInt* num, char* buffer, int buffer_size) {
+    char* str = bigint_to_str(num);
+    int totalLen = (int)strlen(str);
+
+    if (buffer_size <= totalLen) {  // Not enough space
+        free(str);
+        return NULL;
     }
 
-    buffer[i] = '\0';
+    memcpy(buffer, str, totalLen + 1);
+    free(str);
     return buffer;
 }
+
+void bigint_release_caches() {
+    for (int i = 0; i < pow10Levels; ++i)
+        bigint_free(&pow10Cache[i]);
+    pow10Levels = 0;
+}
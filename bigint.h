@@ -5,25 +5,91 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <stdint.h>
+#include <stdbool.h>
 
-#define BIGINT_MAX_DIGITS 1024
+// Values that fit in 62 bits are kept inline in the BigInt word, so the
+// sum or difference of two of them always fits in an int64_t.
+#define BIGINT_SMALL_BITS 62
+#define BIGINT_SMALL_MAX  (((int64_t)1 << (BIGINT_SMALL_BITS - 1)) - 1)
+#define BIGINT_SMALL_MIN  (-((int64_t)1 << (BIGINT_SMALL_BITS - 1)))
 
+typedef uint64_t limb_t;
 
 typedef struct {
-    int length;  // Number of digits
-    int sign;    // 1 for positive, -1 for negative
-    char digits[BIGINT_MAX_DIGITS]; // Store digits in reverse order
+    int refCount;    // Number of BigInts sharing this number
+    int sign;        // 1 for positive, -1 for negative
+    int length;      // Number of limbs in use
+    int capacity;    // Number of limbs allocated
+    uint32_t hash;   // Set when interned
+    uint32_t id;     // Interning ID, in the order numbers were interned; 0 if not interned
+    limb_t limbs[];  // Magnitude, least significant limb first
+} BigNum;
+
+// A tagged machine word: (value << 2) | 1 for small values, otherwise a
+// pointer to a reference counted heap BigNum. Heap numbers are always
+// normalized, so a value that fits in 62 bits is never stored on the heap,
+// and immutable once shared: bigint_copy only takes another reference and
+// writers copy first unless they hold the only one.
+typedef struct {
+    uint64_t bits;
 } BigInt;
 
+#define BIGINT_IS_SMALL(num)    (((num)->bits & 1) != 0)
+#define BIGINT_SMALL_VALUE(num) ((int64_t)(num)->bits >> 2)
+#define BIGINT_AS_NUM(num)      ((BigNum*)(uintptr_t)(num)->bits)
+// Small values and interned heap numbers are equal exactly when their words are
+#define BIGINT_IS_CANONICAL(num) (BIGINT_IS_SMALL(num) || BIGINT_AS_NUM(num)->id != 0)
+
+// Shared immutable constants; small values own nothing, so these never need freeing
+#define BIGINT_ZERO          ((BigInt){ .bits = 1 })
+#define BIGINT_ONE           ((BigInt){ .bits = (1 << 2) | 1 })
+#define BIGINT_FROM_BOOL(b)  ((b) ? BIGINT_ONE : BIGINT_ZERO)
+// Only for values between BIGINT_SMALL_MIN and BIGINT_SMALL_MAX
+#define BIGINT_SMALL(v)      ((BigInt){ .bits = ((uint64_t)(v) << 2) | 1 })
 
 void bigint_init(BigInt* num, int value);
 BigInt bigint_from_int(int value);
+BigInt bigint_from_i64(int64_t value);
 BigInt bigint_from_str(const char* str, int len);
-void bigint_add(BigInt* result, BigInt* a, BigInt* b);
-void bigint_sub(BigInt* result, BigInt* a, BigInt* b);
+BigInt bigint_copy(const BigInt* num);
+void bigint_free(BigInt* num);
+
+// `result` may alias `a` or `b`; whatever it held before is released.
+void bigint_add(BigInt* result, const BigInt* a, const BigInt* b);
+void bigint_sub(BigInt* result, const BigInt* a, const BigInt* b);
+// In-place variants, safe when `b` is `acc` itself. They reuse acc's limbs
+// only when acc holds the sole reference to them.
+void bigint_add_inplace(BigInt* acc, const BigInt* b);
+void bigint_sub_inplace(BigInt* acc, const BigInt* b);
+void bigint_mul(BigInt* result, const BigInt* a, const BigInt* b);
+// Floor division as in Python, the remainder takes the sign of `b`. Either
+// output may be NULL or alias an input. Returns false when `b` is zero.
+bool bigint_divmod(BigInt* quotient, BigInt* remainder, const BigInt* a, const BigInt* b);
+// Returns false for a negative exponent or a result too large to store
+bool bigint_pow(BigInt* result, const BigInt* base, const BigInt* exponent);
+// (base ** exponent) % modulus with % semantics, without the full power.
+// Returns false for a negative exponent or a zero modulus.
+bool bigint_powmod(BigInt* result, const BigInt* base, const BigInt* exponent, const BigInt* modulus);
+void bigint_negate(BigInt* num);
+
+bool bigint_is_zero(const BigInt* num);
+bool bigint_is_negative(const BigInt* num);
+// A word compare when both sides are canonical, a digit compare otherwise
+bool bigint_equal(const BigInt* a, const BigInt* b);
+uint32_t bigint_hash(const BigInt* num);
 //returns 1 if a > b, -1 if a < b, 0 if equal
-int bigint_abs_compare(BigInt* a, BigInt* b);
-void bigint_print(BigInt* num);
-char* bigint_to_str_buf(BigInt* num, char* buffer, int buffer_size);
+int bigint_abs_compare(const BigInt* a, const BigInt* b);
+
+// Upper bound on the characters bigint_format writes, without a terminator
+size_t bigint_str_bound(const BigInt* num);
+// Writes the decimal digits to `out` unterminated, returns their count
+size_t bigint_format(const BigInt* num, char* out);
+void bigint_print(const BigInt* num);
+char* bigint_to_str(const BigInt* num);
+char* bigint_to_str_buf(const BigInt* num, char* buffer, int buffer_size);
+
+// Frees the powers of ten kept between conversions
+void bigint_release_caches();
 
 #endif // BIGINT_H
@@ -0,0 +1,105 @@
+// Generated by cryton --emit-c from tests/FAIL/catInCat.py
+#include "aot.h"
+
+static const char source[] =
+    "cat X(b):\n"
+    "    obj:\n"
+    "        2 3 (1 in b) b\n"
+    "    hom:\n"
+    "        # (1 in b) -> 2\n"
+    "        2 -> 3\n"
+    "        b -> 3 1\n"
+    "        1 -> b\n"
+    "\n"
+    "cat dummy():\n"
+    "    obj:\n"
+    "        1\n"
+    "    hom:\n"
+    "        1 -> 1\n"
+    "\n"
+    "\n"
+    "b = dummy()\n"
+    "\n"
+    "c = X(b)\n"
+    "\n"
+    "\n"
+    "# EXPECT ERROR: Undeclared object 'b' of type 'Category' inside morphism.\n"
+    "\n"
+    "\n"
+    "print(1 in c)\n"
+    "# EXPECT: 1\n"
+    "print(2 -> 3 in c)\n"
+    "# EXPECT: 1\n"
+    "\n"
+    "print(b in c)\n"
+    "# EXPECT: 1\n"
+    "\n"
+    "print(1 -> 3 in c)\n"
+    "# EXPECT: 1\n"
+    "print(1 -> b in c)\n"
+    "# EXPECT: 1\n"
+    "print(b -> b in c)\n"
+    "# EXPECT: 1";
+
+
+static void program(void) {
+    aotDefineTemplate(0);
+    aotDefineTemplate(1);
+    aotInitCategory(2, 2);
+    aotInitCategory(3, 3);
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g0 = aotCategory(4);
+        bool c1 = aotInObject(g0, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(1))));
+        t0 = BIGINT_FROM_BOOL(c1);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g2 = aotCategory(5);
+        bool c3 = aotInMorphism(g2, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(2))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(3))));
+        t0 = BIGINT_FROM_BOOL(c3);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g4 = aotCategory(6);
+        bool c5 = aotInObject(g4, aotValue(2));
+        t0 = BIGINT_FROM_BOOL(c5);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g6 = aotCategory(7);
+        bool c7 = aotInMorphism(g6, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(1))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(3))));
+        t0 = BIGINT_FROM_BOOL(c7);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g8 = aotCategory(8);
+        bool c9 = aotInMorphism(g8, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(1))), aotValue(2));
+        t0 = BIGINT_FROM_BOOL(c9);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g10 = aotCategory(9);
+        bool c11 = aotInMorphism(g10, aotValue(2), aotValue(2));
+        t0 = BIGINT_FROM_BOOL(c11);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+}
+
+static void release(void) {
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
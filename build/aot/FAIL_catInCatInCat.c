@@ -0,0 +1,86 @@
+// Generated by cryton --emit-c from tests/FAIL/catInCatInCat.py
+#include "aot.h"
+
+static const char source[] =
+    "cat X(a):\n"
+    "    obj:\n"
+    "        2 3 (1 in a) a\n"
+    "    hom:\n"
+    "        # (1 in b) -> 2\n"
+    "        2 -> 3\n"
+    "        a -> 3 1\n"
+    "        1 -> a\n"
+    "\n"
+    "cat Y(b):\n"
+    "    obj:\n"
+    "        2 3 (1 in b) b\n"
+    "    hom:\n"
+    "        # (1 in b) -> 2\n"
+    "        2 -> 3\n"
+    "        b -> 3 1\n"
+    "        1 -> b\n"
+    "\n"
+    "cat dummy():\n"
+    "    obj:\n"
+    "        1\n"
+    "    hom:\n"
+    "        1 -> 1\n"
+    "\n"
+    "\n"
+    "b = dummy()\n"
+    "\n"
+    "c = X(b)\n"
+    "d = Y(c)\n"
+    "\n"
+    "\n"
+    "# EXPECT ERROR: Undeclared object 'a' of type 'Category' inside morphism.\n"
+    "\n"
+    "print(b in d)\n"
+    "# EXPECT: 0\n"
+    "\n"
+    "print(b in c)\n"
+    "# EXPECT: 1\n"
+    "\n"
+    "print(c in d)\n"
+    "# EXPECT: 1\n";
+
+
+static void program(void) {
+    aotDefineTemplate(0);
+    aotDefineTemplate(1);
+    aotDefineTemplate(2);
+    aotInitCategory(3, 3);
+    aotInitCategory(4, 4);
+    aotInitCategory(5, 5);
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g0 = aotCategory(6);
+        bool c1 = aotInObject(g0, aotValue(3));
+        t0 = BIGINT_FROM_BOOL(c1);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g2 = aotCategory(7);
+        bool c3 = aotInObject(g2, aotValue(3));
+        t0 = BIGINT_FROM_BOOL(c3);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g4 = aotCategory(8);
+        bool c5 = aotInObject(g4, aotValue(4));
+        t0 = BIGINT_FROM_BOOL(c5);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+}
+
+static void release(void) {
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
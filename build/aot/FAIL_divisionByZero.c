@@ -0,0 +1,43 @@
+// Generated by cryton --emit-c from tests/FAIL/divisionByZero.py
+#include "aot.h"
+
+static const char source[] =
+    "a = 10\n"
+    "b = 0\n"
+    "\n"
+    "print(a / (b + 1))\n"
+    "print(a % b)\n"
+    "\n"
+    "# EXPECT ERROR: Division by zero.\n";
+
+static BigInt v0 = AOT_UNDEFINED;    // a
+static BigInt v1 = AOT_UNDEFINED;    // b
+
+static void program(void) {
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(10)));
+    aotAssign(&v1, &BIGINT_SMALL(INT64_C(0)));
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        aotAdd(&t0, &v1, &BIGINT_SMALL(INT64_C(1)));
+        aotDivide(&t1, &v0, &t0);
+        aotPrint(&t1);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotModulo(&t0, &v0, &v1);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+}
+
+static void release(void) {
+    aotFree(&v0);
+    aotFree(&v1);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
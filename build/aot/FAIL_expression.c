@@ -0,0 +1,46 @@
+// Generated by cryton --emit-c from tests/FAIL/expression.py
+#include "aot.h"
+
+static const char source[] =
+    "cat X(a):\n"
+    "    obj:\n"
+    "        (1 and 8 or 9-6+8154) (2 in a) a (1->9 in a)\n"
+    "    hom:\n"
+    "        (1 and 8 or 9-6+8154) -> (2 in a)\n"
+    "        a -> (1->9 in a)\n"
+    "        (2 in a) -> a \n"
+    "\n"
+    "c = X(1)\n"
+    "print(1 in c)\n"
+    "print(2 -> 3 in c)\n"
+    "\n"
+    "# EXPECT ERROR: Expected a variable of type category after 'in', but got 'Number'.";
+
+
+static void program(void) {
+    aotDefineTemplate(0);
+    aotInitCategory(1, 1);
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g0 = aotCategory(2);
+        bool c1 = aotInObject(g0, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(1))));
+        t0 = BIGINT_FROM_BOOL(c1);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g2 = aotCategory(3);
+        bool c3 = aotInMorphism(g2, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(2))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(3))));
+        t0 = BIGINT_FROM_BOOL(c3);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+}
+
+static void release(void) {
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
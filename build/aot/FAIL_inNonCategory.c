@@ -0,0 +1,32 @@
+// Generated by cryton --emit-c from tests/FAIL/inNonCategory.py
+#include "aot.h"
+
+static const char source[] =
+    "# The category after 'in' is checked before the element is evaluated\n"
+    "k = 5\n"
+    "print(zz in k)\n"
+    "\n"
+    "# EXPECT ERROR: Expected a variable of type category after 'in', but got 'Number'.\n";
+
+static BigInt v1 = AOT_UNDEFINED;    // zz
+
+static void program(void) {
+    aotSetGlobal(0, &BIGINT_SMALL(INT64_C(5)));
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g0 = aotCategory(0);
+        aotDefined(&v1, "zz");
+        bool c1 = aotInObject(g0, AOT_NUMBER_VALUE(&v1));
+        t0 = BIGINT_FROM_BOOL(c1);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+}
+
+static void release(void) {
+    aotFree(&v1);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
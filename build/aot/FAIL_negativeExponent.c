@@ -0,0 +1,26 @@
+// Generated by cryton --emit-c from tests/FAIL/negativeExponent.py
+#include "aot.h"
+
+static const char source[] =
+    "print(2 ** 5)\n"
+    "print(2 ** -1)\n"
+    "\n"
+    "# EXPECT ERROR: Negative exponent.\n";
+
+
+static void program(void) {
+    aotPrint(&BIGINT_SMALL(INT64_C(32)));
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotPower(&t0, &BIGINT_SMALL(INT64_C(2)), &BIGINT_SMALL(INT64_C(-1)));
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+}
+
+static void release(void) {
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
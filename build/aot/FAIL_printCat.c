@@ -0,0 +1,33 @@
+// Generated by cryton --emit-c from tests/FAIL/printCat.py
+#include "aot.h"
+
+static const char source[] =
+    "cat X(a):\n"
+    "    obj:\n"
+    "        (1) -2 a (a-100)\n"
+    "    hom:\n"
+    "        1 -> (a-100) a\n"
+    "        a -> -2\n"
+    "\n"
+    "a = 1000\n"
+    "a = X(a)\n"
+    "\n"
+    "print(a)\n"
+    "\n"
+    "# EXPECT ERROR: Cannot print variable 'a' of type 'Category'.";
+
+
+static void program(void) {
+    aotDefineTemplate(0);
+    aotSetGlobal(1, &BIGINT_SMALL(INT64_C(1000)));
+    aotInitCategory(1, 1);
+    checkStorable(aotValue(1), "print");
+    aotPrint(&aotValue(1)->number);
+}
+
+static void release(void) {
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
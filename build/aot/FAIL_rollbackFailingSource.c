@@ -0,0 +1,43 @@
+// Generated by cryton --emit-c from tests/FAIL/rollbackFailingSource.py
+#include "aot.h"
+
+static const char source[] =
+    "# The half-built category owns big numbers and a nested category's\n"
+    "# morphisms when the second morphism's source fails\n"
+    "cat Inner():\n"
+    "    obj:\n"
+    "        1 2\n"
+    "    hom:\n"
+    "        1 -> 2\n"
+    "\n"
+    "cat T(big inner):\n"
+    "    obj:\n"
+    "        big (big + 1) inner\n"
+    "    hom:\n"
+    "        big -> (big + 1) 1\n"
+    "        (big / 0) -> big\n"
+    "\n"
+    "big = 123456789012345678901234567890\n"
+    "inner = Inner()\n"
+    "t = T(big inner)\n"
+    "\n"
+    "# EXPECT ERROR: Division by zero.\n";
+
+static BigInt k3;
+
+static void program(void) {
+    k3 = bigint_from_str("123456789012345678901234567890", 30);
+    aotDefineTemplate(0);
+    aotDefineTemplate(1);
+    aotSetGlobal(2, &k3);
+    aotInitCategory(2, 3);
+    aotInitCategory(3, 4);
+}
+
+static void release(void) {
+    aotFree(&k3);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,44 @@
+// Generated by cryton --emit-c from tests/FAIL/rollbackFailingTarget.py
+#include "aot.h"
+
+static const char source[] =
+    "# The half-built category owns big numbers, a nested category's\n"
+    "# morphisms and one target of the failing morphism when its second\n"
+    "# target fails\n"
+    "cat Inner():\n"
+    "    obj:\n"
+    "        1 2\n"
+    "    hom:\n"
+    "        1 -> 2\n"
+    "\n"
+    "cat T(big inner):\n"
+    "    obj:\n"
+    "        big (big + 1) inner\n"
+    "    hom:\n"
+    "        big -> (big + 1)\n"
+    "        (big + 1) -> big zz 2\n"
+    "\n"
+    "big = 123456789012345678901234567890\n"
+    "inner = Inner()\n"
+    "t = T(big inner)\n"
+    "\n"
+    "# EXPECT ERROR: Undefined variable 'zz'.\n";
+
+static BigInt k2;
+
+static void program(void) {
+    k2 = bigint_from_str("123456789012345678901234567890", 30);
+    aotDefineTemplate(0);
+    aotDefineTemplate(1);
+    aotSetGlobal(2, &k2);
+    aotInitCategory(2, 3);
+    aotInitCategory(3, 4);
+}
+
+static void release(void) {
+    aotFree(&k2);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,57 @@
+// Generated by cryton --emit-c from tests/FAIL/typeErrorAfterLoop.py
+#include "aot.h"
+
+static const char source[] =
+    "cat Pair(a b):\n"
+    "    obj:\n"
+    "        a b\n"
+    "    hom:\n"
+    "        a -> b\n"
+    "\n"
+    "# Whether a loop finishes is not known before running, so the error after it\n"
+    "# is reported when it is reached, after the loop's output\n"
+    "i = 0\n"
+    "total = 0\n"
+    "while i < 100000:\n"
+    "    total = total + i\n"
+    "    i = i + 1\n"
+    "\n"
+    "print(total)\n"
+    "# EXPECT: 4999950000\n"
+    "print(Pair + 1)\n"
+    "\n"
+    "# EXPECT ERROR: But got values of types 'Category Template' and 'Number'\n";
+
+static BigInt v1 = AOT_UNDEFINED;    // i
+static BigInt v2 = AOT_UNDEFINED;    // total
+
+static void program(void) {
+    aotDefineTemplate(0);
+    aotAssign(&v1, &BIGINT_SMALL(INT64_C(0)));
+    aotAssign(&v2, &BIGINT_SMALL(INT64_C(0)));
+    for (;;) {
+        bool c0;
+        bool c1 = aotCompare(&v1, &BIGINT_SMALL(INT64_C(100000))) < 0;
+        c0 = c1;
+        if (!c0) break;
+        aotAdd(&v2, &v2, &v1);
+        aotAdd(&v1, &v1, &BIGINT_SMALL(INT64_C(1)));
+    }
+    aotPrint(&v2);
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotCheckNumbers(aotValue(0)->type, VALUE_NUMBER);
+        aotAdd(&t0, &aotValue(0)->number, &BIGINT_SMALL(INT64_C(1)));
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+}
+
+static void release(void) {
+    aotFree(&v1);
+    aotFree(&v2);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,26 @@
+// Generated by cryton --emit-c from tests/FAIL/undefinedMorphismSource.py
+#include "aot.h"
+
+static const char source[] =
+    "cat T():\n"
+    "    obj:\n"
+    "        1 2\n"
+    "    hom:\n"
+    "        zz -> 1\n"
+    "\n"
+    "x = T()\n"
+    "\n"
+    "# EXPECT ERROR: Undefined variable 'zz'.\n";
+
+
+static void program(void) {
+    aotDefineTemplate(0);
+    aotInitCategory(1, 1);
+}
+
+static void release(void) {
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,61 @@
+// Generated by cryton --emit-c from tests/FAIL/undefinedRightOperand.py
+#include "aot.h"
+
+static const char source[] =
+    "cat Pair(a):\n"
+    "    obj:\n"
+    "        a (a + 1)\n"
+    "    hom:\n"
+    "        a -> (a + 1)\n"
+    "\n"
+    "p = Pair(1)\n"
+    "big = 100000000000000000000000000\n"
+    "\n"
+    "if big < 0:\n"
+    "    later = 1\n"
+    "\n"
+    "print((big * big) < (p -> later in p))\n"
+    "# EXPECT ERROR: Undefined variable 'later'.\n";
+
+static BigInt v2 = AOT_UNDEFINED;    // big
+static BigInt v3 = AOT_UNDEFINED;    // later
+static BigInt k1;
+
+static void program(void) {
+    k1 = bigint_from_str("100000000000000000000000000", 27);
+    aotDefineTemplate(0);
+    aotInitCategory(1, 1);
+    aotAssign(&v2, &k1);
+    bool c0;
+    bool c1 = aotCompare(&v2, &BIGINT_SMALL(INT64_C(0))) < 0;
+    c0 = c1;
+    if (c0) {
+        aotAssign(&v3, &BIGINT_SMALL(INT64_C(1)));
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        BigInt t2 = BIGINT_ZERO;
+        aotMultiply(&t0, &v2, &v2);
+        RuntimeCategory* g2 = aotCategory(2);
+        aotDefined(&v3, "later");
+        bool c3 = aotInMorphism(g2, aotValue(1), AOT_NUMBER_VALUE(&v3));
+        t1 = BIGINT_FROM_BOOL(c3);
+        bool c4 = aotCompare(&t0, &t1) < 0;
+        t2 = BIGINT_FROM_BOOL(c4);
+        aotPrint(&t2);
+        bigint_free(&t0);
+        bigint_free(&t1);
+        bigint_free(&t2);
+    }
+}
+
+static void release(void) {
+    aotFree(&v2);
+    aotFree(&v3);
+    aotFree(&k1);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,57 @@
+// Generated by cryton --emit-c from tests/FAIL/wrongArgsCount.py
+#include "aot.h"
+
+static const char source[] =
+    "a = 1\n"
+    "b = 2\n"
+    "c = 3\n"
+    "\n"
+    "cat T(a b c):\n"
+    "    obj:\n"
+    "        a b c\n"
+    "    hom:\n"
+    "        a -> b\n"
+    "        b -> c\n"
+    "\n"
+    "instance = T(10 b 30 40)\n"
+    "\n"
+    "print(10 -> 20 in instance)\n"
+    "print(30 in instance)\n"
+    "\n"
+    "# EXPECT ERROR: Argument count does not match the parameters count of Category Template 'T' when creating Category 'instance'.";
+
+static BigInt v0 = AOT_UNDEFINED;    // a
+static BigInt v2 = AOT_UNDEFINED;    // c
+
+static void program(void) {
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(1)));
+    aotSetGlobal(1, &BIGINT_SMALL(INT64_C(2)));
+    aotAssign(&v2, &BIGINT_SMALL(INT64_C(3)));
+    aotDefineTemplate(0);
+    aotInitCategory(1, 4);
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g0 = aotCategory(2);
+        bool c1 = aotInMorphism(g0, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(10))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(20))));
+        t0 = BIGINT_FROM_BOOL(c1);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g2 = aotCategory(3);
+        bool c3 = aotInObject(g2, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(30))));
+        t0 = BIGINT_FROM_BOOL(c3);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+}
+
+static void release(void) {
+    aotFree(&v0);
+    aotFree(&v2);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
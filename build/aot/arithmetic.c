@@ -0,0 +1,39 @@
+// Generated by cryton --emit-c from tests/arithmetic.py
+#include "aot.h"
+
+static const char source[] =
+    "# EXPECT: 4\n"
+    "print(2 + 2)\n"
+    "# EXPECT: -2\n"
+    "print(5 - 7)\n"
+    "# EXPECT: 10\n"
+    "print(5 + 7 - 2)\n"
+    "# EXPECT: -4\n"
+    "print(5 - 7 - 2)\n"
+    "# EXPECT: 12\n"
+    "print(15 - (5 - 2))\n"
+    "# EXPECT: 11\n"
+    "print(15 + -4)\n"
+    "# EXPECT: 20\n"
+    "print(15 - -5)\n"
+    "# EXPECT: 50\n"
+    "print((30 - -1 + 2) - -(10 + 7))\n";
+
+
+static void program(void) {
+    aotPrint(&BIGINT_SMALL(INT64_C(4)));
+    aotPrint(&BIGINT_SMALL(INT64_C(-2)));
+    aotPrint(&BIGINT_SMALL(INT64_C(10)));
+    aotPrint(&BIGINT_SMALL(INT64_C(-4)));
+    aotPrint(&BIGINT_SMALL(INT64_C(12)));
+    aotPrint(&BIGINT_SMALL(INT64_C(11)));
+    aotPrint(&BIGINT_SMALL(INT64_C(20)));
+    aotPrint(&BIGINT_SMALL(INT64_C(50)));
+}
+
+static void release(void) {
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,63 @@
+// Generated by cryton --emit-c from tests/assignments.py
+#include "aot.h"
+
+static const char source[] =
+    "a = (1 + -9 + 8)\n"
+    "b = 1 and 6\n"
+    "c = a or b\n"
+    "d = a - (c + b)\n"
+    "\n"
+    "print(a)\n"
+    "# EXPECT: 0\n"
+    "print(b)\n"
+    "# EXPECT: 1\n"
+    "print(c)\n"
+    "# EXPECT: 1\n"
+    "print(d)\n"
+    "# EXPECT: -2";
+
+static BigInt v0 = AOT_UNDEFINED;    // a
+static BigInt v1 = AOT_UNDEFINED;    // b
+static BigInt v2 = AOT_UNDEFINED;    // c
+static BigInt v3 = AOT_UNDEFINED;    // d
+
+static void program(void) {
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(0)));
+    aotAssign(&v1, &BIGINT_SMALL(INT64_C(1)));
+    {
+        BigInt t0 = BIGINT_ZERO;
+        bool c0 = aotTruthy(&v0);
+        bool c1 = c0;
+        if (!c1) {
+            bool c2 = aotTruthy(&v1);
+            c1 = c2;
+        }
+        t0 = BIGINT_FROM_BOOL(c1);
+        aotAssign(&v2, &t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        aotAdd(&t0, &v2, &v1);
+        aotSubtract(&t1, &v0, &t0);
+        aotAssign(&v3, &t1);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+    aotPrint(&v0);
+    aotPrint(&v1);
+    aotPrint(&v2);
+    aotPrint(&v3);
+}
+
+static void release(void) {
+    aotFree(&v0);
+    aotFree(&v1);
+    aotFree(&v2);
+    aotFree(&v3);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,132 @@
+// Generated by cryton --emit-c from tests/bigMultiplication.py
+#include "aot.h"
+
+static const char source[] =
+    "# Operands large enough to take the Karatsuba and Toom-3 paths\n"
+    "f = 1\n"
+    "i = 1\n"
+    "while i < 1201:\n"
+    "    f = f * i\n"
+    "    i = i + 1\n"
+    "\n"
+    "g = f * f\n"
+    "print(g % 1000000007)\n"
+    "print(g / f == f)\n"
+    "print((g + 12345) % f)\n"
+    "print(g / (f - 1) - f)\n"
+    "\n"
+    "p = 1\n"
+    "i = 0\n"
+    "while i < 300:\n"
+    "    p = p * 18446744073709551557\n"
+    "    i = i + 1\n"
+    "print(p * p % 998244353)\n"
+    "print(p * p / p == p)\n"
+    "\n"
+    "# EXPECT START\n"
+    "# 857456308\n"
+    "# 1\n"
+    "# 12345\n"
+    "# 1\n"
+    "# 679638038\n"
+    "# 1\n"
+    "# EXPECT END\n";
+
+static BigInt v0 = AOT_UNDEFINED;    // f
+static BigInt v1 = AOT_UNDEFINED;    // i
+static BigInt v2 = AOT_UNDEFINED;    // g
+static BigInt v3 = AOT_UNDEFINED;    // p
+static BigInt k6;
+
+static void program(void) {
+    k6 = bigint_from_str("18446744073709551557", 20);
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(1)));
+    aotAssign(&v1, &BIGINT_SMALL(INT64_C(1)));
+    for (;;) {
+        bool c0;
+        bool c1 = aotCompare(&v1, &BIGINT_SMALL(INT64_C(1201))) < 0;
+        c0 = c1;
+        if (!c0) break;
+        aotMultiply(&v0, &v0, &v1);
+        aotAdd(&v1, &v1, &BIGINT_SMALL(INT64_C(1)));
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotMultiply(&t0, &v0, &v0);
+        aotAssign(&v2, &t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotModulo(&t0, &v2, &BIGINT_SMALL(INT64_C(1000000007)));
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        aotDivide(&t0, &v2, &v0);
+        bool c2 = aotEqual(&t0, &v0);
+        t1 = BIGINT_FROM_BOOL(c2);
+        aotPrint(&t1);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotAdd(&t0, &v2, &BIGINT_SMALL(INT64_C(12345)));
+        aotModulo(&t0, &t0, &v0);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        aotSubtract(&t0, &v0, &BIGINT_SMALL(INT64_C(1)));
+        aotDivide(&t1, &v2, &t0);
+        aotSubtract(&t1, &t1, &v0);
+        aotPrint(&t1);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+    aotAssign(&v3, &BIGINT_SMALL(INT64_C(1)));
+    aotAssign(&v1, &BIGINT_SMALL(INT64_C(0)));
+    for (;;) {
+        bool c3;
+        bool c4 = aotCompare(&v1, &BIGINT_SMALL(INT64_C(300))) < 0;
+        c3 = c4;
+        if (!c3) break;
+        aotMultiply(&v3, &v3, &k6);
+        aotAdd(&v1, &v1, &BIGINT_SMALL(INT64_C(1)));
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotMultiply(&t0, &v3, &v3);
+        aotModulo(&t0, &t0, &BIGINT_SMALL(INT64_C(998244353)));
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        aotMultiply(&t0, &v3, &v3);
+        aotDivide(&t0, &t0, &v3);
+        bool c5 = aotEqual(&t0, &v3);
+        t1 = BIGINT_FROM_BOOL(c5);
+        aotPrint(&t1);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+}
+
+static void release(void) {
+    aotFree(&v0);
+    aotFree(&v1);
+    aotFree(&v2);
+    aotFree(&v3);
+    aotFree(&k6);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,159 @@
+// Generated by cryton --emit-c from tests/bigint.py
+#include "aot.h"
+
+static const char source[] =
+    "x = 1\n"
+    "i = 0\n"
+    "while i < 4000:\n"
+    "    x = x + x\n"
+    "    i = i + 1\n"
+    "\n"
+    "print(x)\n"
+    "\n"
+    "# Crossing the inline/heap boundary in both directions\n"
+    "a = 2305843009213693951\n"
+    "b = a + 1\n"
+    "print(b)\n"
+    "print(b - 1)\n"
+    "c = 0 - b\n"
+    "print(c)\n"
+    "print(c - 1)\n"
+    "print(-c)\n"
+    "print(b - b)\n"
+    "print(c < a)\n"
+    "print(b > a)\n"
+    "print(99999999999999999999999999 == 99999999999999999999999999)\n"
+    "\n"
+    "y = x - 1\n"
+    "print(x - y - 1)\n"
+    "print(x - y)\n"
+    "print(1 - x)\n"
+    "\n"
+    "# EXPECT START\n"
+    "# 13182040934309431001038897942365913631840191610932727690928034502417569281128344551079752123172122033140940756480716823038446817694240581281731062452512184038544674444386888956328970642771993930036586552924249514488832183389415832375620009284922608946111038578754077913265440918583125586050431647284603636490823850007826811672468900210689104488089485347192152708820119765006125944858397761874669301278745233504796586994514054435217053803732703240283400815926169348364799472716094576894007243168662568886603065832486830606125017643356469732407252874567217733694824236675323341755681839221954693820456072020253884371226826844858636194212875139566587445390068014747975813971748114770439248826688667129237954128555841874460665729630492658600179338272579110020881228767361200603478973120168893997574353727653998969223092798255701666067972698906236921628764772837915526086464389161570534616956703744840502975279094087587298968423516531626090898389351449020056851221079048966718878943309232071978575639877208621237040940126912767610658141079378758043403611425454744180577150855204937163460902512732551260539639221457005977247266676344018155647509515396711351487546062479444592779055555421362722504575706910949376\n"
+    "# 2305843009213693952\n"
+    "# 2305843009213693951\n"
+    "# -2305843009213693952\n"
+    "# -2305843009213693953\n"
+    "# 2305843009213693952\n"
+    "# 0\n"
+    "# 1\n"
+    "# 1\n"
+    "# 1\n"
+    "# 0\n"
+    "# 1\n"
+    "# -13182040934309431001038897942365913631840191610932727690928034502417569281128344551079752123172122033140940756480716823038446817694240581281731062452512184038544674444386888956328970642771993930036586552924249514488832183389415832375620009284922608946111038578754077913265440918583125586050431647284603636490823850007826811672468900210689104488089485347192152708820119765006125944858397761874669301278745233504796586994514054435217053803732703240283400815926169348364799472716094576894007243168662568886603065832486830606125017643356469732407252874567217733694824236675323341755681839221954693820456072020253884371226826844858636194212875139566587445390068014747975813971748114770439248826688667129237954128555841874460665729630492658600179338272579110020881228767361200603478973120168893997574353727653998969223092798255701666067972698906236921628764772837915526086464389161570534616956703744840502975279094087587298968423516531626090898389351449020056851221079048966718878943309232071978575639877208621237040940126912767610658141079378758043403611425454744180577150855204937163460902512732551260539639221457005977247266676344018155647509515396711351487546062479444592779055555421362722504575706910949375\n"
+    "# EXPECT END\n";
+
+static BigInt v0 = AOT_UNDEFINED;    // x
+static BigInt v1 = AOT_UNDEFINED;    // i
+static BigInt v2 = AOT_UNDEFINED;    // a
+static BigInt v3 = AOT_UNDEFINED;    // b
+static BigInt v4 = AOT_UNDEFINED;    // c
+static BigInt v5 = AOT_UNDEFINED;    // y
+
+static void program(void) {
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(1)));
+    aotAssign(&v1, &BIGINT_SMALL(INT64_C(0)));
+    for (;;) {
+        bool c0;
+        bool c1 = aotCompare(&v1, &BIGINT_SMALL(INT64_C(4000))) < 0;
+        c0 = c1;
+        if (!c0) break;
+        aotAdd(&v0, &v0, &v0);
+        aotAdd(&v1, &v1, &BIGINT_SMALL(INT64_C(1)));
+    }
+    aotPrint(&v0);
+    aotAssign(&v2, &BIGINT_SMALL(INT64_C(2305843009213693951)));
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotAdd(&t0, &v2, &BIGINT_SMALL(INT64_C(1)));
+        aotAssign(&v3, &t0);
+        bigint_free(&t0);
+    }
+    aotPrint(&v3);
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotSubtract(&t0, &v3, &BIGINT_SMALL(INT64_C(1)));
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotSubtract(&t0, &BIGINT_SMALL(INT64_C(0)), &v3);
+        aotAssign(&v4, &t0);
+        bigint_free(&t0);
+    }
+    aotPrint(&v4);
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotSubtract(&t0, &v4, &BIGINT_SMALL(INT64_C(1)));
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotNegate(&t0, &v4);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotSubtract(&t0, &v3, &v3);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        bool c2 = aotCompare(&v4, &v2) < 0;
+        t0 = BIGINT_FROM_BOOL(c2);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        bool c3 = aotCompare(&v3, &v2) > 0;
+        t0 = BIGINT_FROM_BOOL(c3);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    aotPrint(&BIGINT_SMALL(INT64_C(1)));
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotSubtract(&t0, &v0, &BIGINT_SMALL(INT64_C(1)));
+        aotAssign(&v5, &t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotSubtract(&t0, &v0, &v5);
+        aotSubtract(&t0, &t0, &BIGINT_SMALL(INT64_C(1)));
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotSubtract(&t0, &v0, &v5);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotSubtract(&t0, &BIGINT_SMALL(INT64_C(1)), &v0);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+}
+
+static void release(void) {
+    aotFree(&v0);
+    aotFree(&v1);
+    aotFree(&v2);
+    aotFree(&v3);
+    aotFree(&v4);
+    aotFree(&v5);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
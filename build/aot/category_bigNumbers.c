@@ -0,0 +1,167 @@
+// Generated by cryton --emit-c from tests/category/bigNumbers.py
+#include "aot.h"
+
+static const char source[] =
+    "a = 100000000000000000000000000000\n"
+    "b = a * a\n"
+    "c = b + 1\n"
+    "\n"
+    "cat T(x y z):\n"
+    "    obj:\n"
+    "        x y z\n"
+    "    hom:\n"
+    "        x -> y\n"
+    "        y -> z\n"
+    "\n"
+    "big = T(a b c)\n"
+    "\n"
+    "print(100000000000000000000000000000 in big)\n"
+    "print(a * a in big)\n"
+    "print(a * a + 1 in big)\n"
+    "print(a * a + 2 in big)\n"
+    "print(a -> c in big)\n"
+    "print(c -> a in big)\n"
+    "print(a * a - 1 -> c in big)\n"
+    "print(b -> b in big)\n"
+    "\n"
+    "# EXPECT: 1\n"
+    "# EXPECT: 1\n"
+    "# EXPECT: 1\n"
+    "# EXPECT: 0\n"
+    "# EXPECT: 1\n"
+    "# EXPECT: 0\n"
+    "# EXPECT: 0\n"
+    "# EXPECT: 1\n"
+    "\n"
+    "d = a * 10 / 10\n"
+    "same = T(a d b)\n"
+    "print(a -> a * a in same)\n"
+    "\n"
+    "# EXPECT: 1\n";
+
+static BigInt k0;
+
+static void program(void) {
+    k0 = bigint_from_str("100000000000000000000000000000", 30);
+    aotSetGlobal(0, &k0);
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotMultiply(&t0, aotNumber(0), aotNumber(0));
+        aotSetGlobal(1, &t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotAdd(&t0, aotNumber(1), &BIGINT_SMALL(INT64_C(1)));
+        aotSetGlobal(2, &t0);
+        bigint_free(&t0);
+    }
+    aotDefineTemplate(0);
+    aotInitCategory(1, 4);
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g0 = aotCategory(2);
+        bool c1 = aotInObject(g0, AOT_NUMBER_VALUE(&k0));
+        t0 = BIGINT_FROM_BOOL(c1);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        RuntimeCategory* g2 = aotCategory(3);
+        aotMultiply(&t0, aotNumber(0), aotNumber(0));
+        bool c3 = aotInObject(g2, AOT_NUMBER_VALUE(&t0));
+        t1 = BIGINT_FROM_BOOL(c3);
+        aotPrint(&t1);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        RuntimeCategory* g4 = aotCategory(4);
+        aotMultiply(&t0, aotNumber(0), aotNumber(0));
+        aotAdd(&t0, &t0, &BIGINT_SMALL(INT64_C(1)));
+        bool c5 = aotInObject(g4, AOT_NUMBER_VALUE(&t0));
+        t1 = BIGINT_FROM_BOOL(c5);
+        aotPrint(&t1);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        RuntimeCategory* g6 = aotCategory(5);
+        aotMultiply(&t0, aotNumber(0), aotNumber(0));
+        aotAdd(&t0, &t0, &BIGINT_SMALL(INT64_C(2)));
+        bool c7 = aotInObject(g6, AOT_NUMBER_VALUE(&t0));
+        t1 = BIGINT_FROM_BOOL(c7);
+        aotPrint(&t1);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g8 = aotCategory(6);
+        bool c9 = aotInMorphism(g8, AOT_NUMBER_VALUE(aotNumber(0)), AOT_NUMBER_VALUE(aotNumber(2)));
+        t0 = BIGINT_FROM_BOOL(c9);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g10 = aotCategory(7);
+        bool c11 = aotInMorphism(g10, AOT_NUMBER_VALUE(aotNumber(2)), AOT_NUMBER_VALUE(aotNumber(0)));
+        t0 = BIGINT_FROM_BOOL(c11);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        RuntimeCategory* g12 = aotCategory(8);
+        aotMultiply(&t0, aotNumber(0), aotNumber(0));
+        aotSubtract(&t0, &t0, &BIGINT_SMALL(INT64_C(1)));
+        bool c13 = aotInMorphism(g12, AOT_NUMBER_VALUE(&t0), AOT_NUMBER_VALUE(aotNumber(2)));
+        t1 = BIGINT_FROM_BOOL(c13);
+        aotPrint(&t1);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g14 = aotCategory(9);
+        bool c15 = aotInMorphism(g14, AOT_NUMBER_VALUE(aotNumber(1)), AOT_NUMBER_VALUE(aotNumber(1)));
+        t0 = BIGINT_FROM_BOOL(c15);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotMultiply(&t0, aotNumber(0), &BIGINT_SMALL(INT64_C(10)));
+        aotDivide(&t0, &t0, &BIGINT_SMALL(INT64_C(10)));
+        aotSetGlobal(5, &t0);
+        bigint_free(&t0);
+    }
+    aotInitCategory(10, 6);
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        RuntimeCategory* g16 = aotCategory(11);
+        aotMultiply(&t0, aotNumber(0), aotNumber(0));
+        bool c17 = aotInMorphism(g16, AOT_NUMBER_VALUE(aotNumber(0)), AOT_NUMBER_VALUE(&t0));
+        t1 = BIGINT_FROM_BOOL(c17);
+        aotPrint(&t1);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+}
+
+static void release(void) {
+    aotFree(&k0);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,203 @@
+// Generated by cryton --emit-c from tests/category/cat_without_morphisms.py
+#include "aot.h"
+
+static const char source[] =
+    "cat C():\n"
+    "    obj:\n"
+    "        1 2 3\n"
+    "    hom:\n"
+    "\n"
+    "c = C()\n"
+    "\n"
+    "# Objects present in category\n"
+    "# EXPECT: 1\n"
+    "print(1 in c)\n"
+    "# EXPECT: 1\n"
+    "print(2 in c)\n"
+    "# EXPECT: 1\n"
+    "print(3 in c)\n"
+    "\n"
+    "# Objects not present in category\n"
+    "# EXPECT: 0\n"
+    "print(0 in c)\n"
+    "# EXPECT: 0\n"
+    "print(13 in c)\n"
+    "\n"
+    "# Identity morphisms (always implicitly defined)\n"
+    "# EXPECT: 1\n"
+    "print(1 -> 1 in c)\n"
+    "# EXPECT: 1\n"
+    "print(2 -> 2 in c)\n"
+    "# EXPECT: 1\n"
+    "print(3 -> 3 in c)\n"
+    "\n"
+    "# Morphisms with objects not present in category\n"
+    "# EXPECT: 0\n"
+    "print(0 -> 0 in c)\n"
+    "# EXPECT: 0\n"
+    "print(1 -> 0 in c)\n"
+    "# EXPECT: 0\n"
+    "print(0 -> 1 in c)\n"
+    "# EXPECT: 0\n"
+    "print(0 -> 13 in c)\n"
+    "# EXPECT: 0\n"
+    "print(1 -> 13 in c)\n"
+    "# EXPECT: 0\n"
+    "print(13 -> 1 in c)\n"
+    "\n"
+    "# Morphisms not present in category\n"
+    "# EXPECT: 0\n"
+    "print(1 -> 2 in c)\n"
+    "# EXPECT: 0\n"
+    "print(1 -> 3 in c)\n"
+    "# EXPECT: 0\n"
+    "print(2 -> 3 in c)\n";
+
+
+static void program(void) {
+    aotDefineTemplate(0);
+    aotInitCategory(1, 1);
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g0 = aotCategory(2);
+        bool c1 = aotInObject(g0, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(1))));
+        t0 = BIGINT_FROM_BOOL(c1);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g2 = aotCategory(3);
+        bool c3 = aotInObject(g2, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(2))));
+        t0 = BIGINT_FROM_BOOL(c3);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g4 = aotCategory(4);
+        bool c5 = aotInObject(g4, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(3))));
+        t0 = BIGINT_FROM_BOOL(c5);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g6 = aotCategory(5);
+        bool c7 = aotInObject(g6, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(0))));
+        t0 = BIGINT_FROM_BOOL(c7);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g8 = aotCategory(6);
+        bool c9 = aotInObject(g8, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(13))));
+        t0 = BIGINT_FROM_BOOL(c9);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g10 = aotCategory(7);
+        bool c11 = aotInMorphism(g10, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(1))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(1))));
+        t0 = BIGINT_FROM_BOOL(c11);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g12 = aotCategory(8);
+        bool c13 = aotInMorphism(g12, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(2))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(2))));
+        t0 = BIGINT_FROM_BOOL(c13);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g14 = aotCategory(9);
+        bool c15 = aotInMorphism(g14, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(3))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(3))));
+        t0 = BIGINT_FROM_BOOL(c15);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g16 = aotCategory(10);
+        bool c17 = aotInMorphism(g16, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(0))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(0))));
+        t0 = BIGINT_FROM_BOOL(c17);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g18 = aotCategory(11);
+        bool c19 = aotInMorphism(g18, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(1))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(0))));
+        t0 = BIGINT_FROM_BOOL(c19);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g20 = aotCategory(12);
+        bool c21 = aotInMorphism(g20, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(0))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(1))));
+        t0 = BIGINT_FROM_BOOL(c21);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g22 = aotCategory(13);
+        bool c23 = aotInMorphism(g22, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(0))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(13))));
+        t0 = BIGINT_FROM_BOOL(c23);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g24 = aotCategory(14);
+        bool c25 = aotInMorphism(g24, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(1))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(13))));
+        t0 = BIGINT_FROM_BOOL(c25);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g26 = aotCategory(15);
+        bool c27 = aotInMorphism(g26, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(13))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(1))));
+        t0 = BIGINT_FROM_BOOL(c27);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g28 = aotCategory(16);
+        bool c29 = aotInMorphism(g28, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(1))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(2))));
+        t0 = BIGINT_FROM_BOOL(c29);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g30 = aotCategory(17);
+        bool c31 = aotInMorphism(g30, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(1))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(3))));
+        t0 = BIGINT_FROM_BOOL(c31);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g32 = aotCategory(18);
+        bool c33 = aotInMorphism(g32, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(2))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(3))));
+        t0 = BIGINT_FROM_BOOL(c33);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+}
+
+static void release(void) {
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,134 @@
+// Generated by cryton --emit-c from tests/category/category.py
+#include "aot.h"
+
+static const char source[] =
+    "a = 1\n"
+    "b = 2\n"
+    "c = 3\n"
+    "\n"
+    "cat p(a b c):\n"
+    "    obj:\n"
+    "        40 5 65 412345 7 a\n"
+    "        (-5789654123) (a+1) 58421 59 46 -3 -4 -5 (1 and 6)\n"
+    "        b c\n"
+    "    hom:\n"
+    "        4 -> 9 99 999 1 2 -3 -4 -5 6 7 8 9 7 8 9 5 4 12 6 4 2 4 8 6 64  8 64 89 5 56489 795 5525 1 2 3 4 5 6 7 8 9 41 21 65  16 285 91 156 165 15461 451 35261 561 561 23 01 234181\n"
+    "        65 -> 5 4\n"
+    "        -4 -> 4\n"
+    "        8 -> 65\n"
+    "        a -> (a + 1)\n"
+    "        a -> b\n"
+    "        b -> c\n"
+    "\n"
+    "\n"
+    "categ = p((a+1) b c)\n"
+    "\n"
+    "a = 41234\n"
+    "b = 51231\n"
+    "c = 61234\n"
+    "gg = p(a b c)\n"
+    "\n"
+    "if 65 -> 5 in categ:\n"
+    "    print(1)\n"
+    "else:\n"
+    "    print(0)\n"
+    "\n"
+    "# EXPECT ERROR: Undeclared object 4 of type 'Number' inside morphism.\n"
+    "\n"
+    "# EXPECT: 1\n"
+    "\n"
+    "print(41234 -> 41235 in gg)\n"
+    "# EXPECT: 1\n"
+    "\n"
+    "\n"
+    "print(1 -> 5555 in categ)\n"
+    "# EXPECT: 0\n"
+    "\n"
+    "print(-3 in categ)\n"
+    "# EXPECT: 1\n"
+    "print(-4 in categ)\n"
+    "# EXPECT: 1\n"
+    "print(-9 in categ)\n"
+    "# EXPECT: 0\n"
+    "print(-5789654123 in categ)\n"
+    "# EXPECT: 1\n"
+    "\n"
+    "p = 1";
+
+
+static void program(void) {
+    aotSetGlobal(0, &BIGINT_SMALL(INT64_C(1)));
+    aotSetGlobal(1, &BIGINT_SMALL(INT64_C(2)));
+    aotSetGlobal(2, &BIGINT_SMALL(INT64_C(3)));
+    aotDefineTemplate(0);
+    aotInitCategory(1, 4);
+    aotSetGlobal(0, &BIGINT_SMALL(INT64_C(41234)));
+    aotSetGlobal(1, &BIGINT_SMALL(INT64_C(51231)));
+    aotSetGlobal(2, &BIGINT_SMALL(INT64_C(61234)));
+    aotInitCategory(2, 5);
+    bool c0;
+    RuntimeCategory* g1 = aotCategory(3);
+    bool c2 = aotInMorphism(g1, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(65))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(5))));
+    c0 = c2;
+    if (c0) {
+        aotPrint(&BIGINT_SMALL(INT64_C(1)));
+    } else {
+        aotPrint(&BIGINT_SMALL(INT64_C(0)));
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g3 = aotCategory(4);
+        bool c4 = aotInMorphism(g3, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(41234))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(41235))));
+        t0 = BIGINT_FROM_BOOL(c4);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g5 = aotCategory(5);
+        bool c6 = aotInMorphism(g5, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(1))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(5555))));
+        t0 = BIGINT_FROM_BOOL(c6);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g7 = aotCategory(6);
+        bool c8 = aotInObject(g7, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(-3))));
+        t0 = BIGINT_FROM_BOOL(c8);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g9 = aotCategory(7);
+        bool c10 = aotInObject(g9, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(-4))));
+        t0 = BIGINT_FROM_BOOL(c10);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g11 = aotCategory(8);
+        bool c12 = aotInObject(g11, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(-9))));
+        t0 = BIGINT_FROM_BOOL(c12);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g13 = aotCategory(9);
+        bool c14 = aotInObject(g13, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(-5789654123))));
+        t0 = BIGINT_FROM_BOOL(c14);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    aotSetGlobal(3, &BIGINT_SMALL(INT64_C(1)));
+}
+
+static void release(void) {
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,91 @@
+// Generated by cryton --emit-c from tests/category/composition.py
+#include "aot.h"
+
+static const char source[] =
+    "cat T(a b c d):\n"
+    "    obj:\n"
+    "        a b c d\n"
+    "    hom:\n"
+    "        a -> b\n"
+    "        b -> c\n"
+    "        c -> d\n"
+    "\n"
+    "instance = T(10 20 30 40)\n"
+    "\n"
+    "print(10 -> 20 in instance)\n"
+    "print(20 -> 30 in instance)\n"
+    "print(30 -> 40 in instance)\n"
+    "# EXPECT: 1\n"
+    "# EXPECT: 1\n"
+    "# EXPECT: 1\n"
+    "\n"
+    "# composition\n"
+    "print(10 -> 30 in instance)\n"
+    "print(10 -> 40 in instance)\n"
+    "\n"
+    "print(20 -> 40 in instance)\n"
+    "\n"
+    "# EXPECT: 1\n"
+    "# EXPECT: 1\n"
+    "# EXPECT: 1";
+
+
+static void program(void) {
+    aotDefineTemplate(0);
+    aotInitCategory(1, 1);
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g0 = aotCategory(2);
+        bool c1 = aotInMorphism(g0, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(10))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(20))));
+        t0 = BIGINT_FROM_BOOL(c1);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g2 = aotCategory(3);
+        bool c3 = aotInMorphism(g2, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(20))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(30))));
+        t0 = BIGINT_FROM_BOOL(c3);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g4 = aotCategory(4);
+        bool c5 = aotInMorphism(g4, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(30))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(40))));
+        t0 = BIGINT_FROM_BOOL(c5);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g6 = aotCategory(5);
+        bool c7 = aotInMorphism(g6, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(10))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(30))));
+        t0 = BIGINT_FROM_BOOL(c7);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g8 = aotCategory(6);
+        bool c9 = aotInMorphism(g8, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(10))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(40))));
+        t0 = BIGINT_FROM_BOOL(c9);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g10 = aotCategory(7);
+        bool c11 = aotInMorphism(g10, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(20))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(40))));
+        t0 = BIGINT_FROM_BOOL(c11);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+}
+
+static void release(void) {
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,85 @@
+// Generated by cryton --emit-c from tests/category/create_instance.py
+#include "aot.h"
+
+static const char source[] =
+    "a = 1\n"
+    "b = 2\n"
+    "c = 3\n"
+    "\n"
+    "cat T(a b c):\n"
+    "    obj:\n"
+    "        a b c\n"
+    "    hom:\n"
+    "        a -> b\n"
+    "        b -> c\n"
+    "\n"
+    "instance = T(10 20 30)\n"
+    "\n"
+    "print(10 -> 20 in instance)\n"
+    "print(30 in instance)\n"
+    "\n"
+    "# EXPECT: 1\n"
+    "# EXPECT: 1\n"
+    "\n"
+    "a = 10\n"
+    "b = 20\n"
+    "c = 30\n"
+    "instance = T(a b c)\n"
+    "\n"
+    "print(10 -> 20 in instance)\n"
+    "print(30 in instance)\n"
+    "\n"
+    "# EXPECT: 1\n"
+    "# EXPECT: 1";
+
+
+static void program(void) {
+    aotSetGlobal(0, &BIGINT_SMALL(INT64_C(1)));
+    aotSetGlobal(1, &BIGINT_SMALL(INT64_C(2)));
+    aotSetGlobal(2, &BIGINT_SMALL(INT64_C(3)));
+    aotDefineTemplate(0);
+    aotInitCategory(1, 4);
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g0 = aotCategory(2);
+        bool c1 = aotInMorphism(g0, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(10))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(20))));
+        t0 = BIGINT_FROM_BOOL(c1);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g2 = aotCategory(3);
+        bool c3 = aotInObject(g2, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(30))));
+        t0 = BIGINT_FROM_BOOL(c3);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    aotSetGlobal(0, &BIGINT_SMALL(INT64_C(10)));
+    aotSetGlobal(1, &BIGINT_SMALL(INT64_C(20)));
+    aotSetGlobal(2, &BIGINT_SMALL(INT64_C(30)));
+    aotInitCategory(4, 4);
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g4 = aotCategory(5);
+        bool c5 = aotInMorphism(g4, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(10))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(20))));
+        t0 = BIGINT_FROM_BOOL(c5);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g6 = aotCategory(6);
+        bool c7 = aotInObject(g6, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(30))));
+        t0 = BIGINT_FROM_BOOL(c7);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+}
+
+static void release(void) {
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
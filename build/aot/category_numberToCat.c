@@ -0,0 +1,38 @@
+// Generated by cryton --emit-c from tests/category/numberToCat.py
+#include "aot.h"
+
+static const char source[] =
+    "cat X(a):\n"
+    "    obj:\n"
+    "        (1) -2 a (a-100)\n"
+    "    hom:\n"
+    "        1 -> (a-100) a\n"
+    "        a -> -2\n"
+    "\n"
+    "a = 1000\n"
+    "a = X(a)\n"
+    "\n"
+    "print(900 in a)\n"
+    "# EXPECT: 1";
+
+
+static void program(void) {
+    aotDefineTemplate(0);
+    aotSetGlobal(1, &BIGINT_SMALL(INT64_C(1000)));
+    aotInitCategory(1, 1);
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g0 = aotCategory(2);
+        bool c1 = aotInObject(g0, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(900))));
+        t0 = BIGINT_FROM_BOOL(c1);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+}
+
+static void release(void) {
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,28 @@
+// Generated by cryton --emit-c from tests/category/template_override.py
+#include "aot.h"
+
+static const char source[] =
+    "cat Z():\n"
+    "    obj:\n"
+    "        1 2 3\n"
+    "    hom:\n"
+    "        1 -> 2\n"
+    "\n"
+    "Z = 99\n"
+    "print(Z)\n"
+    "\n"
+    "# EXPECT: 99\n";
+
+
+static void program(void) {
+    aotDefineTemplate(0);
+    aotSetGlobal(0, &BIGINT_SMALL(INT64_C(99)));
+    aotPrint(aotNumber(0));
+}
+
+static void release(void) {
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
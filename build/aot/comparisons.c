@@ -0,0 +1,94 @@
+// Generated by cryton --emit-c from tests/comparisons.py
+#include "aot.h"
+
+static const char source[] =
+    "# EXPECT: 0\n"
+    "print(5 < 3)\n"
+    "# EXPECT: 1\n"
+    "print(5 > 3)\n"
+    "# EXPECT: 1\n"
+    "print(not 5 < 3)\n"
+    "# EXPECT: 0\n"
+    "print(5 == 3)\n"
+    "# EXPECT: 1\n"
+    "print(5 != 3)\n"
+    "# EXPECT: 1\n"
+    "print(not 5 == 3)\n"
+    "# EXPECT: 1\n"
+    "print(5 + 1 == 6)\n"
+    "\n"
+    "a = 13\n"
+    "b = 10\n"
+    "\n"
+    "# EXPECT: 1\n"
+    "print(a > b)\n"
+    "# EXPECT: 1\n"
+    "print(a == b + 3)\n"
+    "# EXPECT: 1\n"
+    "print((not a) == (not b))\n"
+    "# EXPECT: 1\n"
+    "print((not a) == (not not 0))\n";
+
+static BigInt v0 = AOT_UNDEFINED;    // a
+static BigInt v1 = AOT_UNDEFINED;    // b
+
+static void program(void) {
+    aotPrint(&BIGINT_SMALL(INT64_C(0)));
+    aotPrint(&BIGINT_SMALL(INT64_C(1)));
+    aotPrint(&BIGINT_SMALL(INT64_C(1)));
+    aotPrint(&BIGINT_SMALL(INT64_C(0)));
+    aotPrint(&BIGINT_SMALL(INT64_C(1)));
+    aotPrint(&BIGINT_SMALL(INT64_C(1)));
+    aotPrint(&BIGINT_SMALL(INT64_C(1)));
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(13)));
+    aotAssign(&v1, &BIGINT_SMALL(INT64_C(10)));
+    {
+        BigInt t0 = BIGINT_ZERO;
+        bool c0 = aotCompare(&v0, &v1) > 0;
+        t0 = BIGINT_FROM_BOOL(c0);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        aotAdd(&t0, &v1, &BIGINT_SMALL(INT64_C(3)));
+        bool c1 = aotEqual(&v0, &t0);
+        t1 = BIGINT_FROM_BOOL(c1);
+        aotPrint(&t1);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        BigInt t2 = BIGINT_ZERO;
+        t0 = BIGINT_FROM_BOOL(!aotTruthy(&v0));
+        t1 = BIGINT_FROM_BOOL(!aotTruthy(&v1));
+        bool c2 = aotEqual(&t0, &t1);
+        t2 = BIGINT_FROM_BOOL(c2);
+        aotPrint(&t2);
+        bigint_free(&t0);
+        bigint_free(&t1);
+        bigint_free(&t2);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        t0 = BIGINT_FROM_BOOL(!aotTruthy(&v0));
+        bool c3 = aotEqual(&t0, &BIGINT_SMALL(INT64_C(0)));
+        t1 = BIGINT_FROM_BOOL(c3);
+        aotPrint(&t1);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+}
+
+static void release(void) {
+    aotFree(&v0);
+    aotFree(&v1);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
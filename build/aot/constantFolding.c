@@ -0,0 +1,116 @@
+// Generated by cryton --emit-c from tests/constantFolding.py
+#include "aot.h"
+
+static const char source[] =
+    "# Constant expressions\n"
+    "# ==============================\n"
+    "print(-3)\n"
+    "print(2 * (3 + 4) - 10 / 3)\n"
+    "print(1 and 8 or 9 - 6 + 8154)\n"
+    "print(not (5 > 2))\n"
+    "print(2 ** 100 % 1000)\n"
+    "# EXPECT: -3\n"
+    "# EXPECT: 11\n"
+    "# EXPECT: 1\n"
+    "# EXPECT: 0\n"
+    "# EXPECT: 376\n"
+    "# ==============================\n"
+    "\n"
+    "# Constant conditions\n"
+    "# ==============================\n"
+    "if (1 < 0):\n"
+    "    print(1 / 0)\n"
+    "elif (2 == 2):\n"
+    "    print(200)\n"
+    "else:\n"
+    "    print(300)\n"
+    "# EXPECT: 200\n"
+    "\n"
+    "while (0):\n"
+    "    print(400)\n"
+    "\n"
+    "x = 0\n"
+    "while (1 and x < 2):\n"
+    "    x = x + 1\n"
+    "print(x)\n"
+    "# EXPECT: 2\n"
+    "# ==============================\n"
+    "\n"
+    "# Folded values inside categories\n"
+    "# ==============================\n"
+    "cat T(a):\n"
+    "    obj:\n"
+    "        (1 and 8 or 9) -3 (a * 2) (2 ** 70)\n"
+    "    hom:\n"
+    "        -3 -> (2 ** 70)\n"
+    "\n"
+    "t = T(5)\n"
+    "print(1 in t)\n"
+    "print(-3 -> 1180591620717411303424 in t)\n"
+    "print(10 in t)\n"
+    "# EXPECT: 1\n"
+    "# EXPECT: 1\n"
+    "# EXPECT: 1\n"
+    "# ==============================\n";
+
+static BigInt v0 = AOT_UNDEFINED;    // x
+static BigInt k17;
+
+static void program(void) {
+    k17 = bigint_from_str("1180591620717411303424", 22);
+    aotPrint(&BIGINT_SMALL(INT64_C(-3)));
+    aotPrint(&BIGINT_SMALL(INT64_C(11)));
+    aotPrint(&BIGINT_SMALL(INT64_C(1)));
+    aotPrint(&BIGINT_SMALL(INT64_C(0)));
+    aotPrint(&BIGINT_SMALL(INT64_C(376)));
+    aotPrint(&BIGINT_SMALL(INT64_C(200)));
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(0)));
+    for (;;) {
+        bool c0;
+        bool c1 = aotTruthy(&BIGINT_SMALL(INT64_C(1)));
+        bool c2 = c1;
+        if (c2) {
+            bool c3 = aotCompare(&v0, &BIGINT_SMALL(INT64_C(2))) < 0;
+            c2 = c3;
+        }
+        c0 = c2;
+        if (!c0) break;
+        aotAdd(&v0, &v0, &BIGINT_SMALL(INT64_C(1)));
+    }
+    aotPrint(&v0);
+    aotDefineTemplate(0);
+    aotInitCategory(1, 2);
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g4 = aotCategory(2);
+        bool c5 = aotInObject(g4, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(1))));
+        t0 = BIGINT_FROM_BOOL(c5);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g6 = aotCategory(3);
+        bool c7 = aotInMorphism(g6, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(-3))), AOT_NUMBER_VALUE(&k17));
+        t0 = BIGINT_FROM_BOOL(c7);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g8 = aotCategory(4);
+        bool c9 = aotInObject(g8, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(10))));
+        t0 = BIGINT_FROM_BOOL(c9);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+}
+
+static void release(void) {
+    aotFree(&v0);
+    aotFree(&k17);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
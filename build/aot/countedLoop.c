@@ -0,0 +1,155 @@
+// Generated by cryton --emit-c from tests/countedLoop.py
+#include "aot.h"
+
+static const char source[] =
+    "# Counters cross the inline range in both directions\n"
+    "# ==============================\n"
+    "i = 2305843009213693945\n"
+    "while i < 2305843009213693955:\n"
+    "    i = i + 3\n"
+    "print(i)\n"
+    "# EXPECT: 2305843009213693957\n"
+    "\n"
+    "step = 4611686018427387904\n"
+    "while i > -10000000000000000000:\n"
+    "    i = i - step\n"
+    "print(i)\n"
+    "# EXPECT: -11529215046068469755\n"
+    "# ==============================\n"
+    "\n"
+    "# Variable steps and bounds, != tests, and the body reading the counter\n"
+    "# ==============================\n"
+    "n = 10\n"
+    "k = 0\n"
+    "sum = 0\n"
+    "while k != n:\n"
+    "    sum = sum + k * k\n"
+    "    k = k + 2\n"
+    "print(sum)\n"
+    "# EXPECT: 120\n"
+    "\n"
+    "dividend = 23\n"
+    "divisor = 5\n"
+    "while (dividend > 0):\n"
+    "    dividend = dividend - divisor\n"
+    "print(dividend)\n"
+    "# EXPECT: -2\n"
+    "# ==============================\n"
+    "\n"
+    "# Nested counted loops\n"
+    "# ==============================\n"
+    "a = 0\n"
+    "count = 0\n"
+    "while a < 3:\n"
+    "    b = a\n"
+    "    while b < 3:\n"
+    "        count = count + 1\n"
+    "        b = b + 1\n"
+    "    a = a + 1\n"
+    "print(count)\n"
+    "# EXPECT: 6\n"
+    "# ==============================\n";
+
+static BigInt v0 = AOT_UNDEFINED;    // i
+static BigInt v1 = AOT_UNDEFINED;    // step
+static BigInt v2 = AOT_UNDEFINED;    // n
+static BigInt v3 = AOT_UNDEFINED;    // k
+static BigInt v4 = AOT_UNDEFINED;    // sum
+static BigInt v5 = AOT_UNDEFINED;    // dividend
+static BigInt v6 = AOT_UNDEFINED;    // divisor
+static BigInt v7 = AOT_UNDEFINED;    // a
+static BigInt v8 = AOT_UNDEFINED;    // count
+static BigInt v9 = AOT_UNDEFINED;    // b
+static BigInt k1;
+static BigInt k3;
+static BigInt k11;
+
+static void program(void) {
+    k1 = bigint_from_str("2305843009213693955", 19);
+    k3 = bigint_from_str("4611686018427387904", 19);
+    k11 = bigint_from_str("-10000000000000000000", 21);
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(2305843009213693945)));
+    for (;;) {
+        bool c0;
+        bool c1 = aotCompare(&v0, &k1) < 0;
+        c0 = c1;
+        if (!c0) break;
+        aotAdd(&v0, &v0, &BIGINT_SMALL(INT64_C(3)));
+    }
+    aotPrint(&v0);
+    aotAssign(&v1, &k3);
+    for (;;) {
+        bool c2;
+        bool c3 = aotCompare(&v0, &k11) > 0;
+        c2 = c3;
+        if (!c2) break;
+        aotSubtract(&v0, &v0, &v1);
+    }
+    aotPrint(&v0);
+    aotAssign(&v2, &BIGINT_SMALL(INT64_C(10)));
+    aotAssign(&v3, &BIGINT_SMALL(INT64_C(0)));
+    aotAssign(&v4, &BIGINT_SMALL(INT64_C(0)));
+    for (;;) {
+        bool c4;
+        bool c5 = !aotEqual(&v3, &v2);
+        c4 = c5;
+        if (!c4) break;
+        {
+            BigInt t0 = BIGINT_ZERO;
+            aotMultiply(&t0, &v3, &v3);
+            aotAdd(&v4, &v4, &t0);
+            bigint_free(&t0);
+        }
+        aotAdd(&v3, &v3, &BIGINT_SMALL(INT64_C(2)));
+    }
+    aotPrint(&v4);
+    aotAssign(&v5, &BIGINT_SMALL(INT64_C(23)));
+    aotAssign(&v6, &BIGINT_SMALL(INT64_C(5)));
+    for (;;) {
+        bool c6;
+        bool c7 = aotCompare(&v5, &BIGINT_SMALL(INT64_C(0))) > 0;
+        c6 = c7;
+        if (!c6) break;
+        aotSubtract(&v5, &v5, &v6);
+    }
+    aotPrint(&v5);
+    aotAssign(&v7, &BIGINT_SMALL(INT64_C(0)));
+    aotAssign(&v8, &BIGINT_SMALL(INT64_C(0)));
+    for (;;) {
+        bool c8;
+        bool c9 = aotCompare(&v7, &BIGINT_SMALL(INT64_C(3))) < 0;
+        c8 = c9;
+        if (!c8) break;
+        aotAssign(&v9, &v7);
+        for (;;) {
+            bool c10;
+            bool c11 = aotCompare(&v9, &BIGINT_SMALL(INT64_C(3))) < 0;
+            c10 = c11;
+            if (!c10) break;
+            aotAdd(&v8, &v8, &BIGINT_SMALL(INT64_C(1)));
+            aotAdd(&v9, &v9, &BIGINT_SMALL(INT64_C(1)));
+        }
+        aotAdd(&v7, &v7, &BIGINT_SMALL(INT64_C(1)));
+    }
+    aotPrint(&v8);
+}
+
+static void release(void) {
+    aotFree(&v0);
+    aotFree(&v1);
+    aotFree(&v2);
+    aotFree(&v3);
+    aotFree(&v4);
+    aotFree(&v5);
+    aotFree(&v6);
+    aotFree(&v7);
+    aotFree(&v8);
+    aotFree(&v9);
+    aotFree(&k1);
+    aotFree(&k3);
+    aotFree(&k11);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
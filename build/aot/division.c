@@ -0,0 +1,167 @@
+// Generated by cryton --emit-c from tests/division.py
+#include "aot.h"
+
+static const char source[] =
+    "a = 4\n"
+    "b = -11\n"
+    "\n"
+    "print(a * b)\n"
+    "print(a * b + 1 * 2)\n"
+    "print(2 + a * 3 - 10 / 4)\n"
+    "print(-a * -b)\n"
+    "\n"
+    "# Division rounds towards negative infinity, the remainder takes the divisor's sign\n"
+    "x = 7\n"
+    "y = 2\n"
+    "print(x / y)\n"
+    "print(x % y)\n"
+    "print(-x / y)\n"
+    "print(-x % y)\n"
+    "print(x / -y)\n"
+    "print(x % -y)\n"
+    "print(-x / -y)\n"
+    "print(-x % -y)\n"
+    "print(0 / 5)\n"
+    "print(123456789123456789123456789 / 987654321)\n"
+    "print(123456789123456789123456789 % 987654321)\n"
+    "\n"
+    "# EXPECT START\n"
+    "# -44\n"
+    "# -42\n"
+    "# 12\n"
+    "# -44\n"
+    "# 3\n"
+    "# 1\n"
+    "# -4\n"
+    "# 1\n"
+    "# -4\n"
+    "# -1\n"
+    "# 3\n"
+    "# -1\n"
+    "# 0\n"
+    "# 124999998985937499\n"
+    "# 173610\n"
+    "# EXPECT END\n";
+
+static BigInt v0 = AOT_UNDEFINED;    // a
+static BigInt v1 = AOT_UNDEFINED;    // b
+static BigInt v2 = AOT_UNDEFINED;    // x
+static BigInt v3 = AOT_UNDEFINED;    // y
+
+static void program(void) {
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(4)));
+    aotAssign(&v1, &BIGINT_SMALL(INT64_C(-11)));
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotMultiply(&t0, &v0, &v1);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotMultiply(&t0, &v0, &v1);
+        aotAdd(&t0, &t0, &BIGINT_SMALL(INT64_C(2)));
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        aotMultiply(&t0, &v0, &BIGINT_SMALL(INT64_C(3)));
+        aotAdd(&t1, &BIGINT_SMALL(INT64_C(2)), &t0);
+        aotSubtract(&t1, &t1, &BIGINT_SMALL(INT64_C(2)));
+        aotPrint(&t1);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        aotNegate(&t0, &v0);
+        aotNegate(&t1, &v1);
+        aotMultiply(&t0, &t0, &t1);
+        aotPrint(&t0);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+    aotAssign(&v2, &BIGINT_SMALL(INT64_C(7)));
+    aotAssign(&v3, &BIGINT_SMALL(INT64_C(2)));
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotDivide(&t0, &v2, &v3);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotModulo(&t0, &v2, &v3);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotNegate(&t0, &v2);
+        aotDivide(&t0, &t0, &v3);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotNegate(&t0, &v2);
+        aotModulo(&t0, &t0, &v3);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        aotNegate(&t0, &v3);
+        aotDivide(&t1, &v2, &t0);
+        aotPrint(&t1);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        aotNegate(&t0, &v3);
+        aotModulo(&t1, &v2, &t0);
+        aotPrint(&t1);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        aotNegate(&t0, &v2);
+        aotNegate(&t1, &v3);
+        aotDivide(&t0, &t0, &t1);
+        aotPrint(&t0);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        aotNegate(&t0, &v2);
+        aotNegate(&t1, &v3);
+        aotModulo(&t0, &t0, &t1);
+        aotPrint(&t0);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+    aotPrint(&BIGINT_SMALL(INT64_C(0)));
+    aotPrint(&BIGINT_SMALL(INT64_C(124999998985937499)));
+    aotPrint(&BIGINT_SMALL(INT64_C(173610)));
+}
+
+static void release(void) {
+    aotFree(&v0);
+    aotFree(&v1);
+    aotFree(&v2);
+    aotFree(&v3);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,127 @@
+// Generated by cryton --emit-c from tests/expressions.py
+#include "aot.h"
+
+static const char source[] =
+    "a = 10\n"
+    "b = 20\n"
+    "\n"
+    "# EXPECT: 20\n"
+    "print(a + a)\n"
+    "# EXPECT: 10\n"
+    "print(a + a - (b - a))\n"
+    "# EXPECT: 1\n"
+    "print(not not a + a - (b - a))\n"
+    "# EXPECT: 1\n"
+    "print(0 or a)\n"
+    "# EXPECT: 0\n"
+    "print(0 and a)\n"
+    "# EXPECT: 0\n"
+    "print(not (a and b))\n"
+    "# EXPECT: 1\n"
+    "print(not (a and b) or 1)\n";
+
+static BigInt v0 = AOT_UNDEFINED;    // a
+static BigInt v1 = AOT_UNDEFINED;    // b
+
+static void program(void) {
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(10)));
+    aotAssign(&v1, &BIGINT_SMALL(INT64_C(20)));
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotAdd(&t0, &v0, &v0);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        aotAdd(&t0, &v0, &v0);
+        aotSubtract(&t1, &v1, &v0);
+        aotSubtract(&t0, &t0, &t1);
+        aotPrint(&t0);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        BigInt t2 = BIGINT_ZERO;
+        BigInt t3 = BIGINT_ZERO;
+        aotAdd(&t0, &v0, &v0);
+        aotSubtract(&t1, &v1, &v0);
+        aotSubtract(&t0, &t0, &t1);
+        t2 = BIGINT_FROM_BOOL(!aotTruthy(&t0));
+        t3 = BIGINT_FROM_BOOL(!aotTruthy(&t2));
+        aotPrint(&t3);
+        bigint_free(&t0);
+        bigint_free(&t1);
+        bigint_free(&t2);
+        bigint_free(&t3);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        bool c0 = aotTruthy(&BIGINT_SMALL(INT64_C(0)));
+        bool c1 = c0;
+        if (!c1) {
+            bool c2 = aotTruthy(&v0);
+            c1 = c2;
+        }
+        t0 = BIGINT_FROM_BOOL(c1);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        bool c3 = aotTruthy(&BIGINT_SMALL(INT64_C(0)));
+        bool c4 = c3;
+        if (c4) {
+            bool c5 = aotTruthy(&v0);
+            c4 = c5;
+        }
+        t0 = BIGINT_FROM_BOOL(c4);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        bool c6 = aotTruthy(&v0);
+        bool c7 = c6;
+        if (c7) {
+            bool c8 = aotTruthy(&v1);
+            c7 = c8;
+        }
+        t0 = BIGINT_FROM_BOOL(c7);
+        t1 = BIGINT_FROM_BOOL(!aotTruthy(&t0));
+        aotPrint(&t1);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        bool c9 = aotTruthy(&v0);
+        bool c10 = c9;
+        if (c10) {
+            bool c11 = aotTruthy(&v1);
+            c10 = c11;
+        }
+        bool c12 = !c10;
+        bool c13 = c12;
+        if (!c13) {
+            bool c14 = aotTruthy(&BIGINT_SMALL(INT64_C(1)));
+            c13 = c14;
+        }
+        t0 = BIGINT_FROM_BOOL(c13);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+}
+
+static void release(void) {
+    aotFree(&v0);
+    aotFree(&v1);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
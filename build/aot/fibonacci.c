@@ -0,0 +1,69 @@
+// Generated by cryton --emit-c from tests/fibonacci.py
+#include "aot.h"
+
+static const char source[] =
+    "a = 0\n"
+    "b = 1\n"
+    "i = 0\n"
+    "n = 10\n"
+    "\n"
+    "while (i < n):\n"
+    "    print(a)\n"
+    "    tmp = b\n"
+    "    b = a + b\n"
+    "    a = tmp\n"
+    "    i = i + 1\n"
+    "\n"
+    "# EXPECT START\n"
+    "# 0\n"
+    "# 1\n"
+    "# 1\n"
+    "# 2\n"
+    "# 3\n"
+    "# 5\n"
+    "# 8\n"
+    "# 13\n"
+    "# 21\n"
+    "# 34\n"
+    "# EXPECT END";
+
+static BigInt v0 = AOT_UNDEFINED;    // a
+static BigInt v1 = AOT_UNDEFINED;    // b
+static BigInt v2 = AOT_UNDEFINED;    // i
+static BigInt v3 = AOT_UNDEFINED;    // n
+static BigInt v4 = AOT_UNDEFINED;    // tmp
+
+static void program(void) {
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(0)));
+    aotAssign(&v1, &BIGINT_SMALL(INT64_C(1)));
+    aotAssign(&v2, &BIGINT_SMALL(INT64_C(0)));
+    aotAssign(&v3, &BIGINT_SMALL(INT64_C(10)));
+    for (;;) {
+        bool c0;
+        bool c1 = aotCompare(&v2, &v3) < 0;
+        c0 = c1;
+        if (!c0) break;
+        aotPrint(&v0);
+        aotAssign(&v4, &v1);
+        {
+            BigInt t0 = BIGINT_ZERO;
+            aotAdd(&t0, &v0, &v1);
+            aotAssign(&v1, &t0);
+            bigint_free(&t0);
+        }
+        aotAssign(&v0, &v4);
+        aotAdd(&v2, &v2, &BIGINT_SMALL(INT64_C(1)));
+    }
+}
+
+static void release(void) {
+    aotFree(&v0);
+    aotFree(&v1);
+    aotFree(&v2);
+    aotFree(&v3);
+    aotFree(&v4);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,190 @@
+// Generated by cryton --emit-c from tests/hotLoop.py
+#include "aot.h"
+
+static const char source[] =
+    "# Loops of small-integer arithmetic, which the JIT runs natively\n"
+    "# ==============================\n"
+    "i = 0\n"
+    "total = 0\n"
+    "while i < 5000:\n"
+    "    if i > 2500 and not (i == 4000 or i == 4001):\n"
+    "        total = total + i * 3\n"
+    "    else:\n"
+    "        total = total - i\n"
+    "    i = i + 1\n"
+    "print(total)\n"
+    "# EXPECT: 24955496\n"
+    "# ==============================\n"
+    "\n"
+    "# Overflowing the inline range bails out to the interpreter, which carries\n"
+    "# on with big integers\n"
+    "# ==============================\n"
+    "x = 1\n"
+    "n = 0\n"
+    "while n < 100:\n"
+    "    x = x * 3\n"
+    "    n = n + 1\n"
+    "print(x)\n"
+    "# EXPECT: 515377520732011331036461129765621272702107522001\n"
+    "\n"
+    "y = 2305843009213693000\n"
+    "while y < 2305843009213694000:\n"
+    "    y = y + 7\n"
+    "print(y)\n"
+    "# EXPECT: 2305843009213694001\n"
+    "\n"
+    "z = 0\n"
+    "while z > -3000000000000000000:\n"
+    "    z = z - 1000000000000000000\n"
+    "print(-z)\n"
+    "# EXPECT: 3000000000000000000\n"
+    "# ==============================\n"
+    "\n"
+    "# Nested loops, and a variable first assigned inside the loop\n"
+    "# ==============================\n"
+    "a = 0\n"
+    "count = 0\n"
+    "while a < 60:\n"
+    "    b = 0\n"
+    "    while b < a:\n"
+    "        last = a - b\n"
+    "        count = count + 1\n"
+    "        b = b + 1\n"
+    "    a = a + 1\n"
+    "print(count)\n"
+    "print(last)\n"
+    "# EXPECT: 1770\n"
+    "# EXPECT: 1\n"
+    "# ==============================\n";
+
+static BigInt v0 = AOT_UNDEFINED;    // i
+static BigInt v1 = AOT_UNDEFINED;    // total
+static BigInt v2 = AOT_UNDEFINED;    // x
+static BigInt v3 = AOT_UNDEFINED;    // n
+static BigInt v4 = AOT_UNDEFINED;    // y
+static BigInt v5 = AOT_UNDEFINED;    // z
+static BigInt v6 = AOT_UNDEFINED;    // a
+static BigInt v7 = AOT_UNDEFINED;    // count
+static BigInt v8 = AOT_UNDEFINED;    // b
+static BigInt v9 = AOT_UNDEFINED;    // last
+static BigInt k9;
+static BigInt k14;
+
+static void program(void) {
+    k9 = bigint_from_str("2305843009213694000", 19);
+    k14 = bigint_from_str("-3000000000000000000", 20);
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(0)));
+    aotAssign(&v1, &BIGINT_SMALL(INT64_C(0)));
+    for (;;) {
+        bool c0;
+        bool c1 = aotCompare(&v0, &BIGINT_SMALL(INT64_C(5000))) < 0;
+        c0 = c1;
+        if (!c0) break;
+        bool c2;
+        bool c3 = aotCompare(&v0, &BIGINT_SMALL(INT64_C(2500))) > 0;
+        bool c4 = c3;
+        if (c4) {
+            bool c5 = aotEqual(&v0, &BIGINT_SMALL(INT64_C(4000)));
+            bool c6 = c5;
+            if (!c6) {
+                bool c7 = aotEqual(&v0, &BIGINT_SMALL(INT64_C(4001)));
+                c6 = c7;
+            }
+            bool c8 = !c6;
+            c4 = c8;
+        }
+        c2 = c4;
+        if (c2) {
+            {
+                BigInt t0 = BIGINT_ZERO;
+                aotMultiply(&t0, &v0, &BIGINT_SMALL(INT64_C(3)));
+                aotAdd(&v1, &v1, &t0);
+                bigint_free(&t0);
+            }
+        } else {
+            aotSubtract(&v1, &v1, &v0);
+        }
+        aotAdd(&v0, &v0, &BIGINT_SMALL(INT64_C(1)));
+    }
+    aotPrint(&v1);
+    aotAssign(&v2, &BIGINT_SMALL(INT64_C(1)));
+    aotAssign(&v3, &BIGINT_SMALL(INT64_C(0)));
+    for (;;) {
+        bool c9;
+        bool c10 = aotCompare(&v3, &BIGINT_SMALL(INT64_C(100))) < 0;
+        c9 = c10;
+        if (!c9) break;
+        aotMultiply(&v2, &v2, &BIGINT_SMALL(INT64_C(3)));
+        aotAdd(&v3, &v3, &BIGINT_SMALL(INT64_C(1)));
+    }
+    aotPrint(&v2);
+    aotAssign(&v4, &BIGINT_SMALL(INT64_C(2305843009213693000)));
+    for (;;) {
+        bool c11;
+        bool c12 = aotCompare(&v4, &k9) < 0;
+        c11 = c12;
+        if (!c11) break;
+        aotAdd(&v4, &v4, &BIGINT_SMALL(INT64_C(7)));
+    }
+    aotPrint(&v4);
+    aotAssign(&v5, &BIGINT_SMALL(INT64_C(0)));
+    for (;;) {
+        bool c13;
+        bool c14 = aotCompare(&v5, &k14) > 0;
+        c13 = c14;
+        if (!c13) break;
+        aotSubtract(&v5, &v5, &BIGINT_SMALL(INT64_C(1000000000000000000)));
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotNegate(&t0, &v5);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    aotAssign(&v6, &BIGINT_SMALL(INT64_C(0)));
+    aotAssign(&v7, &BIGINT_SMALL(INT64_C(0)));
+    for (;;) {
+        bool c15;
+        bool c16 = aotCompare(&v6, &BIGINT_SMALL(INT64_C(60))) < 0;
+        c15 = c16;
+        if (!c15) break;
+        aotAssign(&v8, &BIGINT_SMALL(INT64_C(0)));
+        for (;;) {
+            bool c17;
+            bool c18 = aotCompare(&v8, &v6) < 0;
+            c17 = c18;
+            if (!c17) break;
+            {
+                BigInt t0 = BIGINT_ZERO;
+                aotSubtract(&t0, &v6, &v8);
+                aotAssign(&v9, &t0);
+                bigint_free(&t0);
+            }
+            aotAdd(&v7, &v7, &BIGINT_SMALL(INT64_C(1)));
+            aotAdd(&v8, &v8, &BIGINT_SMALL(INT64_C(1)));
+        }
+        aotAdd(&v6, &v6, &BIGINT_SMALL(INT64_C(1)));
+    }
+    aotPrint(&v7);
+    aotDefined(&v9, "last");
+    aotPrint(&v9);
+}
+
+static void release(void) {
+    aotFree(&v0);
+    aotFree(&v1);
+    aotFree(&v2);
+    aotFree(&v3);
+    aotFree(&v4);
+    aotFree(&v5);
+    aotFree(&v6);
+    aotFree(&v7);
+    aotFree(&v8);
+    aotFree(&v9);
+    aotFree(&k9);
+    aotFree(&k14);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
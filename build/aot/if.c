@@ -0,0 +1,165 @@
+// Generated by cryton --emit-c from tests/if.py
+#include "aot.h"
+
+static const char source[] =
+    "a = 0\n"
+    "b = 1\n"
+    "c = 5\n"
+    "\n"
+    "# If branch\n"
+    "# ==============================\n"
+    "# EXPECT: 100\n"
+    "if (b):\n"
+    "    print(100)\n"
+    "else:\n"
+    "    print(101)\n"
+    "# ==============================\n"
+    "\n"
+    "# Else branch\n"
+    "# ==============================\n"
+    "# EXPECT: 201\n"
+    "if (a):\n"
+    "    print(200)\n"
+    "else:\n"
+    "    print(201)\n"
+    "# ==============================\n"
+    "\n"
+    "# Elif branch\n"
+    "# ==============================\n"
+    "if (a):\n"
+    "    print(300)\n"
+    "elif(b):\n"
+    "    # EXPECT: 301\n"
+    "    print(301)\n"
+    "else:\n"
+    "    print(302)\n"
+    "# ==============================\n"
+    "\n"
+    "# Shouldn't print anything\n"
+    "# ==============================\n"
+    "if (b - b):\n"
+    "    print(400)\n"
+    "# ==============================\n"
+    "\n"
+    "# Nested if statements\n"
+    "# ==============================\n"
+    "if (c):\n"
+    "    if (a + b):\n"
+    "        if (a):\n"
+    "            print(500)\n"
+    "        else:\n"
+    "            # EXPECT: 501\n"
+    "            print(501)\n"
+    "    # EXPECT: 503\n"
+    "    print(503)\n"
+    "# ==============================\n"
+    "\n"
+    "# Multiple statements inside if\n"
+    "# ==============================\n"
+    "if (c):\n"
+    "    # EXPECT: 600\n"
+    "    print(600)\n"
+    "    if (a):\n"
+    "        print(601)\n"
+    "    # EXPECT: 602\n"
+    "    print(602)\n"
+    "# ==============================\n";
+
+static BigInt v0 = AOT_UNDEFINED;    // a
+static BigInt v1 = AOT_UNDEFINED;    // b
+static BigInt v2 = AOT_UNDEFINED;    // c
+
+static void program(void) {
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(0)));
+    aotAssign(&v1, &BIGINT_SMALL(INT64_C(1)));
+    aotAssign(&v2, &BIGINT_SMALL(INT64_C(5)));
+    bool c0;
+    bool c1 = aotTruthy(&v1);
+    c0 = c1;
+    if (c0) {
+        aotPrint(&BIGINT_SMALL(INT64_C(100)));
+    } else {
+        aotPrint(&BIGINT_SMALL(INT64_C(101)));
+    }
+    bool c2;
+    bool c3 = aotTruthy(&v0);
+    c2 = c3;
+    if (c2) {
+        aotPrint(&BIGINT_SMALL(INT64_C(200)));
+    } else {
+        aotPrint(&BIGINT_SMALL(INT64_C(201)));
+    }
+    bool c4;
+    bool c5 = aotTruthy(&v0);
+    c4 = c5;
+    if (c4) {
+        aotPrint(&BIGINT_SMALL(INT64_C(300)));
+    } else {
+        bool c6;
+        bool c7 = aotTruthy(&v1);
+        c6 = c7;
+        if (c6) {
+            aotPrint(&BIGINT_SMALL(INT64_C(301)));
+        } else {
+            aotPrint(&BIGINT_SMALL(INT64_C(302)));
+        }
+    }
+    bool c8;
+    {
+        BigInt t0 = BIGINT_ZERO;
+        aotSubtract(&t0, &v1, &v1);
+        bool c9 = aotTruthy(&t0);
+        c8 = c9;
+        bigint_free(&t0);
+    }
+    if (c8) {
+        aotPrint(&BIGINT_SMALL(INT64_C(400)));
+    }
+    bool c10;
+    bool c11 = aotTruthy(&v2);
+    c10 = c11;
+    if (c10) {
+        bool c12;
+        {
+            BigInt t0 = BIGINT_ZERO;
+            aotAdd(&t0, &v0, &v1);
+            bool c13 = aotTruthy(&t0);
+            c12 = c13;
+            bigint_free(&t0);
+        }
+        if (c12) {
+            bool c14;
+            bool c15 = aotTruthy(&v0);
+            c14 = c15;
+            if (c14) {
+                aotPrint(&BIGINT_SMALL(INT64_C(500)));
+            } else {
+                aotPrint(&BIGINT_SMALL(INT64_C(501)));
+            }
+        }
+        aotPrint(&BIGINT_SMALL(INT64_C(503)));
+    }
+    bool c16;
+    bool c17 = aotTruthy(&v2);
+    c16 = c17;
+    if (c16) {
+        aotPrint(&BIGINT_SMALL(INT64_C(600)));
+        bool c18;
+        bool c19 = aotTruthy(&v0);
+        c18 = c19;
+        if (c18) {
+            aotPrint(&BIGINT_SMALL(INT64_C(601)));
+        }
+        aotPrint(&BIGINT_SMALL(INT64_C(602)));
+    }
+}
+
+static void release(void) {
+    aotFree(&v0);
+    aotFree(&v1);
+    aotFree(&v2);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
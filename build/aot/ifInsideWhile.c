@@ -0,0 +1,77 @@
+// Generated by cryton --emit-c from tests/ifInsideWhile.py
+#include "aot.h"
+
+static const char source[] =
+    "a = 1\n"
+    "b = 2\n"
+    "c = 3\n"
+    "\n"
+    "if a == 1:\n"
+    "    d = 99\n"
+    "\n"
+    "while(a < 100):\n"
+    "    a = a + 1\n"
+    "    \n"
+    "    if a == c:\n"
+    "        d = 999999\n"
+    "    if a < 7:\n"
+    "        c = c + c\n"
+    "\n"
+    "\n"
+    "# EXPECT: 100\n"
+    "print a\n"
+    "# EXPECT: 96\n"
+    "print c\n"
+    "# EXPECT: 999999\n"
+    "print d";
+
+static BigInt v0 = AOT_UNDEFINED;    // a
+static BigInt v1 = AOT_UNDEFINED;    // b
+static BigInt v2 = AOT_UNDEFINED;    // c
+static BigInt v3 = AOT_UNDEFINED;    // d
+
+static void program(void) {
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(1)));
+    aotAssign(&v1, &BIGINT_SMALL(INT64_C(2)));
+    aotAssign(&v2, &BIGINT_SMALL(INT64_C(3)));
+    bool c0;
+    bool c1 = aotEqual(&v0, &BIGINT_SMALL(INT64_C(1)));
+    c0 = c1;
+    if (c0) {
+        aotAssign(&v3, &BIGINT_SMALL(INT64_C(99)));
+    }
+    for (;;) {
+        bool c2;
+        bool c3 = aotCompare(&v0, &BIGINT_SMALL(INT64_C(100))) < 0;
+        c2 = c3;
+        if (!c2) break;
+        aotAdd(&v0, &v0, &BIGINT_SMALL(INT64_C(1)));
+        bool c4;
+        bool c5 = aotEqual(&v0, &v2);
+        c4 = c5;
+        if (c4) {
+            aotAssign(&v3, &BIGINT_SMALL(INT64_C(999999)));
+        }
+        bool c6;
+        bool c7 = aotCompare(&v0, &BIGINT_SMALL(INT64_C(7))) < 0;
+        c6 = c7;
+        if (c6) {
+            aotAdd(&v2, &v2, &v2);
+        }
+    }
+    aotPrint(&v0);
+    aotPrint(&v2);
+    aotDefined(&v3, "d");
+    aotPrint(&v3);
+}
+
+static void release(void) {
+    aotFree(&v0);
+    aotFree(&v1);
+    aotFree(&v2);
+    aotFree(&v3);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,60 @@
+// Generated by cryton --emit-c from tests/multipleElif.py
+#include "aot.h"
+
+static const char source[] =
+    "a = 1\n"
+    "b = 2\n"
+    "c = 3\n"
+    "\n"
+    "\n"
+    "if a == 2:\n"
+    "    print(2)\n"
+    "elif a == 3:\n"
+    "    print(3)\n"
+    "elif a == 4:\n"
+    "    print(4)\n"
+    "else:\n"
+    "    # EXPECT: 99\n"
+    "    print(99)";
+
+static BigInt v0 = AOT_UNDEFINED;    // a
+static BigInt v1 = AOT_UNDEFINED;    // b
+static BigInt v2 = AOT_UNDEFINED;    // c
+
+static void program(void) {
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(1)));
+    aotAssign(&v1, &BIGINT_SMALL(INT64_C(2)));
+    aotAssign(&v2, &BIGINT_SMALL(INT64_C(3)));
+    bool c0;
+    bool c1 = aotEqual(&v0, &BIGINT_SMALL(INT64_C(2)));
+    c0 = c1;
+    if (c0) {
+        aotPrint(&BIGINT_SMALL(INT64_C(2)));
+    } else {
+        bool c2;
+        bool c3 = aotEqual(&v0, &BIGINT_SMALL(INT64_C(3)));
+        c2 = c3;
+        if (c2) {
+            aotPrint(&BIGINT_SMALL(INT64_C(3)));
+        } else {
+            bool c4;
+            bool c5 = aotEqual(&v0, &BIGINT_SMALL(INT64_C(4)));
+            c4 = c5;
+            if (c4) {
+                aotPrint(&BIGINT_SMALL(INT64_C(4)));
+            } else {
+                aotPrint(&BIGINT_SMALL(INT64_C(99)));
+            }
+        }
+    }
+}
+
+static void release(void) {
+    aotFree(&v0);
+    aotFree(&v1);
+    aotFree(&v2);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,75 @@
+// Generated by cryton --emit-c from tests/multiplication.py
+#include "aot.h"
+
+static const char source[] =
+    "a = 4\n"
+    "b = -11\n"
+    "result = 0\n"
+    "\n"
+    "i = b\n"
+    "if b < 0:\n"
+    "    i = 0 - b\n"
+    "\n"
+    "while i > 0:\n"
+    "    result = result + a\n"
+    "    i = i - 1\n"
+    "\n"
+    "if b < 0:\n"
+    "    result = 0 - result\n"
+    "\n"
+    "# EXPECT: -44\n"
+    "print(result)";
+
+static BigInt v0 = AOT_UNDEFINED;    // a
+static BigInt v1 = AOT_UNDEFINED;    // b
+static BigInt v2 = AOT_UNDEFINED;    // result
+static BigInt v3 = AOT_UNDEFINED;    // i
+
+static void program(void) {
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(4)));
+    aotAssign(&v1, &BIGINT_SMALL(INT64_C(-11)));
+    aotAssign(&v2, &BIGINT_SMALL(INT64_C(0)));
+    aotAssign(&v3, &v1);
+    bool c0;
+    bool c1 = aotCompare(&v1, &BIGINT_SMALL(INT64_C(0))) < 0;
+    c0 = c1;
+    if (c0) {
+        {
+            BigInt t0 = BIGINT_ZERO;
+            aotSubtract(&t0, &BIGINT_SMALL(INT64_C(0)), &v1);
+            aotAssign(&v3, &t0);
+            bigint_free(&t0);
+        }
+    }
+    for (;;) {
+        bool c2;
+        bool c3 = aotCompare(&v3, &BIGINT_SMALL(INT64_C(0))) > 0;
+        c2 = c3;
+        if (!c2) break;
+        aotAdd(&v2, &v2, &v0);
+        aotSubtract(&v3, &v3, &BIGINT_SMALL(INT64_C(1)));
+    }
+    bool c4;
+    bool c5 = aotCompare(&v1, &BIGINT_SMALL(INT64_C(0))) < 0;
+    c4 = c5;
+    if (c4) {
+        {
+            BigInt t0 = BIGINT_ZERO;
+            aotSubtract(&t0, &BIGINT_SMALL(INT64_C(0)), &v2);
+            aotAssign(&v2, &t0);
+            bigint_free(&t0);
+        }
+    }
+    aotPrint(&v2);
+}
+
+static void release(void) {
+    aotFree(&v0);
+    aotFree(&v1);
+    aotFree(&v2);
+    aotFree(&v3);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,52 @@
+// Generated by cryton --emit-c from tests/noTrailingNewline.py
+#include "aot.h"
+
+static const char source[] =
+    "# The file ends inside a block, with no newline after its last line\n"
+    "i = 0\n"
+    "while i < 3:\n"
+    "    print(i)\n"
+    "    i = i + 1\n"
+    "\n"
+    "# EXPECT START\n"
+    "# 0\n"
+    "# 1\n"
+    "# 2\n"
+    "# 30\n"
+    "# EXPECT END\n"
+    "\n"
+    "if i == 3:\n"
+    "    print(i * 10)";
+
+static BigInt v0 = AOT_UNDEFINED;    // i
+
+static void program(void) {
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(0)));
+    for (;;) {
+        bool c0;
+        bool c1 = aotCompare(&v0, &BIGINT_SMALL(INT64_C(3))) < 0;
+        c0 = c1;
+        if (!c0) break;
+        aotPrint(&v0);
+        aotAdd(&v0, &v0, &BIGINT_SMALL(INT64_C(1)));
+    }
+    bool c2;
+    bool c3 = aotEqual(&v0, &BIGINT_SMALL(INT64_C(3)));
+    c2 = c3;
+    if (c2) {
+        {
+            BigInt t0 = BIGINT_ZERO;
+            aotMultiply(&t0, &v0, &BIGINT_SMALL(INT64_C(10)));
+            aotPrint(&t0);
+            bigint_free(&t0);
+        }
+    }
+}
+
+static void release(void) {
+    aotFree(&v0);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
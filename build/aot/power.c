@@ -0,0 +1,64 @@
+// Generated by cryton --emit-c from tests/power.py
+#include "aot.h"
+
+static const char source[] =
+    "print(2 ** 10)\n"
+    "print(2 ** 3 ** 2)\n"
+    "print(-2 ** 2)\n"
+    "print((-2) ** 3)\n"
+    "print(10 ** 0)\n"
+    "print(0 ** 0)\n"
+    "print(2 ** 4096 % 100000000000000000000)\n"
+    "\n"
+    "# EXPECT: 1024\n"
+    "# EXPECT: 512\n"
+    "# EXPECT: -4\n"
+    "# EXPECT: -8\n"
+    "# EXPECT: 1\n"
+    "# EXPECT: 1\n"
+    "# EXPECT: 4708340403154190336\n"
+    "\n"
+    "# Three-argument modular power, odd and even moduli\n"
+    "print(3 ** 1000000000000000000000000000000 % 1000000007)\n"
+    "print(7 ** 100000000000000000000 % 18446744073709551616)\n"
+    "print(12345678901234567890 ** 65537 % 170141183460469231731687303715884105727)\n"
+    "print((-5) ** 77 % -1000)\n"
+    "print(5 ** 3 % 1)\n"
+    "\n"
+    "# EXPECT: 965115194\n"
+    "# EXPECT: 7795500593962811393\n"
+    "# EXPECT: 127352203508635771842305703701533661349\n"
+    "# EXPECT: -125\n"
+    "# EXPECT: 0\n";
+
+static BigInt k24;
+static BigInt k26;
+static BigInt k27;
+
+static void program(void) {
+    k24 = bigint_from_str("4708340403154190336", 19);
+    k26 = bigint_from_str("7795500593962811393", 19);
+    k27 = bigint_from_str("127352203508635771842305703701533661349", 39);
+    aotPrint(&BIGINT_SMALL(INT64_C(1024)));
+    aotPrint(&BIGINT_SMALL(INT64_C(512)));
+    aotPrint(&BIGINT_SMALL(INT64_C(-4)));
+    aotPrint(&BIGINT_SMALL(INT64_C(-8)));
+    aotPrint(&BIGINT_SMALL(INT64_C(1)));
+    aotPrint(&BIGINT_SMALL(INT64_C(1)));
+    aotPrint(&k24);
+    aotPrint(&BIGINT_SMALL(INT64_C(965115194)));
+    aotPrint(&k26);
+    aotPrint(&k27);
+    aotPrint(&BIGINT_SMALL(INT64_C(-125)));
+    aotPrint(&BIGINT_SMALL(INT64_C(0)));
+}
+
+static void release(void) {
+    aotFree(&k24);
+    aotFree(&k26);
+    aotFree(&k27);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,211 @@
+// Generated by cryton --emit-c from tests/shortCircuit.py
+#include "aot.h"
+
+static const char source[] =
+    "x = 0\n"
+    "y = 1\n"
+    "\n"
+    "# The right operand is skipped once the left one decides\n"
+    "# ==============================\n"
+    "if x and 1 / x:\n"
+    "    print(1)\n"
+    "else:\n"
+    "    print(2)\n"
+    "# EXPECT: 2\n"
+    "\n"
+    "print(y or undefined)\n"
+    "print(x and undefined)\n"
+    "print(not (x and undefined))\n"
+    "# EXPECT: 1\n"
+    "# EXPECT: 0\n"
+    "# EXPECT: 1\n"
+    "# ==============================\n"
+    "\n"
+    "# Both operands are used when needed\n"
+    "# ==============================\n"
+    "while x < 3 and y:\n"
+    "    x = x + 1\n"
+    "print(x)\n"
+    "print(x > 2 or y > 2)\n"
+    "print(x > 5 or y > 2)\n"
+    "# EXPECT: 3\n"
+    "# EXPECT: 1\n"
+    "# EXPECT: 0\n"
+    "# ==============================\n"
+    "\n"
+    "# Membership tests stop early too\n"
+    "# ==============================\n"
+    "cat T(a):\n"
+    "    obj:\n"
+    "        a 2\n"
+    "    hom:\n"
+    "        a -> 2\n"
+    "\n"
+    "t = T(1)\n"
+    "print(1 -> 2 in t and 2 in t)\n"
+    "print(3 in t and 1 -> 2 in t)\n"
+    "print(3 in t or 1 -> 2 in t)\n"
+    "# EXPECT: 1\n"
+    "# EXPECT: 0\n"
+    "# EXPECT: 1\n"
+    "# ==============================\n";
+
+static BigInt v0 = AOT_UNDEFINED;    // x
+static BigInt v1 = AOT_UNDEFINED;    // y
+static BigInt v2 = AOT_UNDEFINED;    // undefined
+
+static void program(void) {
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(0)));
+    aotAssign(&v1, &BIGINT_SMALL(INT64_C(1)));
+    bool c0;
+    {
+        BigInt t0 = BIGINT_ZERO;
+        bool c1 = aotTruthy(&v0);
+        bool c2 = c1;
+        if (c2) {
+            aotDivide(&t0, &BIGINT_SMALL(INT64_C(1)), &v0);
+            bool c3 = aotTruthy(&t0);
+            c2 = c3;
+        }
+        c0 = c2;
+        bigint_free(&t0);
+    }
+    if (c0) {
+        aotPrint(&BIGINT_SMALL(INT64_C(1)));
+    } else {
+        aotPrint(&BIGINT_SMALL(INT64_C(2)));
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        bool c4 = aotTruthy(&v1);
+        bool c5 = c4;
+        if (!c5) {
+            aotDefined(&v2, "undefined");
+            bool c6 = aotTruthy(&v2);
+            c5 = c6;
+        }
+        t0 = BIGINT_FROM_BOOL(c5);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        bool c7 = aotTruthy(&v0);
+        bool c8 = c7;
+        if (c8) {
+            aotDefined(&v2, "undefined");
+            bool c9 = aotTruthy(&v2);
+            c8 = c9;
+        }
+        t0 = BIGINT_FROM_BOOL(c8);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        BigInt t1 = BIGINT_ZERO;
+        bool c10 = aotTruthy(&v0);
+        bool c11 = c10;
+        if (c11) {
+            aotDefined(&v2, "undefined");
+            bool c12 = aotTruthy(&v2);
+            c11 = c12;
+        }
+        t0 = BIGINT_FROM_BOOL(c11);
+        t1 = BIGINT_FROM_BOOL(!aotTruthy(&t0));
+        aotPrint(&t1);
+        bigint_free(&t0);
+        bigint_free(&t1);
+    }
+    for (;;) {
+        bool c13;
+        bool c14 = aotCompare(&v0, &BIGINT_SMALL(INT64_C(3))) < 0;
+        bool c15 = c14;
+        if (c15) {
+            bool c16 = aotTruthy(&v1);
+            c15 = c16;
+        }
+        c13 = c15;
+        if (!c13) break;
+        aotAdd(&v0, &v0, &BIGINT_SMALL(INT64_C(1)));
+    }
+    aotPrint(&v0);
+    {
+        BigInt t0 = BIGINT_ZERO;
+        bool c17 = aotCompare(&v0, &BIGINT_SMALL(INT64_C(2))) > 0;
+        bool c18 = c17;
+        if (!c18) {
+            bool c19 = aotCompare(&v1, &BIGINT_SMALL(INT64_C(2))) > 0;
+            c18 = c19;
+        }
+        t0 = BIGINT_FROM_BOOL(c18);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        bool c20 = aotCompare(&v0, &BIGINT_SMALL(INT64_C(5))) > 0;
+        bool c21 = c20;
+        if (!c21) {
+            bool c22 = aotCompare(&v1, &BIGINT_SMALL(INT64_C(2))) > 0;
+            c21 = c22;
+        }
+        t0 = BIGINT_FROM_BOOL(c21);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    aotDefineTemplate(0);
+    aotInitCategory(1, 4);
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g23 = aotCategory(2);
+        bool c24 = aotInMorphism(g23, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(1))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(2))));
+        bool c25 = c24;
+        if (c25) {
+            RuntimeCategory* g26 = aotCategory(3);
+            bool c27 = aotInObject(g26, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(2))));
+            c25 = c27;
+        }
+        t0 = BIGINT_FROM_BOOL(c25);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g28 = aotCategory(4);
+        bool c29 = aotInObject(g28, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(3))));
+        bool c30 = c29;
+        if (c30) {
+            RuntimeCategory* g31 = aotCategory(5);
+            bool c32 = aotInMorphism(g31, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(1))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(2))));
+            c30 = c32;
+        }
+        t0 = BIGINT_FROM_BOOL(c30);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+    {
+        BigInt t0 = BIGINT_ZERO;
+        RuntimeCategory* g33 = aotCategory(6);
+        bool c34 = aotInObject(g33, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(3))));
+        bool c35 = c34;
+        if (!c35) {
+            RuntimeCategory* g36 = aotCategory(7);
+            bool c37 = aotInMorphism(g36, AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(1))), AOT_NUMBER_VALUE(&BIGINT_SMALL(INT64_C(2))));
+            c35 = c37;
+        }
+        t0 = BIGINT_FROM_BOOL(c35);
+        aotPrint(&t0);
+        bigint_free(&t0);
+    }
+}
+
+static void release(void) {
+    aotFree(&v0);
+    aotFree(&v1);
+    aotFree(&v2);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
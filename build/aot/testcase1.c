@@ -0,0 +1,58 @@
+// Generated by cryton --emit-c from tests/testcase1.py
+#include "aot.h"
+
+static const char source[] =
+    "\n"
+    "\n"
+    "\n"
+    "#Labas\n"
+    "\n"
+    "a = 1\n"
+    "b = 2\n"
+    "c = 3\n"
+    "\n"
+    "if a == 1:\n"
+    "    d = 99\n"
+    "\n"
+    "while(a < 100):\n"
+    "    a = a + 1\n"
+    "\n"
+    "\n"
+    "# EXPECT: 100\n"
+    "print a";
+
+static BigInt v0 = AOT_UNDEFINED;    // a
+static BigInt v1 = AOT_UNDEFINED;    // b
+static BigInt v2 = AOT_UNDEFINED;    // c
+static BigInt v3 = AOT_UNDEFINED;    // d
+
+static void program(void) {
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(1)));
+    aotAssign(&v1, &BIGINT_SMALL(INT64_C(2)));
+    aotAssign(&v2, &BIGINT_SMALL(INT64_C(3)));
+    bool c0;
+    bool c1 = aotEqual(&v0, &BIGINT_SMALL(INT64_C(1)));
+    c0 = c1;
+    if (c0) {
+        aotAssign(&v3, &BIGINT_SMALL(INT64_C(99)));
+    }
+    for (;;) {
+        bool c2;
+        bool c3 = aotCompare(&v0, &BIGINT_SMALL(INT64_C(100))) < 0;
+        c2 = c3;
+        if (!c2) break;
+        aotAdd(&v0, &v0, &BIGINT_SMALL(INT64_C(1)));
+    }
+    aotPrint(&v0);
+}
+
+static void release(void) {
+    aotFree(&v0);
+    aotFree(&v1);
+    aotFree(&v2);
+    aotFree(&v3);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
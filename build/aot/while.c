@@ -0,0 +1,58 @@
+// Generated by cryton --emit-c from tests/while.py
+#include "aot.h"
+
+static const char source[] =
+    "a = 0\n"
+    "b = 20\n"
+    "\n"
+    "# While works correctly\n"
+    "# ==============================\n"
+    "while (a < 3):\n"
+    "    a = a + 1\n"
+    "    print(a)\n"
+    "\n"
+    "# EXPECT START\n"
+    "# 1\n"
+    "# 2\n"
+    "# 3\n"
+    "# EXPECT END\n"
+    "# ==============================\n"
+    "\n"
+    "\n"
+    "# Shouldn't print anything\n"
+    "# ==============================\n"
+    "while (a < 3):\n"
+    "    print(200)\n"
+    "# ==============================\n";
+
+static BigInt v0 = AOT_UNDEFINED;    // a
+static BigInt v1 = AOT_UNDEFINED;    // b
+
+static void program(void) {
+    aotAssign(&v0, &BIGINT_SMALL(INT64_C(0)));
+    aotAssign(&v1, &BIGINT_SMALL(INT64_C(20)));
+    for (;;) {
+        bool c0;
+        bool c1 = aotCompare(&v0, &BIGINT_SMALL(INT64_C(3))) < 0;
+        c0 = c1;
+        if (!c0) break;
+        aotAdd(&v0, &v0, &BIGINT_SMALL(INT64_C(1)));
+        aotPrint(&v0);
+    }
+    for (;;) {
+        bool c2;
+        bool c3 = aotCompare(&v0, &BIGINT_SMALL(INT64_C(3))) < 0;
+        c2 = c3;
+        if (!c2) break;
+        aotPrint(&BIGINT_SMALL(INT64_C(200)));
+    }
+}
+
+static void release(void) {
+    aotFree(&v0);
+    aotFree(&v1);
+}
+
+int main(void) {
+    return aotMain(source, sizeof(source) - 1, program, release);
+}
@@ -0,0 +1,172 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "chunk.h"
+#include "interpreter.h"
+#include "object.h"
+
+#define GROW_CAPACITY(capacity) \
+    ((capacity) < 8 ? 8 : (capacity) * 2)
+
+void initChunk(Chunk* chunk) {
+    chunk->count = 0;
+    chunk->capacity = 0;
+    chunk->code = NULL;
+
+    chunk->constantCount = 0;
+    chunk->constantCapacity = 0;
+    chunk->constants = NULL;
+
+    chunk->nodeCount = 0;
+    chunk->nodeCapacity = 0;
+    chunk->nodes = NULL;
+
+    chunk->maxStack = 0;
+}
+
+void freeChunk(Chunk* chunk) {
+    for (int i = 0; i < chunk->constantCount; ++i) {
+        freeValue(&chunk->constants[i]);
+    }
+
+    free(chunk->code);
+    free(chunk->constants);
+    free(chunk->nodes);
+    initChunk(chunk);
+}
+
+void writeChunk(Chunk* chunk, uint8_t byte) {
+    if (chunk->count + 1 > chunk->capacity) {
+        chunk->capacity = GROW_CAPACITY(chunk->capacity);
+        chunk->code = realloc(chunk->code, chunk->capacity);
+    }
+
+    chunk->code[chunk->count++] = byte;
+}
+
+// The chunk takes over the value's reference
+int addConstant(Chunk* chunk, Value value) {
+    if (chunk->constantCount + 1 > chunk->constantCapacity) {
+        chunk->constantCapacity = GROW_CAPACITY(chunk->constantCapacity);
+        chunk->constants = realloc(chunk->constants, sizeof(Value) * chunk->constantCapacity);
+    }
+
+    chunk->constants[chunk->constantCount] = value;
+    return chunk->constantCount++;
+}
+
+int addNode(Chunk* chunk, void* node) {
+    if (chunk->nodeCount + 1 > chunk->nodeCapacity) {
+        chunk->nodeCapacity = GROW_CAPACITY(chunk->nodeCapacity);
+        chunk->nodes = realloc(chunk->nodes, sizeof(void*) * chunk->nodeCapacity);
+    }
+
+    chunk->nodes[chunk->nodeCount] = node;
+    return chunk->nodeCount++;
+}
+
+static const char* opNames[] = {
+#define OPCODE_NAME(name) "OP_" #name,
+    OPCODES(OPCODE_NAME)
+#undef OPCODE_NAME
+};
+
+static int readWord(Chunk* chunk, int offset) {
+    int32_t word;
+    memcpy(&word, &chunk->code[offset], sizeof(word));
+    return word;
+}
+
+static void printDirect(Chunk* chunk, int offset) {
+    int index = readWord(chunk, offset + 1);
+
+    if (chunk->code[offset] == OPERAND_GLOBAL) {
+        printf("'%s'", interp.globals.names[index]->chars);
+    } else {
+        bigint_print(&chunk->constants[index].number);
+    }
+}
+
+static int disassembleInstruction(Chunk* chunk, int offset) {
+    uint8_t op = chunk->code[offset];
+    printf("%04d %-18s", offset, opNames[op]);
+
+    switch (op) {
+        case OP_CONSTANT: {
+            int index = readWord(chunk, offset + 1);
+            printf("%4d '", index);
+            bigint_print(&chunk->constants[index].number);
+            printf("'\n");
+            return offset + 5;
+        }
+
+        case OP_GET_GLOBAL:
+        case OP_SET_GLOBAL: {
+            int slot = readWord(chunk, offset + 1);
+            printf("%4d '%s'\n", slot, interp.globals.names[slot]->chars);
+            return offset + 5;
+        }
+
+        case OP_GET_CATEGORY: {
+            int index = readWord(chunk, offset + 1);
+            printf("%4d '%s'\n", index, ((ExprIn*)chunk->nodes[index])->name->name->chars);
+            return offset + 5;
+        }
+
+        case OP_JUMP:
+        case OP_JUMP_IF_FALSE:
+        case OP_JUMP_IF_TRUE:
+            printf("%4d -> %d\n", offset, offset + 5 + readWord(chunk, offset + 1));
+            return offset + 5;
+
+        case OP_JIT_LOOP:
+            printf("%4d -> %d\n", readWord(chunk, offset + 1), offset + 9 + readWord(chunk, offset + 5));
+            return offset + 9;
+
+        case OP_LOOP:
+            printf("%4d -> %d\n", offset, offset + 5 - readWord(chunk, offset + 1));
+            return offset + 5;
+
+        case OP_INCREMENT:
+        case OP_DECREMENT: {
+            int slot = readWord(chunk, offset + 1);
+            printf("%4d '%s' %c ", slot, interp.globals.names[slot]->chars,
+                   op == OP_INCREMENT ? '+' : '-');
+            printDirect(chunk, offset + 5);
+            printf("\n");
+            return offset + 10;
+        }
+
+        case OP_LOOP_IF: {
+            int slot = readWord(chunk, offset + 2);
+            printf("%4d '%s' %s ", slot, interp.globals.names[slot]->chars,
+                   opNames[chunk->code[offset + 1]] + 3);
+            printDirect(chunk, offset + 6);
+            printf(" -> %d\n", offset + 15 - readWord(chunk, offset + 11));
+            return offset + 15;
+        }
+
+        case OP_DEFINE_TEMPLATE:
+            printf("%4d\n", readWord(chunk, offset + 1));
+            return offset + 5;
+
+        case OP_INIT_CATEGORY: {
+            int slot = readWord(chunk, offset + 5);
+            printf("%4d '%s'\n", readWord(chunk, offset + 1), interp.globals.names[slot]->chars);
+            return offset + 9;
+        }
+
+        default:
+            printf("\n");
+            return offset + 1;
+    }
+}
+
+void disassembleChunk(Chunk* chunk) {
+    printf("== bytecode (%d bytes, stack %d) ==\n", chunk->count, chunk->maxStack);
+
+    for (int offset = 0; offset < chunk->count;) {
+        offset = disassembleInstruction(chunk, offset);
+    }
+}
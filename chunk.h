@@ -0,0 +1,85 @@
+#ifndef cryton_chunk_h
+#define cryton_chunk_h
+
+#include "common.h"
+#include "value.h"
+
+// Operands are 32-bit, in the host's byte order. Jumps are forward offsets from the
+// end of the instruction, LOOP and LOOP_IF jump backward. A direct operand
+// is an OperandKind byte followed by a constant index or global slot.
+#define OPCODES(X)                                                          \
+    X(CONSTANT)         /* index       push constants[index]             */ \
+    X(FALSE)            /*             push 0                            */ \
+    X(TRUE)             /*             push 1                            */ \
+    X(POP)                                                                  \
+    X(GET_GLOBAL)       /* slot        push the variable's value         */ \
+    X(SET_GLOBAL)       /* slot        pop into the variable             */ \
+    X(ADD)                                                                  \
+    X(SUBTRACT)                                                             \
+    X(MULTIPLY)                                                             \
+    X(DIVIDE)                                                               \
+    X(MODULO)                                                               \
+    X(POWER)                                                                \
+    X(POWMOD)           /*             base exponent modulus -> result   */ \
+    X(LESS)                                                                 \
+    X(GREATER)                                                              \
+    X(EQUAL)                                                                \
+    X(NOT_EQUAL)                                                            \
+    X(NEGATE)                                                               \
+    X(NOT)                                                                  \
+    X(JUMP)             /* offset                                        */ \
+    X(JUMP_IF_FALSE)    /* offset      pops the condition                */ \
+    X(JUMP_IF_TRUE)     /* offset      pops the condition                */ \
+    X(LOOP)             /* offset                                        */ \
+    X(INCREMENT)        /* slot direct       slot = slot + direct        */ \
+    X(DECREMENT)        /* slot direct       slot = slot - direct        */ \
+    X(LOOP_IF)          /* op slot direct offset                         */ \
+                        /*       loop while `slot op direct` holds       */ \
+    X(JIT_LOOP)         /* node offset run the StmtWhile natively, jump  */ \
+                        /*             out if it finished                */ \
+    X(GET_CATEGORY)     /* node        push the category after 'in'      */ \
+    X(IN_OBJECT)        /*             category object -> is it in it    */ \
+    X(IN_MORPHISM)      /*             category from to -> is it in it   */ \
+    X(PRINT)                                                                \
+    X(DEFINE_TEMPLATE)  /* node        the StmtCat to define             */ \
+    X(INIT_CATEGORY)    /* node slot   the ExprCatInit to build and bind */ \
+    X(RETURN)
+
+typedef enum {
+#define OPCODE_ENUM(name) OP_##name,
+    OPCODES(OPCODE_ENUM)
+#undef OPCODE_ENUM
+} OpCode;
+
+typedef enum {
+    OPERAND_CONSTANT,
+    OPERAND_GLOBAL
+} OperandKind;
+
+// Compiled program. Numbers live in `constants`, variables are slots in
+// interp.globals, and category code stays AST nodes in `nodes`, borrowed
+// from the tree the chunk was compiled from.
+typedef struct {
+    int count;
+    int capacity;
+    uint8_t* code;
+
+    int constantCount;
+    int constantCapacity;
+    Value* constants;
+
+    int nodeCount;
+    int nodeCapacity;
+    void** nodes;
+
+    int maxStack;   // Deepest the value stack gets
+} Chunk;
+
+void initChunk(Chunk* chunk);
+void freeChunk(Chunk* chunk);
+void writeChunk(Chunk* chunk, uint8_t byte);
+int addConstant(Chunk* chunk, Value value);
+int addNode(Chunk* chunk, void* node);
+void disassembleChunk(Chunk* chunk);
+
+#endif
@@ -0,0 +1,382 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "compiler.h"
+#include "interpreter.h"
+#include "jit.h"
+#include "object.h"
+
+typedef struct {
+    Chunk* chunk;
+    int depth;      // Values on the stack at the current instruction
+    bool hadError;
+} Compiler;
+
+// Jumps waiting for their target, by operand offset
+typedef struct {
+    int count;
+    int capacity;
+    int* offsets;
+} JumpList;
+
+static Compiler compiler;
+
+static void compileError(const char* message) {
+    if (!compiler.hadError) {
+        fprintf(stderr, "Compile error: %s\n", message);
+    }
+    compiler.hadError = true;
+}
+
+static void emitByte(uint8_t byte) {
+    writeChunk(compiler.chunk, byte);
+}
+
+static void emitWord(int32_t operand) {
+    uint8_t bytes[sizeof(operand)];
+    memcpy(bytes, &operand, sizeof(operand));
+    for (size_t i = 0; i < sizeof(operand); i++) emitByte(bytes[i]);
+}
+
+// Tracks how `op` changes the stack depth
+static void emitOp(OpCode op, int effect) {
+    emitByte(op);
+    compiler.depth += effect;
+    if (compiler.depth > compiler.chunk->maxStack) {
+        compiler.chunk->maxStack = compiler.depth;
+    }
+}
+
+static void emitSlot(OpCode op, int effect, ExprVar* var) {
+    emitOp(op, effect);
+    emitWord(var->slot);
+}
+
+static void emitNode(OpCode op, int effect, void* node) {
+    emitOp(op, effect);
+    emitWord(addNode(compiler.chunk, node));
+}
+
+static int emitJump(OpCode op, int effect) {
+    emitOp(op, effect);
+    emitWord(-1);
+    return compiler.chunk->count - 4;
+}
+
+static void patchJump(int offset) {
+    int32_t jump = compiler.chunk->count - offset - 4;
+    memcpy(&compiler.chunk->code[offset], &jump, sizeof(jump));
+}
+
+static void emitLoop(int loopStart) {
+    emitOp(OP_LOOP, 0);
+
+    emitWord(compiler.chunk->count - loopStart + 4);
+}
+
+static void addJump(JumpList* list, int offset) {
+    if (list->count + 1 > list->capacity) {
+        list->capacity = list->capacity < 4 ? 4 : list->capacity * 2;
+        list->offsets = realloc(list->offsets, sizeof(int) * list->capacity);
+    }
+    list->offsets[list->count++] = offset;
+}
+
+static void patchJumps(JumpList* list) {
+    for (int i = 0; i < list->count; ++i) {
+        patchJump(list->offsets[i]);
+    }
+    free(list->offsets);
+    list->offsets = NULL;
+    list->count = list->capacity = 0;
+}
+
+static void expression(Expr* expr);
+
+static bool isLogical(Expr* expr, TokenType operator) {
+    return expr->type == EXPR_BINARY && ((ExprBinary*)expr)->operator == operator;
+}
+
+// Emits code that jumps to `list` when `expr` is `when`, and falls through
+// otherwise. `and`, `or` and `not` become control flow, so they stop at the
+// first operand that decides them and never materialise a boolean.
+static void branch(Expr* expr, bool when, JumpList* list) {
+    if (isLogical(expr, TOKEN_AND) || isLogical(expr, TOKEN_OR)) {
+        ExprBinary* binary = (ExprBinary*)expr;
+
+        // `and` is decided early by a false operand, `or` by a true one
+        bool decidedBy = binary->operator == TOKEN_OR;
+
+        if (when == decidedBy) {
+            branch(binary->left, when, list);
+            branch(binary->right, when, list);
+        } else {
+            JumpList decided = {0};
+            branch(binary->left, decidedBy, &decided);
+            branch(binary->right, when, list);
+            patchJumps(&decided);
+        }
+        return;
+    }
+
+    if (expr->type == EXPR_UNARY && ((ExprUnary*)expr)->operator == TOKEN_NOT) {
+        branch(((ExprUnary*)expr)->right, !when, list);
+        return;
+    }
+
+    expression(expr);
+    addJump(list, emitJump(when ? OP_JUMP_IF_TRUE : OP_JUMP_IF_FALSE, -1));
+}
+
+static void number(ExprNumber* expr) {
+    emitOp(OP_CONSTANT, 1);
+    emitWord(expr->constant);
+}
+
+static void binary(ExprBinary* expr) {
+    if (expr->operator == TOKEN_AND || expr->operator == TOKEN_OR) {
+        JumpList isFalse = {0};
+        branch((Expr*)expr, false, &isFalse);
+
+        emitOp(OP_TRUE, 1);
+        int end = emitJump(OP_JUMP, 0);
+        compiler.depth--;
+
+        patchJumps(&isFalse);
+        emitOp(OP_FALSE, 1);
+        patchJump(end);
+        return;
+    }
+
+    expression(expr->left);
+    expression(expr->right);
+
+    switch (expr->operator) {
+        case TOKEN_PLUS:        emitOp(OP_ADD, -1); break;
+        case TOKEN_MINUS:       emitOp(OP_SUBTRACT, -1); break;
+        case TOKEN_STAR:        emitOp(OP_MULTIPLY, -1); break;
+        case TOKEN_SLASH:       emitOp(OP_DIVIDE, -1); break;
+        case TOKEN_PERCENT:     emitOp(OP_MODULO, -1); break;
+        case TOKEN_STAR_STAR:   emitOp(OP_POWER, -1); break;
+        case TOKEN_LESS:        emitOp(OP_LESS, -1); break;
+        case TOKEN_GREATER:     emitOp(OP_GREATER, -1); break;
+        case TOKEN_EQUAL_EQUAL: emitOp(OP_EQUAL, -1); break;
+        case TOKEN_BANG_EQUAL:  emitOp(OP_NOT_EQUAL, -1); break;
+        default:                compileError("Unknown binary operator.");
+    }
+}
+
+static void unary(ExprUnary* expr) {
+    expression(expr->right);
+
+    switch (expr->operator) {
+        case TOKEN_MINUS: emitOp(OP_NEGATE, 0); break;
+        case TOKEN_NOT:   emitOp(OP_NOT, 0); break;
+        default:          compileError("Unknown unary operator.");
+    }
+}
+
+static void powMod(ExprPowMod* expr) {
+    expression(expr->base);
+    expression(expr->exponent);
+    expression(expr->modulus);
+    emitOp(OP_POWMOD, -2);
+}
+
+// The category is looked up first, so a bad one is reported before any
+// error in the element, as the tree walker does
+static void membership(ExprIn* expr) {
+    emitNode(OP_GET_CATEGORY, 1, expr);
+
+    if (expr->element->type == EXPR_MORPHISM) {
+        ExprMorphism* morph = (ExprMorphism*)expr->element;
+        expression(morph->from);
+        expression(morph->to);
+        emitOp(OP_IN_MORPHISM, -2);
+    } else {
+        expression(expr->element);
+        emitOp(OP_IN_OBJECT, -1);
+    }
+}
+
+static void expression(Expr* expr) {
+    switch (expr->type) {
+        case EXPR_BINARY:   binary((ExprBinary*)expr); return;
+        case EXPR_UNARY:    unary((ExprUnary*)expr); return;
+        case EXPR_POWMOD:   powMod((ExprPowMod*)expr); return;
+        case EXPR_NUMBER:   number((ExprNumber*)expr); return;
+        case EXPR_VAR:      emitSlot(OP_GET_GLOBAL, 1, (ExprVar*)expr); return;
+        case EXPR_IN:       membership((ExprIn*)expr); return;
+        default:            compileError("Unexpected expression.");
+    }
+}
+
+static void statements(Stmt* stmt);
+
+// Constants and variables are read where they live by the fused loop
+// instructions
+static bool isDirect(Expr* expr) {
+    return expr->type == EXPR_NUMBER || expr->type == EXPR_VAR;
+}
+
+static void emitDirect(Expr* expr) {
+    if (expr->type == EXPR_VAR) {
+        emitByte(OPERAND_GLOBAL);
+        emitWord(((ExprVar*)expr)->slot);
+    } else {
+        emitByte(OPERAND_CONSTANT);
+        emitWord(((ExprNumber*)expr)->constant);
+    }
+}
+
+bool isCounterStep(StmtAssign* stmt) {
+    if (stmt->right->type != EXPR_BINARY) return false;
+
+    ExprBinary* binary = (ExprBinary*)stmt->right;
+    return (binary->operator == TOKEN_PLUS || binary->operator == TOKEN_MINUS) &&
+           binary->left->type == EXPR_VAR &&
+           ((ExprVar*)binary->left)->slot == stmt->left->slot &&
+           isDirect(binary->right);
+}
+
+bool isCountedTest(Expr* condition) {
+    if (condition->type != EXPR_BINARY) return false;
+
+    ExprBinary* binary = (ExprBinary*)condition;
+    switch (binary->operator) {
+        case TOKEN_LESS:
+        case TOKEN_GREATER:
+        case TOKEN_EQUAL_EQUAL:
+        case TOKEN_BANG_EQUAL:
+            return binary->left->type == EXPR_VAR && isDirect(binary->right);
+        default:
+            return false;
+    }
+}
+
+static void assignStmt(StmtAssign* stmt) {
+    if (isCounterStep(stmt)) {
+        ExprBinary* binary = (ExprBinary*)stmt->right;
+        emitSlot(binary->operator == TOKEN_PLUS ? OP_INCREMENT : OP_DECREMENT, 0, stmt->left);
+        emitDirect(binary->right);
+        return;
+    }
+
+    if (stmt->right->type == EXPR_CAT_INIT) {
+        emitNode(OP_INIT_CATEGORY, 0, stmt->right);
+        emitWord(stmt->left->slot);
+        return;
+    }
+
+    expression(stmt->right);
+    emitSlot(OP_SET_GLOBAL, -1, stmt->left);
+}
+
+static void ifStmt(StmtIf* stmt) {
+    JumpList elseJumps = {0};
+    branch(stmt->condition, false, &elseJumps);
+    statements(stmt->thenBranch);
+
+    if (stmt->elseBranch == NULL) {
+        patchJumps(&elseJumps);
+        return;
+    }
+
+    int end = emitJump(OP_JUMP, 0);
+    patchJumps(&elseJumps);
+    statements(stmt->elseBranch);
+    patchJump(end);
+}
+
+// Counted loops test once on entry and then at the bottom of the body with
+// a single LOOP_IF, which compares the counter in place
+static void countedWhileStmt(StmtWhile* stmt) {
+    ExprBinary* test = (ExprBinary*)stmt->condition;
+
+    JumpList exitJumps = {0};
+    branch(stmt->condition, false, &exitJumps);
+
+    int bodyStart = compiler.chunk->count;
+    statements(stmt->body);
+
+    OpCode compare = test->operator == TOKEN_LESS    ? OP_LESS :
+                     test->operator == TOKEN_GREATER ? OP_GREATER :
+                     test->operator == TOKEN_EQUAL_EQUAL ? OP_EQUAL : OP_NOT_EQUAL;
+    emitOp(OP_LOOP_IF, 0);
+    emitByte(compare);
+    emitWord(((ExprVar*)test->left)->slot);
+    emitDirect(test->right);
+    emitWord(compiler.chunk->count - bodyStart + 4);
+
+    patchJumps(&exitJumps);
+}
+
+// Loops the JIT can take over keep their test at the top, where JIT_LOOP
+// counts every iteration and hands the rest of the loop to native code
+static void jitWhileStmt(StmtWhile* stmt) {
+    int loopStart = compiler.chunk->count;
+
+    JumpList exitJumps = {0};
+    emitNode(OP_JIT_LOOP, 0, stmt);
+    emitWord(-1);
+    addJump(&exitJumps, compiler.chunk->count - 4);
+
+    branch(stmt->condition, false, &exitJumps);
+    statements(stmt->body);
+    emitLoop(loopStart);
+    patchJumps(&exitJumps);
+}
+
+static void whileStmt(StmtWhile* stmt) {
+    if (interp.jit != JIT_OFF && jitSupports(stmt)) {
+        jitWhileStmt(stmt);
+        return;
+    }
+
+    if (isCountedTest(stmt->condition)) {
+        countedWhileStmt(stmt);
+        return;
+    }
+
+    int loopStart = compiler.chunk->count;
+
+    JumpList exitJumps = {0};
+    branch(stmt->condition, false, &exitJumps);
+    statements(stmt->body);
+    emitLoop(loopStart);
+    patchJumps(&exitJumps);
+}
+
+static void statement(Stmt* stmt) {
+    switch (stmt->type) {
+        case STMT_ASSIGN: assignStmt((StmtAssign*)stmt); break;
+        case STMT_PRINT : expression(((StmtPrint*)stmt)->expr); emitOp(OP_PRINT, -1); break;
+        case STMT_IF    : ifStmt((StmtIf*)stmt); break;
+        case STMT_WHILE : whileStmt((StmtWhile*)stmt); break;
+        case STMT_CAT   : emitNode(OP_DEFINE_TEMPLATE, 0, stmt); break;
+    }
+}
+
+static void statements(Stmt* stmt) {
+    while (stmt != NULL) {
+        statement(stmt);
+        stmt = stmt->next;
+    }
+}
+
+bool compile(Ast* ast, Chunk* chunk) {
+    compiler.chunk = chunk;
+    compiler.depth = 0;
+    compiler.hadError = false;
+
+    for (int i = 0; i < ast->constants.count; ++i) {
+        Value value = { .type = VALUE_NUMBER, .number = bigint_copy(&ast->constants.numbers[i]->value) };
+        addConstant(chunk, value);
+    }
+
+    statements(ast->stmts);
+    emitOp(OP_RETURN, 0);
+
+    return !compiler.hadError;
+}
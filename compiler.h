@@ -0,0 +1,19 @@
+#ifndef cryton_compiler_h
+#define cryton_compiler_h
+
+#include "chunk.h"
+#include "parser.h"
+
+// Compiles a parsed unit into `chunk`, whose constants are the unit's
+// constant pool. The chunk borrows category nodes from the tree, so the tree
+// must outlive it. Returns false on a compile error, which has already been
+// reported.
+bool compile(Ast* ast, Chunk* chunk);
+
+// Loop shapes both engines run without the general path:
+// `i = i + x` or `i = i - x`, with x a constant or a variable
+bool isCounterStep(StmtAssign* stmt);
+// i < n, i > n, i == n or i != n, with n a constant or a variable
+bool isCountedTest(Expr* condition);
+
+#endif
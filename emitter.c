@@ -0,0 +1,700 @@
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "aot.h"
+#include "object.h"
+#include "emitter.h"
+#include "resolver.h"
+#include "typer.h"
+
+typedef struct {
+    char* chars;
+    size_t length;
+    size_t capacity;
+} Buffer;
+
+// A C expression for a `const BigInt*`, or for a `const Value*` whose type
+// is only known at run time
+typedef struct {
+    char text[96];
+    bool isValue;
+    int temp;       // The temporary it names, or -1
+} Operand;
+
+typedef struct {
+    Buffer body;
+    Buffer site;        // Code of one evaluation, until its temporaries are known
+    Buffer* out;
+    int indent;
+
+    bool* global;       // By slot: category code sees it, so it lives in interp.globals
+    int varCount;
+
+    void** nodes;
+    int nodeCount;
+
+    Buffer constants;
+    Buffer constantInits;
+    bool* constantUsed;     // By index in the constant pool
+    int constantCount;
+
+    int temps;          // BigInt temporaries of the current evaluation
+    int names;          // Flags and value pointers, unique in the program
+} Emitter;
+
+static Emitter emitter;
+
+static void appendv(Buffer* buffer, const char* format, va_list args) {
+    va_list copy;
+    va_copy(copy, args);
+    int length = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+
+    if (buffer->length + length + 1 > buffer->capacity) {
+        buffer->capacity = (buffer->length + length + 1) * 2;
+        buffer->chars = realloc(buffer->chars, buffer->capacity);
+    }
+
+    vsnprintf(buffer->chars + buffer->length, length + 1, format, args);
+    buffer->length += length;
+}
+
+static void append(Buffer* buffer, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    appendv(buffer, format, args);
+    va_end(args);
+}
+
+static void freeBuffer(Buffer* buffer) {
+    free(buffer->chars);
+    buffer->chars = NULL;
+    buffer->length = buffer->capacity = 0;
+}
+
+static void line(const char* format, ...) {
+    append(emitter.out, "%*s", emitter.indent * 4, "");
+
+    va_list args;
+    va_start(args, format);
+    appendv(emitter.out, format, args);
+    va_end(args);
+
+    append(emitter.out, "\n");
+}
+
+static Operand makeOperand(bool isValue, int temp, const char* format, ...) {
+    Operand operand = { .isValue = isValue, .temp = temp };
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(operand.text, sizeof(operand.text), format, args);
+    va_end(args);
+    return operand;
+}
+
+static int nodeIndex(void* node) {
+    for (int i = 0; i < emitter.nodeCount; ++i) {
+        if (emitter.nodes[i] == node) return i;
+    }
+    return -1;
+}
+
+// An evaluation is emitted into its own block once it is known which
+// temporaries it needs, and frees them at the end
+static void beginSite() {
+    emitter.site.length = 0;
+    emitter.out = &emitter.site;
+    emitter.temps = 0;
+}
+
+static void endSite() {
+    emitter.out = &emitter.body;
+    if (emitter.site.length == 0) return;
+
+    if (emitter.temps == 0) {
+        append(&emitter.body, "%.*s", (int)emitter.site.length, emitter.site.chars);
+        return;
+    }
+
+    line("{");
+    emitter.indent++;
+    for (int i = 0; i < emitter.temps; ++i) {
+        line("BigInt t%d = BIGINT_ZERO;", i);
+    }
+
+    // Nest the site's lines one level deeper
+    const char* start = emitter.site.chars;
+    const char* end = start + emitter.site.length;
+    while (start < end) {
+        const char* newline = memchr(start, '\n', end - start);
+        append(&emitter.body, "    %.*s\n", (int)(newline - start), start);
+        start = newline + 1;
+    }
+
+    for (int i = 0; i < emitter.temps; ++i) {
+        line("bigint_free(&t%d);", i);
+    }
+    emitter.indent--;
+    line("}");
+}
+
+static Operand operand(Expr* expr);
+static int condition(Expr* expr);
+
+// Big literals are made once, when the program starts
+static Operand number(ExprNumber* expr) {
+    const BigInt* value = &expr->value;
+    if (BIGINT_IS_SMALL(value)) {
+        return makeOperand(false, -1, "&BIGINT_SMALL(INT64_C(%" PRId64 "))", BIGINT_SMALL_VALUE(value));
+    }
+
+    int index = expr->constant;
+    if (emitter.constantUsed[index]) return makeOperand(false, -1, "&k%d", index);
+    emitter.constantUsed[index] = true;
+
+    char* digits = bigint_to_str(value);
+    append(&emitter.constants, "static BigInt k%d;\n", index);
+    append(&emitter.constantInits, "    k%d = bigint_from_str(\"%s\", %d);\n", index, digits, (int)strlen(digits));
+    free(digits);
+
+    return makeOperand(false, -1, "&k%d", index);
+}
+
+// Variables the type checker proved assigned are read without a check,
+// and only those it could not type are checked for numbers where used
+static Operand variable(ExprVar* var) {
+    int slot = var->slot;
+
+    if (emitter.global[slot]) {
+        switch (var->staticType) {
+            case STATIC_NUMBER:     return makeOperand(false, -1, "aotNumber(%d)", slot);
+            case STATIC_UNKNOWN:    break;
+            default:                return makeOperand(true, -1, "aotValue(%d)", slot);
+        }
+
+        int name = emitter.names++;
+        line("const Value* d%d = aotGlobal(%d);", name, slot);
+        return makeOperand(true, -1, "d%d", name);
+    }
+
+    if (var->staticType == STATIC_UNKNOWN) {
+        line("aotDefined(&v%d, \"%s\");", slot, var->name->chars);
+    }
+    return makeOperand(false, -1, "&v%d", slot);
+}
+
+static void toNumber(Operand* operand) {
+    if (!operand->isValue) return;
+
+    // Values are named by a short pointer such as d3 or aotValue(3)
+    char name[sizeof(operand->text)];
+    memcpy(name, operand->text, sizeof(name));
+    snprintf(operand->text, sizeof(operand->text), "&%.80s->number", name);
+    operand->isValue = false;
+}
+
+static const char* typeOf(Operand* operand, char* buffer, size_t size) {
+    if (!operand->isValue) return "VALUE_NUMBER";
+    snprintf(buffer, size, "%s->type", operand->text);
+    return buffer;
+}
+
+// Only operands whose type is unknown need checking
+static void checkNumbers(Operand* a, Operand* b) {
+    if (!a->isValue && !b->isValue) return;
+
+    char aType[sizeof(a->text) + 8], bType[sizeof(b->text) + 8];
+    line("aotCheckNumbers(%s, %s);", typeOf(a, aType, sizeof(aType)), typeOf(b, bType, sizeof(bType)));
+    toNumber(a);
+    toNumber(b);
+}
+
+// Results accumulate into the left operand's temporary, as the tree walker
+// accumulates into its destination
+static int resultTemp(Operand* left) {
+    return left->temp >= 0 ? left->temp : emitter.temps++;
+}
+
+static Operand arithmetic(ExprBinary* expr, const char* target) {
+    Operand a = operand(expr->left);
+    Operand b = operand(expr->right);
+    checkNumbers(&a, &b);
+
+    const char* helper;
+    switch (expr->operator) {
+        case TOKEN_PLUS:    helper = "aotAdd"; break;
+        case TOKEN_MINUS:   helper = "aotSubtract"; break;
+        case TOKEN_STAR:    helper = "aotMultiply"; break;
+        case TOKEN_SLASH:   helper = "aotDivide"; break;
+        case TOKEN_PERCENT: helper = "aotModulo"; break;
+        default:            helper = "aotPower"; break;
+    }
+
+    if (target != NULL) {
+        line("%s(%s, %s, %s);", helper, target, a.text, b.text);
+        return makeOperand(false, -1, "%s", target);
+    }
+
+    int temp = resultTemp(&a);
+    line("%s(&t%d, %s, %s);", helper, temp, a.text, b.text);
+    return makeOperand(false, temp, "&t%d", temp);
+}
+
+static Operand boolean(int flag) {
+    int temp = emitter.temps++;
+    line("t%d = BIGINT_FROM_BOOL(c%d);", temp, flag);
+    return makeOperand(false, temp, "&t%d", temp);
+}
+
+static Operand unary(ExprUnary* expr) {
+    Operand a = operand(expr->right);
+    if (a.isValue) {
+        line("aotCheckUnary(%s->type);", a.text);
+        toNumber(&a);
+    }
+
+    if (expr->operator == TOKEN_MINUS) {
+        int temp = resultTemp(&a);
+        line("aotNegate(&t%d, %s);", temp, a.text);
+        return makeOperand(false, temp, "&t%d", temp);
+    }
+
+    int temp = emitter.temps++;
+    line("t%d = BIGINT_FROM_BOOL(!aotTruthy(%s));", temp, a.text);
+    return makeOperand(false, temp, "&t%d", temp);
+}
+
+static Operand powMod(ExprPowMod* expr) {
+    Operand base = operand(expr->base);
+    Operand exponent = operand(expr->exponent);
+    Operand modulus = operand(expr->modulus);
+
+    if (base.isValue || exponent.isValue || modulus.isValue) {
+        char baseType[sizeof(base.text) + 8], otherType[sizeof(base.text) + 8];
+        typeOf(&base, baseType, sizeof(baseType));
+        line("aotCheckNumbers(%s, %s);", baseType, typeOf(&exponent, otherType, sizeof(otherType)));
+        line("aotCheckNumbers(%s, %s);", baseType, typeOf(&modulus, otherType, sizeof(otherType)));
+        toNumber(&base);
+        toNumber(&exponent);
+        toNumber(&modulus);
+    }
+
+    int temp = resultTemp(&base);
+    line("aotPowMod(&t%d, %s, %s, %s);", temp, base.text, exponent.text, modulus.text);
+    return makeOperand(false, temp, "&t%d", temp);
+}
+
+static Operand operand(Expr* expr) {
+    switch (expr->type) {
+        case EXPR_NUMBER:   return number((ExprNumber*)expr);
+        case EXPR_VAR:      return variable((ExprVar*)expr);
+        case EXPR_POWMOD:   return powMod((ExprPowMod*)expr);
+        case EXPR_IN:       return boolean(condition(expr));
+
+        case EXPR_UNARY:
+            return unary((ExprUnary*)expr);
+
+        case EXPR_BINARY: {
+            ExprBinary* binary = (ExprBinary*)expr;
+            switch (binary->operator) {
+                case TOKEN_PLUS:
+                case TOKEN_MINUS:
+                case TOKEN_STAR:
+                case TOKEN_SLASH:
+                case TOKEN_PERCENT:
+                case TOKEN_STAR_STAR:
+                    return arithmetic(binary, NULL);
+                default:
+                    return boolean(condition(expr));
+            }
+        }
+
+        default:
+            return makeOperand(true, -1, "(&aotNull)");
+    }
+}
+
+// Category code wants values, numbers are wrapped on the spot
+static const char* valueOf(Operand* operand, char* buffer, size_t size) {
+    if (operand->isValue) return operand->text;
+    snprintf(buffer, size, "AOT_NUMBER_VALUE(%s)", operand->text);
+    return buffer;
+}
+
+static int membership(ExprIn* expr) {
+    int category = emitter.names++;
+    int flag;
+
+    line("RuntimeCategory* g%d = aotCategory(%d);", category, nodeIndex(expr));
+
+    if (expr->element->type == EXPR_MORPHISM) {
+        ExprMorphism* morph = (ExprMorphism*)expr->element;
+        Operand from = operand(morph->from);
+        Operand to = operand(morph->to);
+
+        char fromValue[sizeof(from.text) + 24], toValue[sizeof(to.text) + 24];
+        flag = emitter.names++;
+        line("bool c%d = aotInMorphism(g%d, %s, %s);", flag, category,
+             valueOf(&from, fromValue, sizeof(fromValue)), valueOf(&to, toValue, sizeof(toValue)));
+    } else {
+        Operand element = operand(expr->element);
+
+        char value[sizeof(element.text) + 24];
+        flag = emitter.names++;
+        line("bool c%d = aotInObject(g%d, %s);", flag, category, valueOf(&element, value, sizeof(value)));
+    }
+    return flag;
+}
+
+// Emits the evaluation of a truth value into a fresh `bool c<n>` and
+// returns n. `and` and `or` only evaluate their right side when needed.
+static int condition(Expr* expr) {
+    int flag;
+
+    if (expr->type == EXPR_BINARY) {
+        ExprBinary* binary = (ExprBinary*)expr;
+
+        switch (binary->operator) {
+            case TOKEN_AND:
+            case TOKEN_OR: {
+                int left = condition(binary->left);
+                flag = emitter.names++;
+                line("bool c%d = c%d;", flag, left);
+                line(binary->operator == TOKEN_AND ? "if (c%d) {" : "if (!c%d) {", flag);
+                emitter.indent++;
+                int right = condition(binary->right);
+                line("c%d = c%d;", flag, right);
+                emitter.indent--;
+                line("}");
+                return flag;
+            }
+
+            case TOKEN_LESS:
+            case TOKEN_GREATER:
+            case TOKEN_EQUAL_EQUAL:
+            case TOKEN_BANG_EQUAL: {
+                Operand a = operand(binary->left);
+                Operand b = operand(binary->right);
+                checkNumbers(&a, &b);
+
+                flag = emitter.names++;
+                switch (binary->operator) {
+                    case TOKEN_LESS:        line("bool c%d = aotCompare(%s, %s) < 0;", flag, a.text, b.text); break;
+                    case TOKEN_GREATER:     line("bool c%d = aotCompare(%s, %s) > 0;", flag, a.text, b.text); break;
+                    case TOKEN_EQUAL_EQUAL: line("bool c%d = aotEqual(%s, %s);", flag, a.text, b.text); break;
+                    default:                line("bool c%d = !aotEqual(%s, %s);", flag, a.text, b.text); break;
+                }
+                return flag;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    if (expr->type == EXPR_UNARY && ((ExprUnary*)expr)->operator == TOKEN_NOT) {
+        int inner = condition(((ExprUnary*)expr)->right);
+        flag = emitter.names++;
+        line("bool c%d = !c%d;", flag, inner);
+        return flag;
+    }
+
+    if (expr->type == EXPR_IN) return membership((ExprIn*)expr);
+
+    Operand value = operand(expr);
+    flag = emitter.names++;
+    if (value.isValue) {
+        line("bool c%d = conditionValue(%s);", flag, value.text);
+    } else {
+        line("bool c%d = aotTruthy(%s);", flag, value.text);
+    }
+    return flag;
+}
+
+static void statements(Stmt* stmt);
+
+static bool isArithmetic(Expr* expr) {
+    if (expr->type != EXPR_BINARY) return false;
+
+    switch (((ExprBinary*)expr)->operator) {
+        case TOKEN_PLUS:
+        case TOKEN_MINUS:
+        case TOKEN_STAR:
+        case TOKEN_SLASH:
+        case TOKEN_PERCENT:
+        case TOKEN_STAR_STAR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void assignStmt(StmtAssign* stmt) {
+    int slot = stmt->left->slot;
+
+    if (stmt->right->type == EXPR_CAT_INIT) {
+        line("aotInitCategory(%d, %d);", nodeIndex(stmt->right), slot);
+        return;
+    }
+
+    beginSite();
+
+    // x = x + y and the like update a local in place
+    ExprBinary* binary = (ExprBinary*)stmt->right;
+    if (!emitter.global[slot] && isArithmetic(stmt->right) &&
+        binary->left->type == EXPR_VAR && ((ExprVar*)binary->left)->slot == slot) {
+        char target[32];
+        snprintf(target, sizeof(target), "&v%d", slot);
+        arithmetic(binary, target);
+        endSite();
+        return;
+    }
+
+    Operand value = operand(stmt->right);
+    if (value.isValue) {
+        line("checkStorable(%s, \"assign\");", value.text);
+        toNumber(&value);
+    }
+
+    if (emitter.global[slot]) {
+        line("aotSetGlobal(%d, %s);", slot, value.text);
+    } else {
+        line("aotAssign(&v%d, %s);", slot, value.text);
+    }
+    endSite();
+}
+
+static void printStmt(StmtPrint* stmt) {
+    beginSite();
+    Operand value = operand(stmt->expr);
+    if (value.isValue) {
+        line("checkStorable(%s, \"print\");", value.text);
+        toNumber(&value);
+    }
+    line("aotPrint(%s);", value.text);
+    endSite();
+}
+
+// Declares `bool c<n>` for the condition outside the block of its temporaries
+static int conditionSite(Expr* expr) {
+    int flag = emitter.names++;
+    line("bool c%d;", flag);
+
+    beginSite();
+    line("c%d = c%d;", flag, condition(expr));
+    endSite();
+    return flag;
+}
+
+static void ifStmt(StmtIf* stmt) {
+    int flag = conditionSite(stmt->condition);
+
+    line("if (c%d) {", flag);
+    emitter.indent++;
+    statements(stmt->thenBranch);
+    emitter.indent--;
+
+    if (stmt->elseBranch != NULL) {
+        line("} else {");
+        emitter.indent++;
+        statements(stmt->elseBranch);
+        emitter.indent--;
+    }
+    line("}");
+}
+
+static void whileStmt(StmtWhile* stmt) {
+    line("for (;;) {");
+    emitter.indent++;
+    int flag = conditionSite(stmt->condition);
+    line("if (!c%d) break;", flag);
+    statements(stmt->body);
+    emitter.indent--;
+    line("}");
+}
+
+static void statements(Stmt* stmt) {
+    for (; stmt != NULL; stmt = stmt->next) {
+        switch (stmt->type) {
+            case STMT_ASSIGN: assignStmt((StmtAssign*)stmt); break;
+            case STMT_PRINT : printStmt((StmtPrint*)stmt); break;
+            case STMT_IF    : ifStmt((StmtIf*)stmt); break;
+            case STMT_WHILE : whileStmt((StmtWhile*)stmt); break;
+            case STMT_CAT   : line("aotDefineTemplate(%d);", nodeIndex(stmt)); break;
+        }
+    }
+}
+
+// Anything the interpreter touches for category code has to be in
+// interp.globals
+static void classifyExpr(Expr* expr, bool global) {
+    switch (expr->type) {
+        case EXPR_VAR:
+            if (global) emitter.global[((ExprVar*)expr)->slot] = true;
+            break;
+
+        case EXPR_BINARY:
+            classifyExpr(((ExprBinary*)expr)->left, global);
+            classifyExpr(((ExprBinary*)expr)->right, global);
+            break;
+
+        case EXPR_UNARY:
+            classifyExpr(((ExprUnary*)expr)->right, global);
+            break;
+
+        case EXPR_POWMOD: {
+            ExprPowMod* powMod = (ExprPowMod*)expr;
+            classifyExpr(powMod->base, global);
+            classifyExpr(powMod->exponent, global);
+            classifyExpr(powMod->modulus, global);
+            break;
+        }
+
+        case EXPR_IN: {
+            ExprIn* in = (ExprIn*)expr;
+            emitter.global[in->name->slot] = true;
+            classifyExpr(in->element, global);
+            break;
+        }
+
+        case EXPR_MORPHISM: {
+            ExprMorphism* morph = (ExprMorphism*)expr;
+            classifyExpr(morph->from, global);
+            classifyExpr(morph->to, global);
+            break;
+        }
+
+        case EXPR_CAT_INIT: {
+            ExprCatInit* init = (ExprCatInit*)expr;
+            emitter.global[findGlobalSlot(&interp.globals, init->callee)] = true;
+            for (int i = 0; i < init->argCount; ++i) {
+                classifyExpr(init->args[i], true);
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+static void classify(Stmt* stmt) {
+    for (; stmt != NULL; stmt = stmt->next) {
+        switch (stmt->type) {
+            case STMT_ASSIGN: {
+                StmtAssign* assign = (StmtAssign*)stmt;
+                classifyExpr(assign->right, false);
+                if (assign->right->type == EXPR_CAT_INIT) {
+                    emitter.global[assign->left->slot] = true;
+                }
+                break;
+            }
+
+            case STMT_PRINT:
+                classifyExpr(((StmtPrint*)stmt)->expr, false);
+                break;
+
+            case STMT_IF: {
+                StmtIf* ifStmt = (StmtIf*)stmt;
+                classifyExpr(ifStmt->condition, false);
+                classify(ifStmt->thenBranch);
+                classify(ifStmt->elseBranch);
+                break;
+            }
+
+            case STMT_WHILE: {
+                StmtWhile* whileStmt = (StmtWhile*)stmt;
+                classifyExpr(whileStmt->condition, false);
+                classify(whileStmt->body);
+                break;
+            }
+
+            case STMT_CAT: {
+                int slot = findGlobalSlot(&interp.globals, ((StmtCat*)stmt)->name);
+                emitter.global[slot] = true;
+                break;
+            }
+        }
+    }
+}
+
+static void emitSource(const char* source, size_t length, FILE* out) {
+    const char* end = source + length;
+    fprintf(out, "static const char source[] =\n    \"");
+    for (const char* c = source; c < end; ++c) {
+        switch (*c) {
+            case '\n':
+                fprintf(out, c + 1 == end ? "\\n\"" : "\\n\"\n    \"");
+                continue;
+            case '"':   fprintf(out, "\\\""); break;
+            case '\\':  fprintf(out, "\\\\"); break;
+            case '\t':  fprintf(out, "\\t"); break;
+            case '\r':  fprintf(out, "\\r"); break;
+            default:
+                // Octal escapes always take three digits, so they never run on
+                if ((unsigned char)*c < 0x20 || (unsigned char)*c >= 0x7f) {
+                    fprintf(out, "\\%03o", (unsigned char)*c);
+                } else {
+                    fputc(*c, out);
+                }
+        }
+    }
+    fprintf(out, "%s;\n\n", length > 0 && end[-1] == '\n' ? "" : "\"");
+}
+
+bool emitC(Ast* ast, const char* source, size_t length, const char* path, FILE* out) {
+    Stmt* stmts = ast->stmts;
+    resolve(stmts);
+    if (!inferTypes(stmts)) return false;
+
+    memset(&emitter, 0, sizeof(emitter));
+    emitter.out = &emitter.body;
+    emitter.indent = 1;
+    emitter.varCount = interp.globals.count;
+    emitter.global = calloc(emitter.varCount + 1, sizeof(bool));
+    emitter.nodeCount = aotCollectNodes(stmts, &emitter.nodes);
+    emitter.constantCount = ast->constants.count;
+    emitter.constantUsed = calloc(emitter.constantCount + 1, sizeof(bool));
+
+    classify(stmts);
+    statements(stmts);
+
+    fprintf(out, "// Generated by cryton --emit-c from %s\n", path);
+    fprintf(out, "#include \"aot.h\"\n\n");
+    emitSource(source, length, out);
+
+    for (int i = 0; i < emitter.varCount; ++i) {
+        if (emitter.global[i]) continue;
+        fprintf(out, "static BigInt v%d = AOT_UNDEFINED;    // %s\n", i, interp.globals.names[i]->chars);
+    }
+    fprintf(out, "%.*s\n", (int)emitter.constants.length, emitter.constants.chars ? emitter.constants.chars : "");
+
+    fprintf(out, "static void program(void) {\n");
+    fprintf(out, "%.*s", (int)emitter.constantInits.length, emitter.constantInits.chars ? emitter.constantInits.chars : "");
+    fprintf(out, "%.*s}\n\n", (int)emitter.body.length, emitter.body.chars ? emitter.body.chars : "");
+
+    fprintf(out, "static void release(void) {\n");
+    for (int i = 0; i < emitter.varCount; ++i) {
+        if (!emitter.global[i]) fprintf(out, "    aotFree(&v%d);\n", i);
+    }
+    for (int i = 0; i < emitter.constantCount; ++i) {
+        if (emitter.constantUsed[i]) fprintf(out, "    aotFree(&k%d);\n", i);
+    }
+    fprintf(out, "}\n\n");
+
+    fprintf(out, "int main(void) {\n");
+    fprintf(out, "    return aotMain(source, sizeof(source) - 1, program, release);\n");
+    fprintf(out, "}\n");
+
+    freeBuffer(&emitter.body);
+    freeBuffer(&emitter.site);
+    freeBuffer(&emitter.constants);
+    freeBuffer(&emitter.constantInits);
+    free(emitter.constantUsed);
+    free(emitter.global);
+    free(emitter.nodes);
+    return true;
+}
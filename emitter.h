@@ -0,0 +1,14 @@
+#ifndef cryton_emitter_h
+#define cryton_emitter_h
+
+#include <stdio.h>
+
+#include "parser.h"
+
+// Writes a C translation unit that runs the program when linked against the
+// runtime library (see aot.h). `source` is the `length` bytes `ast` was
+// parsed from and is embedded for the category code. Resolves and type
+// checks the program first, and writes nothing if it is certain to fail.
+bool emitC(Ast* ast, const char* source, size_t length, const char* path, FILE* out);
+
+#endif
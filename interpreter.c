@@ -4,13 +4,21 @@
 #include "object.h"
 #include "table.h"
 #include "interpreter.h"
-
-Value interpretExpr(Expr* expr);
+#include "compiler.h"
+#include "resolver.h"
+#include "typer.h"
+#include "vm.h"
+
+void interpretExpr(Expr* expr, Value* out);
+bool interpretCondition(Expr* expr);
+bool interpretMembership(ExprIn* expr);
 void interpret(Stmt* stmts);
 
 Interp interp;
 
 void runtimeError(const char* format, ...) {
+    flushOutput(&interp.out);
+
     va_list args;
     va_start(args, format);
     vfprintf(stderr, format, args);
@@ -35,120 +43,338 @@ const char* typeName(ValueType type) {
     }
 }
 
-Value makeValue(ValueType type, BigInt number) {
-    Value val;
-    val.type = type;
-    val.number = number;
+void initInterp(OutputMode outputMode, Engine engine, JitMode jit) {
+    interp.engine = engine;
+    interp.jit = jit;
+    initStringSet(&interp.strings);
+    initGlobals(&interp.globals);
+    interp.args = NULL;
+    initTable(&interp.argTable);
+    interp.building = NULL;
+    interp.held = NULL;
+    interp.heldCount = 0;
+    interp.heldCapacity = 0;
+    initNumberSet(&interp.numbers);
+    initOutput(&interp.out, outputMode);
+}
+
+void freeInterp() {
+    flushOutput(&interp.out);
+    freeGlobals(&interp.globals);
+    freeTable(&interp.argTable);
+    free(interp.held);
+    freeStringSet(&interp.strings);
+    freeNumberSet(&interp.numbers);
+    bigint_release_caches();
+}
+
+// Resolved names are global slots, the rest are template parameters
+static Value* findVar(ExprVar* var) {
+    if (var->slot >= 0) return &interp.globals.values[var->slot];
+    if (interp.args != NULL) return tableGetRef(interp.args, var->name);
+    return NULL;
+}
+
+static Value* lookupVar(ExprVar* var) {
+    // Proven to be assigned by the type checker
+    if (var->staticType != STATIC_UNKNOWN) return &interp.globals.values[var->slot];
+
+    Value* val = findVar(var);
+    if (val == NULL || val->type == VALUE_NULL) {
+        runtimeError("Undefined variable '%.*s'.", var->name->length, var->name->chars);
+    }
     return val;
 }
 
-void initInterp() {
-    initTable(&interp.strings);
+// Keeps an owned operand where abortStatement can free it while another
+// operand is evaluated. Small numbers own nothing and are not held.
+static bool holdValue(const Value* value) {
+    if (value->type == VALUE_NUMBER && BIGINT_IS_SMALL(&value->number)) return false;
+
+    if (interp.heldCount == interp.heldCapacity) {
+        interp.heldCapacity = interp.heldCapacity < 8 ? 8 : interp.heldCapacity * 2;
+        interp.held = realloc(interp.held, sizeof(Value) * interp.heldCapacity);
+    }
+    interp.held[interp.heldCount++] = *value;
+    return true;
 }
 
-void freeInterp() {
-    freeTable(&interp.strings, true);
+// Gives the most recently held operand back to its owner
+static void unholdValue(bool held) {
+    if (held) interp.heldCount--;
 }
 
-Value interpretBinary(ExprBinary* expr) {
-    Value leftVal = interpretExpr(expr->left);
-    Value rightVal = interpretExpr(expr->right);
+// Reads a variable or literal operand where it already lives, without taking
+// a reference. Anything else is evaluated into `scratch`, and `owned` tells
+// the caller to free it. Expressions never write to the table, so a borrowed
+// variable stays valid while the other operand is evaluated.
+const Value* borrowOperand(Expr* expr, Value* scratch, bool* owned) {
+    *owned = false;
+
+    switch (expr->type) {
+        case EXPR_NUMBER:
+            scratch->type = VALUE_NUMBER;
+            scratch->number = ((ExprNumber*)expr)->value;
+            return scratch;
+
+        case EXPR_VAR:
+            return lookupVar((ExprVar*)expr);
+
+        default:
+            interpretExpr(expr, scratch);
+            *owned = true;
+            return scratch;
+    }
+}
 
-    if (leftVal.type != VALUE_NUMBER || rightVal.type != VALUE_NUMBER) {
-        runtimeError("Binary operators can only be applied to numbers.\n"
-                        "But got values of types '%s' and '%s'",
-                        typeName(leftVal.type), typeName(rightVal.type));
+// Categories and templates only live in the globals table
+void checkStorable(const Value* value, const char* action) {
+    switch (value->type) {
+        case VALUE_CAT_TEMPLATE:    runtimeError("Cannot %s variable '%s' of type '%s'.",
+                                        action, value->template->name->chars, typeName(value->type));
+        case VALUE_CATEGORY:        runtimeError("Cannot %s variable '%s' of type '%s'.",
+                                        action, value->category->name->chars, typeName(value->type));
+        default:                    break;
     }
+}
 
-    BigInt left = leftVal.number;
-    BigInt right = rightVal.number;
-    BigInt result = bigint_from_int(0);
-    BigInt zero = bigint_from_int(0);
+void binaryTypeError(Value* left, bool leftOwned, Value* right, bool rightOwned) {
+    ValueType leftType = left->type, rightType = right->type;
+    if (leftOwned) freeValue(left);
+    if (rightOwned) freeValue(right);
 
-    switch (expr->operator) {
-        case TOKEN_PLUS:
-            bigint_add(&result, &left, &right);
-            return makeValue(VALUE_NUMBER, result);
+    runtimeError("Binary operators can only be applied to numbers.\n"
+                    "But got values of types '%s' and '%s'",
+                    typeName(leftType), typeName(rightType));
+}
 
-        case TOKEN_MINUS:
-            bigint_sub(&result, &left, &right);
-            return makeValue(VALUE_NUMBER, result);
+// Arithmetic accumulates into the destination, which holds the left operand
+void interpretArithmetic(ExprBinary* expr, Value* out) {
+    interpretExpr(expr->left, out);
 
-        case TOKEN_LESS:
-            bigint_init(&result, bigint_abs_compare(&left, &right) < 0);
-            return makeValue(VALUE_NUMBER, result);
+    Value scratch;
+    bool owned;
+    bool held = holdValue(out);
+    const Value* rightVal = borrowOperand(expr->right, &scratch, &owned);
+    unholdValue(held);
 
-        case TOKEN_GREATER:
-            bigint_init(&result, bigint_abs_compare(&left, &right) > 0);
-            return makeValue(VALUE_NUMBER, result);
+    if (expr->staticType != STATIC_NUMBER &&
+        (out->type != VALUE_NUMBER || rightVal->type != VALUE_NUMBER)) {
+        binaryTypeError(out, true, (Value*)rightVal, owned);
+    }
 
-        case TOKEN_EQUAL_EQUAL:
-            bigint_init(&result, bigint_abs_compare(&left, &right) == 0);
-            return makeValue(VALUE_NUMBER, result);
+    BigInt* acc = &out->number;
+    const BigInt* right = &rightVal->number;
+    const char* error = NULL;
 
-        case TOKEN_BANG_EQUAL:
-            bigint_init(&result, bigint_abs_compare(&left, &right) != 0);
-            return makeValue(VALUE_NUMBER, result);
+    switch (expr->operator) {
+        case TOKEN_PLUS:    bigint_add_inplace(acc, right); break;
+        case TOKEN_MINUS:   bigint_sub_inplace(acc, right); break;
+        case TOKEN_STAR:    bigint_mul(acc, acc, right); break;
 
-        case TOKEN_AND:
-            bigint_init(&result,
-                bigint_abs_compare(&left, &zero) != 0 &&
-                bigint_abs_compare(&right, &zero) != 0);
-            return makeValue(VALUE_NUMBER, result);
+        case TOKEN_SLASH:
+            if (!bigint_divmod(acc, NULL, acc, right)) error = "Division by zero.";
+            break;
+
+        case TOKEN_PERCENT:
+            if (!bigint_divmod(NULL, acc, acc, right)) error = "Division by zero.";
+            break;
 
-        case TOKEN_OR:
-            bigint_init(&result,
-                bigint_abs_compare(&left, &zero) != 0 ||
-                bigint_abs_compare(&right, &zero) != 0);
-            return makeValue(VALUE_NUMBER, result);
+        case TOKEN_STAR_STAR:
+            if (bigint_is_negative(right)) error = "Negative exponent.";
+            else if (!bigint_pow(acc, acc, right)) error = "Exponent too large.";
+            break;
     }
 
-    return makeValue(VALUE_NULL, bigint_from_int(0)); // fallback for unknown operator
+    if (owned) freeValue(&scratch);
+    if (error != NULL) {
+        freeValue(out);
+        runtimeError(error);
+    }
 }
 
+void interpretPowMod(ExprPowMod* expr, Value* out) {
+    interpretExpr(expr->base, out);
+
+    Value expScratch, modScratch;
+    bool expOwned, modOwned;
+    bool baseHeld = holdValue(out);
+    const Value* expVal = borrowOperand(expr->exponent, &expScratch, &expOwned);
+    bool expHeld = expOwned && holdValue(&expScratch);
+    const Value* modVal = borrowOperand(expr->modulus, &modScratch, &modOwned);
+    unholdValue(expHeld);
+    unholdValue(baseHeld);
+
+    if (expr->staticType != STATIC_NUMBER) {
+        if (out->type != VALUE_NUMBER || expVal->type != VALUE_NUMBER) {
+            if (modOwned) freeValue(&modScratch);
+            binaryTypeError(out, true, (Value*)expVal, expOwned);
+        }
+        if (modVal->type != VALUE_NUMBER) {
+            if (expOwned) freeValue(&expScratch);
+            binaryTypeError(out, true, (Value*)modVal, modOwned);
+        }
+    }
 
-Value interpretUnary(ExprUnary* expr) {
-    Value val = interpretExpr(expr->right);
+    const char* error = NULL;
+    if (bigint_is_negative(&expVal->number)) error = "Negative exponent.";
+    else if (!bigint_powmod(&out->number, &out->number, &expVal->number, &modVal->number))
+        error = "Division by zero.";
 
-    if (val.type != VALUE_NUMBER) {
-        runtimeError("Unary operator can only be applied to numbers.\n"
+    if (expOwned) freeValue(&expScratch);
+    if (modOwned) freeValue(&modScratch);
+    if (error != NULL) {
+        freeValue(out);
+        runtimeError(error);
+    }
+}
+
+// Comparisons only read their operands, so both are borrowed
+bool interpretComparison(ExprBinary* expr) {
+    Value leftScratch, rightScratch;
+    bool leftOwned, rightOwned;
+    const Value* leftVal = borrowOperand(expr->left, &leftScratch, &leftOwned);
+    bool held = leftOwned && holdValue(&leftScratch);
+    const Value* rightVal = borrowOperand(expr->right, &rightScratch, &rightOwned);
+    unholdValue(held);
+
+    if (expr->staticType != STATIC_NUMBER &&
+        (leftVal->type != VALUE_NUMBER || rightVal->type != VALUE_NUMBER)) {
+        binaryTypeError((Value*)leftVal, leftOwned, (Value*)rightVal, rightOwned);
+    }
+
+    const BigInt* left = &leftVal->number;
+    const BigInt* right = &rightVal->number;
+    bool result = false;
+
+    switch (expr->operator) {
+        case TOKEN_LESS:        result = bigint_abs_compare(left, right) < 0; break;
+        case TOKEN_GREATER:     result = bigint_abs_compare(left, right) > 0; break;
+        case TOKEN_EQUAL_EQUAL: result = bigint_equal(left, right); break;
+        case TOKEN_BANG_EQUAL:  result = !bigint_equal(left, right); break;
+    }
+
+    if (leftOwned) freeValue(&leftScratch);
+    if (rightOwned) freeValue(&rightScratch);
+    return result;
+}
+
+bool conditionValue(const Value* val) {
+    if (val->type != VALUE_NUMBER) {
+        runtimeError("Conditions can only be numbers.\n"
                         "But got value of type '%s'",
-                        typeName(val.type));
+                        typeName(val->type));
+    }
+    return !bigint_is_zero(&val->number);
+}
+
+// Evaluates straight to a C bool: comparisons, `in`, `not`, `and` and `or`
+// never build a number for their truth value, and `and`/`or` stop at the
+// first operand that decides them
+bool interpretCondition(Expr* expr) {
+    switch (expr->type) {
+        case EXPR_BINARY: {
+            ExprBinary* binary = (ExprBinary*)expr;
+            switch (binary->operator) {
+                case TOKEN_AND:
+                    return interpretCondition(binary->left) && interpretCondition(binary->right);
+                case TOKEN_OR:
+                    return interpretCondition(binary->left) || interpretCondition(binary->right);
+                case TOKEN_LESS:
+                case TOKEN_GREATER:
+                case TOKEN_EQUAL_EQUAL:
+                case TOKEN_BANG_EQUAL:
+                    return interpretComparison(binary);
+                default:
+                    break;
+            }
+            break;
+        }
+
+        case EXPR_UNARY: {
+            ExprUnary* unary = (ExprUnary*)expr;
+            if (unary->operator == TOKEN_NOT) return !interpretCondition(unary->right);
+            break;
+        }
+
+        case EXPR_IN:
+            return interpretMembership((ExprIn*)expr);
+
+        default:
+            break;
     }
 
-    BigInt result = val.number;
-    BigInt zero = bigint_from_int(0);
+    Value scratch;
+    bool owned;
+    const Value* val = borrowOperand(expr, &scratch, &owned);
+    bool result = expr->staticType == STATIC_NUMBER ? !bigint_is_zero(&val->number)
+                                                    : conditionValue(val);
+    if (owned) freeValue(&scratch);
+    return result;
+}
 
+void interpretBinary(ExprBinary* expr, Value* out) {
     switch (expr->operator) {
+        case TOKEN_PLUS:
         case TOKEN_MINUS:
-            result.sign = -result.sign;
-            return makeValue(VALUE_NUMBER, result);
+        case TOKEN_STAR:
+        case TOKEN_SLASH:
+        case TOKEN_PERCENT:
+        case TOKEN_STAR_STAR:
+            interpretArithmetic(expr, out);
+            break;
+
+        default:
+            out->type = VALUE_NUMBER;
+            out->number = BIGINT_FROM_BOOL(interpretCondition((Expr*)expr));
+            break;
+    }
+}
+
+void interpretUnary(ExprUnary* expr, Value* out) {
+    interpretExpr(expr->right, out);
+
+    if (expr->staticType != STATIC_NUMBER && out->type != VALUE_NUMBER) {
+        ValueType type = out->type;
+        freeValue(out);
+        runtimeError("Unary operator can only be applied to numbers.\n"
+                        "But got value of type '%s'",
+                        typeName(type));
+    }
 
-        case TOKEN_NOT:
-            if (bigint_abs_compare(&result, &zero) == 0)
-                result = bigint_from_int(1);
-            else
-                result = bigint_from_int(0);
-            return makeValue(VALUE_NUMBER, result);
+    switch (expr->operator) {
+        case TOKEN_MINUS:
+            bigint_negate(&out->number);
+            return;
+
+        case TOKEN_NOT: {
+            bool isZero = bigint_is_zero(&out->number);
+            bigint_free(&out->number);
+            out->number = BIGINT_FROM_BOOL(isZero);
+            return;
+        }
     }
 
-    return makeValue(VALUE_NULL, bigint_from_int(0));
+    freeValue(out);
+    out->type = VALUE_NULL;
+    out->number = BIGINT_ZERO;
 }
 
 void saveCategory(RuntimeCategory* cat) {
     Value val = { .type = VALUE_CATEGORY, .category = cat };
-    tableSet(&interp.strings, cat->name, val);
+    setGlobal(&interp.globals, globalSlot(&interp.globals, cat->name), val);
 }
 
-RuntimeCategory* getCategoryByName(ObjString* name) {
-    Value val;
-    if (tableGet(&interp.strings, name, &val) && val.type == VALUE_CATEGORY) {
-        return val.category;
-    } else {
-        runtimeError("Expected a variable of type category after 'in', but got '%s'.", typeName(val.type));
+RuntimeCategory* getCategory(ExprVar* var) {
+    if (var->staticType == STATIC_CATEGORY) return interp.globals.values[var->slot].category;
+
+    Value* val = findVar(var);
+    if (val == NULL || val->type != VALUE_CATEGORY) {
+        runtimeError("Expected a variable of type category after 'in', but got '%s'.",
+                     typeName(val == NULL ? VALUE_NULL : val->type));
     }
 
-    return NULL;
+    return val->category;
 }
 
 bool isObjectInCategory(RuntimeCategory* cat, Value* obj) {
@@ -158,7 +384,7 @@ bool isObjectInCategory(RuntimeCategory* cat, Value* obj) {
         if (obj->type != current->type) continue;
 
         if (obj->type == VALUE_NUMBER) {
-            if (bigint_abs_compare(&current->number, &obj->number) == 0) return true;
+            if (bigint_equal(&current->number, &obj->number)) return true;
         } else if (obj->type == VALUE_CATEGORY) {
             if (current->category == obj->category) return true;
         }
@@ -175,7 +401,7 @@ bool dfs(RuntimeCategory* cat, Value* current, Value* target, bool* visited, int
 
         bool fromMatch = false;
         if (current->type == VALUE_NUMBER) {
-            fromMatch = bigint_abs_compare(&m->from.number, &current->number) == 0;
+            fromMatch = bigint_equal(&m->from.number, &current->number);
         } else if (current->type == VALUE_CATEGORY) {
             fromMatch = m->from.category == current->category;
         }
@@ -191,7 +417,7 @@ bool dfs(RuntimeCategory* cat, Value* current, Value* target, bool* visited, int
             bool targetMatch = false;
             if (typeMatch) {
                 if (target->type == VALUE_NUMBER) {
-                    targetMatch = bigint_abs_compare(&neighbor->number, &target->number) == 0;
+                    targetMatch = bigint_equal(&neighbor->number, &target->number);
                 } else if (target->type == VALUE_CATEGORY) {
                     targetMatch = neighbor->category == target->category;
                 }
@@ -206,7 +432,7 @@ bool dfs(RuntimeCategory* cat, Value* current, Value* target, bool* visited, int
                 if (check->type != neighbor->type) continue;
 
                 if ((check->type == VALUE_NUMBER &&
-                     bigint_abs_compare(&check->number, &neighbor->number) == 0) ||
+                     bigint_equal(&check->number, &neighbor->number)) ||
                     (check->type == VALUE_CATEGORY &&
                      check->category == neighbor->category)) {
                     idx = k;
@@ -234,7 +460,7 @@ bool isMorphismInCategory(RuntimeCategory* cat, Value* from, Value* to) {
         if (val->type != from->type) continue;
 
         if ((val->type == VALUE_NUMBER &&
-             bigint_abs_compare(&val->number, &from->number) == 0) ||
+             bigint_equal(&val->number, &from->number)) ||
             (val->type == VALUE_CATEGORY &&
              val->category == from->category)) {
             visited[i] = true;
@@ -245,52 +471,63 @@ bool isMorphismInCategory(RuntimeCategory* cat, Value* from, Value* to) {
     return dfs(cat, from, to, visited, count);
 }
 
-Value interpretIn(ExprIn* expr) {
+void internValue(Value* val) {
+    if (val->type == VALUE_NUMBER) val->number = internNumber(val->number);
+}
+
+// Borrows the interned copy of a number so category lookups compare words.
+// Everything stored in a category is interned, so a number without an
+// interned copy cannot be in one.
+bool canonicalValue(const Value* val, Value* canonical) {
+    *canonical = *val;
+    if (val->type != VALUE_NUMBER) return true;
+    return findInternedNumber(&val->number, &canonical->number);
+}
+
+bool interpretMembership(ExprIn* expr) {
     if (expr->name->type != EXPR_VAR) {
         runtimeError("Expected a variable of type after 'in'.");
     }
 
-    ObjString* name = ((ExprVar*)expr->name)->name;
-    RuntimeCategory* cat = getCategoryByName(name);
+    RuntimeCategory* cat = getCategory(expr->name);
+    bool result;
 
     if (expr->element->type == EXPR_MORPHISM) {
         ExprMorphism* morph = (ExprMorphism*)expr->element;
-        Value fromVal = interpretExpr(morph->from);
-        Value toVal   = interpretExpr(morph->to);
-        
-        bool result = valuesEqual(fromVal, toVal)
-            ? isObjectInCategory(cat, &fromVal)
-            : isMorphismInCategory(cat, &fromVal, &toVal);
-
-        return makeValue(VALUE_NUMBER, bigint_from_int(result));
+        Value fromScratch, toScratch;
+        bool fromOwned, toOwned;
+        const Value* fromVal = borrowOperand(morph->from, &fromScratch, &fromOwned);
+        bool held = fromOwned && holdValue(&fromScratch);
+        const Value* toVal   = borrowOperand(morph->to, &toScratch, &toOwned);
+        unholdValue(held);
+
+        Value from, to;
+        result = canonicalValue(fromVal, &from) && canonicalValue(toVal, &to) &&
+            (valuesEqual(from, to)
+                ? isObjectInCategory(cat, &from)
+                : isMorphismInCategory(cat, &from, &to));
+
+        if (fromOwned) freeValue(&fromScratch);
+        if (toOwned) freeValue(&toScratch);
     } else {
-        Value objVal = interpretExpr(expr->element);
+        Value objScratch;
+        bool objOwned;
+        const Value* objVal = borrowOperand(expr->element, &objScratch, &objOwned);
 
-        bool result = isObjectInCategory(cat, &objVal);
-        return makeValue(VALUE_NUMBER, bigint_from_int(result));
+        Value obj;
+        result = canonicalValue(objVal, &obj) && isObjectInCategory(cat, &obj);
+        if (objOwned) freeValue(&objScratch);
     }
-}
-
-
-void freeRuntimeCategory(RuntimeCategory* cat) {
-    if (!cat) return;
 
-    if (cat->objects.values) {
-        free(cat->objects.values);
-    }
-
-    if (cat->homset.morphisms) {
-        for (int i = 0; i < cat->homset.count; ++i) {
-            if (cat->homset.morphisms[i].to) {
-                free(cat->homset.morphisms[i].to);
-            }
-        }
-        free(cat->homset.morphisms);
-    }
+    return result;
+}
 
-    free(cat);
+void interpretIn(ExprIn* expr, Value* out) {
+    out->type = VALUE_NUMBER;
+    out->number = BIGINT_FROM_BOOL(interpretMembership(expr));
 }
 
+
 bool listContainsValue(ObjectList list, Value value) {
     for (int i = 0; i < list.count; ++i) {
         if (valuesEqual(list.values[i], value)) {
@@ -303,9 +540,12 @@ bool listContainsValue(ObjectList list, Value value) {
 
 void invalidMorphism(Table table, Value val) {
     if(val.type == VALUE_NUMBER) {
-        char buf[BIGINT_MAX_DIGITS];
-        bigint_to_str_buf(&val.number, buf, sizeof(buf));
-        runtimeError("Undeclared object %s of type 'Number' inside morphism.", buf);
+        // The digits are heap allocated, so report before unwinding
+        char* buf = bigint_to_str(&val.number);
+        flushOutput(&interp.out);
+        fprintf(stderr, "Undeclared object %s of type 'Number' inside morphism.\n", buf);
+        free(buf);
+        longjmp(interp.errJmpBuf, 1);
     }
     else {
         ObjString* key = tableFindKey(&table, val);
@@ -313,9 +553,55 @@ void invalidMorphism(Table table, Value val) {
     }
 }
 
+// Room for everything a template builds on its own
+static size_t categorySize(CategoryTemplate* cat) {
+    return sizeof(RuntimeCategory) + sizeof(Value) * cat->objects.count +
+           sizeof(Morphism) * cat->homset.count + sizeof(Value) * cat->toCount;
+}
+
+// Replaces each nested category among the objects with its objects, and
+// copies its morphisms in ahead of the template's own
+static void spliceNested(RuntimeCategory* runtimeCat, int objectCount, Value** targets) {
+    Value* objects = arenaAlloc(&runtimeCat->arena, sizeof(Value) * objectCount);
+    int count = 0;
+
+    for (int i = 0; i < runtimeCat->objects.count; i++) {
+        Value val = runtimeCat->objects.values[i];
+        if (val.type != VALUE_CATEGORY) {
+            objects[count++] = val;
+            continue;
+        }
+
+        RuntimeCategory* nested = val.category;
+        for (int j = 0; j < nested->objects.count; j++) {
+            objects[count++] = copyValue(nested->objects.values[j]);
+        }
+
+        for (int j = 0; j < nested->homset.count; j++) {
+            Morphism* src = &nested->homset.morphisms[j];
+            Morphism* dest = &runtimeCat->homset.morphisms[runtimeCat->homset.count++];
+            dest->from = copyValue(src->from);
+            dest->toCount = src->toCount;
+            dest->to = *targets;
+            *targets += src->toCount;
+            for (int k = 0; k < src->toCount; k++) {
+                dest->to[k] = copyValue(src->to[k]);
+            }
+        }
+
+        freeValue(&val);
+    }
+
+    runtimeCat->objects.values = objects;
+    runtimeCat->objects.count = count;
+}
+
 void interpretCategory(ExprCatInit* expr, ObjString* varName) {
-    Value tmplVal;
-    if (!tableGet(&interp.strings, expr->callee, &tmplVal) || tmplVal.type != VALUE_CAT_TEMPLATE) {
+    int tmplSlot = findGlobalSlot(&interp.globals, expr->callee);
+    Value tmplVal = { .type = VALUE_NULL };
+    if (tmplSlot >= 0) tmplVal = interp.globals.values[tmplSlot];
+
+    if (tmplVal.type != VALUE_CAT_TEMPLATE) {
         runtimeError("Expected a variable of type 'Category Template', but got '%.*s' of type '%s'.",
                      expr->callee->length, expr->callee->chars, typeName(tmplVal.type));
     }
@@ -326,29 +612,15 @@ void interpretCategory(ExprCatInit* expr, ObjString* varName) {
                         cat->name->chars, varName->chars);
     }
 
-    Table globalStrings = interp.strings;
-
-    Table templateArgs;
-    initTable(&templateArgs);
-
-    // Set up rollback
-    jmp_buf originalBuf;
-    memcpy(&originalBuf, &interp.errJmpBuf, sizeof(jmp_buf));
-
-    RuntimeCategory* runtimeCat = NULL;
-
-    if (setjmp(interp.errJmpBuf) != 0) {
-        // An error occurred, free temp state
-        interp.strings = globalStrings;
-        freeTable(&templateArgs, false);
-        freeRuntimeCategory(runtimeCat);  // safe even if NULL
-        memcpy(&interp.errJmpBuf, &originalBuf, sizeof(jmp_buf));
-        longjmp(interp.errJmpBuf, 1);
-    }
+    // Everything built from here on is reachable from interp, so an error
+    // unwinds straight to the top and abortStatement frees it there
+    Table* templateArgs = &interp.argTable;
 
     // Interpret arguments
     for (int i = 0; i < expr->argCount; ++i) {
-        Value value = interpretExpr(expr->args[i]);
+        Value value;
+        interpretExpr(expr->args[i], &value);
+        tableSet(templateArgs, cat->params[i], value);
 
         switch (value.type) {
             case VALUE_CAT_TEMPLATE:    runtimeError("Cannot pass variable '%s' of type '%s' to Category Template '%s'.",
@@ -356,110 +628,99 @@ void interpretCategory(ExprCatInit* expr, ObjString* varName) {
             // case VALUE_CATEGORY:        runtimeError("Cannot pass variable '%s' of type '%s' to Category Template '%s'.",
             //                                 value.category->name->chars, typeName(value.type), tmplVal.template->name->chars);
         }
-
-        tableSet(&templateArgs, cat->params[i], value);
     }
 
-    interp.strings = templateArgs;
-
-    runtimeCat = malloc(sizeof(RuntimeCategory));
-    runtimeCat->objects.values = NULL;
-    runtimeCat->homset.morphisms = NULL;
-    runtimeCat->name = varName;
+    interp.args = templateArgs;
 
-    // Objects
-    int objCapacity = cat->objects.count;
-    int morphCapacity = cat->homset.count;
+    // One block holds the category when it nests no others
+    Arena arena;
+    initArena(&arena);
+    arenaReserve(&arena, categorySize(cat));
 
+    RuntimeCategory* runtimeCat = arenaAlloc(&arena, sizeof(RuntimeCategory));
+    runtimeCat->arena = arena;
+    runtimeCat->refs = 1;
+    runtimeCat->name = varName;
+    runtimeCat->objects.values = arenaAlloc(&runtimeCat->arena, sizeof(Value) * cat->objects.count);
     runtimeCat->objects.count = 0;
+    runtimeCat->homset.morphisms = NULL;
     runtimeCat->homset.count = 0;
+    interp.building = runtimeCat;
 
-    runtimeCat->objects.values = malloc(sizeof(Value) * objCapacity);
-    runtimeCat->homset.morphisms = malloc(sizeof(Morphism) * morphCapacity);
+    // Objects, with nested categories left in place until their sizes are in
+    int objectCount = 0;
+    int morphCount = cat->homset.count;
+    int toCount = cat->toCount;
+    bool nested = false;
 
     for (int i = 0; i < cat->objects.count; i++) {
-        Value val = interpretExpr(cat->objects.values[i]);
-
-        if (runtimeCat->objects.count >= objCapacity) {
-            objCapacity *= 2;
-            runtimeCat->objects.values = realloc(runtimeCat->objects.values, sizeof(Value) * objCapacity);
-        }
-
-        if (val.type == VALUE_CATEGORY) {
-            RuntimeCategory* nested = val.category;
-
-            // Copy objects
-            for (int j = 0; j < nested->objects.count; j++) {
-                if (runtimeCat->objects.count >= objCapacity) {
-                    objCapacity *= 2;
-                    runtimeCat->objects.values = realloc(runtimeCat->objects.values, sizeof(Value) * objCapacity);
-                }
-                runtimeCat->objects.values[runtimeCat->objects.count++] = nested->objects.values[j];
-            }
-
-            // Copy morphisms
-            for (int j = 0; j < nested->homset.count; j++) {
-                if (runtimeCat->homset.count >= morphCapacity) {
-                    morphCapacity *= 2;
-                    runtimeCat->homset.morphisms = realloc(runtimeCat->homset.morphisms, sizeof(Morphism) * morphCapacity);
-                }
-
-                Morphism* src = &nested->homset.morphisms[j];
-                Morphism* dest = &runtimeCat->homset.morphisms[runtimeCat->homset.count++];
-                dest->from = src->from;
-                dest->toCount = src->toCount;
-                dest->to = malloc(sizeof(Value) * src->toCount);
-                for (int k = 0; k < src->toCount; k++) {
-                    dest->to[k] = src->to[k];
-                }
+        Value* val = &runtimeCat->objects.values[runtimeCat->objects.count];
+        interpretExpr(cat->objects.values[i], val);
+        runtimeCat->objects.count++;
+
+        if (val->type == VALUE_CATEGORY) {
+            RuntimeCategory* inner = val->category;
+            objectCount += inner->objects.count;
+            morphCount += inner->homset.count;
+            for (int j = 0; j < inner->homset.count; j++) {
+                toCount += inner->homset.morphisms[j].toCount;
             }
-
+            nested = true;
         } else {
-            runtimeCat->objects.values[runtimeCat->objects.count++] = val;
+            internValue(val);
+            objectCount++;
         }
     }
 
+    runtimeCat->homset.morphisms = arenaAlloc(&runtimeCat->arena, sizeof(Morphism) * morphCount);
+    Value* targets = arenaAlloc(&runtimeCat->arena, sizeof(Value) * toCount);
+
+    if (nested) spliceNested(runtimeCat, objectCount, &targets);
+
     // Now copy morphisms from the category template
     for (int i = 0; i < cat->homset.count; i++) {
-        if (runtimeCat->homset.count >= morphCapacity) {
-            morphCapacity *= 2;
-            runtimeCat->homset.morphisms = realloc(runtimeCat->homset.morphisms, sizeof(Morphism) * morphCapacity);
-        }
-
         TmplAdjMorphisms* src = &cat->homset.morphisms[i];
-        Morphism* dest = &runtimeCat->homset.morphisms[runtimeCat->homset.count++];
+        Morphism* dest = &runtimeCat->homset.morphisms[runtimeCat->homset.count];
         memset(dest, 0, sizeof(Morphism));
 
-        dest->from = interpretExpr(src->from);
+        // Counted only once its source is in, like its targets below
+        interpretExpr(src->from, &dest->from);
+        runtimeCat->homset.count++;
+        internValue(&dest->from);
         if (!listContainsValue(runtimeCat->objects, dest->from)) {
-            invalidMorphism(templateArgs, dest->from);
+            invalidMorphism(*templateArgs, dest->from);
         }
 
-        dest->toCount = src->toCount;
-        dest->to = malloc(sizeof(Value) * src->toCount);
+        dest->to = targets;
+        targets += src->toCount;
 
+        // Count as we go so a failed lookup only rolls back what was built
         for (int j = 0; j < src->toCount; j++) {
-            dest->to[j] = interpretExpr(src->to[j]);
+            interpretExpr(src->to[j], &dest->to[j]);
+            dest->toCount++;
+            internValue(&dest->to[j]);
             if (!listContainsValue(runtimeCat->objects, dest->to[j])) {
-                invalidMorphism(templateArgs, dest->to[j]);
+                invalidMorphism(*templateArgs, dest->to[j]);
             }
         }
     }
 
-    // Final trim
-    objCapacity = runtimeCat->objects.count;
-    runtimeCat->objects.values = realloc(runtimeCat->objects.values, sizeof(Value) * objCapacity);
-    morphCapacity = runtimeCat->homset.count;
-    runtimeCat->homset.morphisms = realloc(runtimeCat->homset.morphisms, sizeof(Morphism) * morphCapacity);
-
-
     // Done successfully
-    interp.strings = globalStrings;
-    freeTable(&templateArgs, false);
+    interp.args = NULL;
+    interp.building = NULL;
+    tableClear(templateArgs);
     saveCategory(runtimeCat);
+}
 
-    // Restore old jump buffer (important!)
-    memcpy(&interp.errJmpBuf, &originalBuf, sizeof(jmp_buf));
+void abortStatement() {
+    while (interp.heldCount > 0) {
+        freeValue(&interp.held[--interp.heldCount]);
+    }
+
+    interp.args = NULL;
+    tableClear(&interp.argTable);
+    freeCategory(interp.building);  // safe even if NULL
+    interp.building = NULL;
 }
 
 
@@ -471,40 +732,98 @@ void interpretCategoryTemplate(StmtCat* cat) {
     templ->paramCount = cat->paramCount;
     templ->objects = cat->objects;
     templ->homset = cat->homset;
+    templ->toCount = 0;
+    for (int i = 0; i < cat->homset.count; i++) {
+        templ->toCount += cat->homset.morphisms[i].toCount;
+    }
+    templ->ast = cat->ast;
+    templ->refs = 1;
+    retainAst(cat->ast);
 
     Value val = {
         .type = VALUE_CAT_TEMPLATE,
         .template = templ
     };
 
-    tableSet(&interp.strings, templ->name, val);
+    setGlobal(&interp.globals, globalSlot(&interp.globals, templ->name), val);
 }
 
-Value interpretNumber(ExprNumber* expr) {
-    return makeValue(VALUE_NUMBER, expr->value);
+void interpretNumber(ExprNumber* expr, Value* out) {
+    out->type = VALUE_NUMBER;
+    out->number = bigint_copy(&expr->value);
 }
 
-Value interpretVar(ExprVar* expr) {
-    Value val;
-    if (!tableGet(&interp.strings, expr->name, &val) || val.type == VALUE_NULL) {
-        runtimeError("Undefined variable '%.*s'.", expr->name->length, expr->name->chars);
-    }
-    return val;
+void interpretVar(ExprVar* expr, Value* out) {
+    *out = copyValue(*lookupVar(expr));
 }
 
-Value interpretExpr(Expr* expr) {
+// Evaluates into a caller-provided slot, which then owns the result
+void interpretExpr(Expr* expr, Value* out) {
     switch (expr->type) {
-        case EXPR_BINARY:  return interpretBinary((ExprBinary*)expr);
-        case EXPR_UNARY:   return interpretUnary((ExprUnary*)expr);
-        case EXPR_NUMBER:  return interpretNumber((ExprNumber*)expr);
-        case EXPR_VAR:     return interpretVar((ExprVar*)expr);
-        case EXPR_IN:      return interpretIn((ExprIn*)expr);
+        case EXPR_BINARY:  interpretBinary((ExprBinary*)expr, out); return;
+        case EXPR_UNARY:   interpretUnary((ExprUnary*)expr, out); return;
+        case EXPR_POWMOD:  interpretPowMod((ExprPowMod*)expr, out); return;
+        case EXPR_NUMBER:  interpretNumber((ExprNumber*)expr, out); return;
+        case EXPR_VAR:     interpretVar((ExprVar*)expr, out); return;
+        case EXPR_IN:      interpretIn((ExprIn*)expr, out); return;
+    }
+    out->type = VALUE_NULL;
+    out->number = BIGINT_ZERO;
+}
+
+// A constant or global operand of a counted loop, or NULL if it does not
+// hold an inline integer
+static const BigInt* smallOperand(Expr* expr) {
+    const BigInt* num;
+    if (expr->type == EXPR_NUMBER) {
+        num = &((ExprNumber*)expr)->value;
+    } else {
+        int slot = ((ExprVar*)expr)->slot;
+        if (slot < 0 || interp.globals.values[slot].type != VALUE_NUMBER) return NULL;
+        num = &interp.globals.values[slot].number;
     }
-    return makeValue(VALUE_NULL, bigint_from_int(0));
+    return BIGINT_IS_SMALL(num) ? num : NULL;
+}
+
+// `i = i + x` on inline integers, updated in its slot. Returns false, having
+// done nothing, for anything the general path has to handle.
+static bool stepCounter(StmtAssign* stmt) {
+    ExprBinary* step = (ExprBinary*)stmt->right;
+    const BigInt* counter = smallOperand((Expr*)stmt->left);
+    const BigInt* by = smallOperand(step->right);
+    if (counter == NULL || by == NULL) return false;
+
+    int64_t a = BIGINT_SMALL_VALUE(counter);
+    int64_t b = BIGINT_SMALL_VALUE(by);
+    int64_t result = step->operator == TOKEN_PLUS ? a + b : a - b;
+    if (result < BIGINT_SMALL_MIN || result > BIGINT_SMALL_MAX) return false;
+
+    interp.globals.values[stmt->left->slot].number = BIGINT_SMALL(result);
+    return true;
+}
+
+// `i < n` and the like on inline integers, compared where they live.
+// Returns false when the general path has to evaluate the test.
+static bool testCounter(ExprBinary* test, bool* result) {
+    const BigInt* counter = smallOperand(test->left);
+    const BigInt* bound = smallOperand(test->right);
+    if (counter == NULL || bound == NULL) return false;
+
+    int64_t x = BIGINT_SMALL_VALUE(counter);
+    int64_t y = BIGINT_SMALL_VALUE(bound);
+    switch (test->operator) {
+        case TOKEN_LESS:        *result = x < y; break;
+        case TOKEN_GREATER:     *result = x > y; break;
+        case TOKEN_EQUAL_EQUAL: *result = x == y; break;
+        default:                *result = x != y; break;
+    }
+    return true;
 }
 
 void interpretAssign(StmtAssign* stmt) {
     ExprVar* exprVar = (ExprVar*)stmt->left;
+    if (isCounterStep(stmt) && stepCounter(stmt)) return;
+
     ObjString* varName = exprVar->name;
 
     if (stmt->right->type == EXPR_CAT_INIT) {
@@ -512,34 +831,32 @@ void interpretAssign(StmtAssign* stmt) {
         
         interpretCategory(init, varName);
     } else {
-        Value val = interpretExpr(stmt->right);
-        switch (val.type) {
-            case VALUE_CAT_TEMPLATE:    runtimeError("Cannot assign variable '%s' of type '%s'.",
-                                            val.template->name->chars, typeName(val.type));
-            case VALUE_CATEGORY:        runtimeError("Cannot assign variable '%s' of type '%s'.",
-                                            val.category->name->chars, typeName(val.type));
+        Value val;
+        interpretExpr(stmt->right, &val);
+        if (stmt->right->staticType != STATIC_NUMBER) {
+            bool held = holdValue(&val);
+            checkStorable(&val, "assign");
+            unholdValue(held);
         }
-        tableSet(&interp.strings, varName, val);
+        setGlobal(&interp.globals, exprVar->slot, val);
     }
 }
 
 void interpretPrint(StmtPrint* stmt) {
-    Value val = interpretExpr(stmt->expr);
-    switch (val.type) {
-        case VALUE_CAT_TEMPLATE:    runtimeError("Cannot print variable '%s' of type '%s'.",
-                                        val.template->name->chars, typeName(val.type));
-        case VALUE_CATEGORY:        runtimeError("Cannot print variable '%s' of type '%s'.",
-                                        val.category->name->chars, typeName(val.type));
+    Value val;
+    interpretExpr(stmt->expr, &val);
+    if (stmt->expr->staticType != STATIC_NUMBER) {
+        bool held = holdValue(&val);
+        checkStorable(&val, "print");
+        unholdValue(held);
     }
-    bigint_print(&val.number);
-    putchar('\n');
+    writeNumber(&interp.out, &val.number);
+    writeNewline(&interp.out);
+    freeValue(&val);
 }
 
 void interpretIf(StmtIf* stmt) {
-    Value val = interpretExpr(stmt->condition);
-    BigInt zero = bigint_from_int(0);
-
-    if (bigint_abs_compare(&val.number, &zero) != 0) {
+    if (interpretCondition(stmt->condition)) {
         interpret(stmt->thenBranch);
     } else {
         interpret(stmt->elseBranch);
@@ -547,12 +864,17 @@ void interpretIf(StmtIf* stmt) {
 }
 
 void interpretWhile(StmtWhile* stmt) {
-    Value val = interpretExpr(stmt->condition);
-    BigInt zero = bigint_from_int(0);
+    ExprBinary* counted = isCountedTest(stmt->condition) ? (ExprBinary*)stmt->condition : NULL;
 
-    while (bigint_abs_compare(&val.number, &zero) != 0) {
+    for (;;) {
+        if (interp.jit != JIT_OFF && runJitLoop(stmt)) return;
+
+        bool result;
+        if (counted == NULL || !testCounter(counted, &result)) {
+            result = interpretCondition(stmt->condition);
+        }
+        if (!result) return;
         interpret(stmt->body);
-        val = interpretExpr(stmt->condition);
     }
 }
 
@@ -575,11 +897,35 @@ void interpret(Stmt* stmts) {
     }
 }
 
-void runInterp(Stmt* stmts) {
+void runInterp(Ast* ast) {
+    Stmt* stmts = ast->stmts;
+    resolve(stmts);
+
+    if (!inferTypes(stmts)) {
+        fprintf(stderr, "Type error found before running. Aborting interpretation.\n");
+        return;
+    }
+
+    Chunk chunk;
+    initChunk(&chunk);
+
+    if (interp.engine == ENGINE_VM && !compile(ast, &chunk)) {
+        freeChunk(&chunk);
+        return;
+    }
+
     if (setjmp(interp.errJmpBuf) == 0) {
-        interpret(stmts);
+        if (interp.engine == ENGINE_VM) {
+            runVM(&chunk);
+        } else {
+            interpret(stmts);
+        }
     } else {
         // Jumped here from runtimeError
+        abortStatement();
+        freeVM();
         fprintf(stderr, "Runtime error occurred. Aborting interpretation.\n");
     }
+
+    freeChunk(&chunk);
 }
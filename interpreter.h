@@ -2,15 +2,33 @@
 #define cryton_interpreter_h
 
 #include "bigint.h"
+#include "jit.h"
+#include "output.h"
 #include "table.h"
 #include "parser.h"
 #include <stdlib.h>
 #include <stdarg.h>
 #include <setjmp.h>
 
+typedef enum {
+    ENGINE_VM,      // Compile to bytecode and run it
+    ENGINE_TREE     // Walk the syntax tree directly
+} Engine;
+
 typedef struct {
-    Table strings;
+    Engine engine;
+    JitMode jit;
+    StringSet strings;
+    Globals globals;
+    Table* args;        // Parameters of the category being created, or NULL
+    Table argTable;     // Storage for args, kept from one category to the next
+    RuntimeCategory* building;  // The category being created, or NULL
+    Value* held;        // Owned operands the tree walker keeps while it
+    int heldCount;      // evaluates another one that may raise
+    int heldCapacity;
+    NumberSet numbers;
     jmp_buf errJmpBuf;
+    Output out;
 } Interp;
 
 
@@ -23,8 +41,25 @@ typedef struct {
     int categoryCount;
 } Runtime;
 
-void initInterp();
+void initInterp(OutputMode outputMode, Engine engine, JitMode jit);
 void freeInterp();
-void runInterp(Stmt* stmts);
+void runInterp(Ast* ast);
+
+// Shared with the bytecode VM, which defers to the tree walker for categories
+void runtimeError(const char* format, ...);
+const char* typeName(ValueType type);
+bool conditionValue(const Value* val);
+void binaryTypeError(Value* left, bool leftOwned, Value* right, bool rightOwned);
+void checkStorable(const Value* value, const char* action);
+RuntimeCategory* getCategory(ExprVar* var);
+bool isObjectInCategory(RuntimeCategory* cat, Value* obj);
+bool isMorphismInCategory(RuntimeCategory* cat, Value* from, Value* to);
+bool canonicalValue(const Value* val, Value* canonical);
+void interpretCategory(ExprCatInit* expr, ObjString* varName);
+// Frees what a statement interrupted by a runtime error was holding: held
+// operands, template arguments and a half-built category. Called wherever
+// errJmpBuf lands.
+void abortStatement();
+void interpretCategoryTemplate(StmtCat* cat);
 
 #endif
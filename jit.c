@@ -0,0 +1,490 @@
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "interpreter.h"
+#include "jit.h"
+
+#ifdef JIT_AVAILABLE
+    #include <sys/mman.h>
+#endif
+
+// Times the head of a loop runs in the interpreter before it is compiled
+#define HOT_LOOP 1000
+// A loop that keeps leaving native code goes back to the interpreter for good
+#define MAX_BAILOUTS 16
+
+#ifdef JIT_AVAILABLE
+
+static bool supportsExpr(Expr* expr) {
+    switch (expr->type) {
+        case EXPR_NUMBER:
+            return BIGINT_IS_SMALL(&((ExprNumber*)expr)->value);
+
+        case EXPR_VAR:
+            return ((ExprVar*)expr)->slot >= 0;
+
+        case EXPR_UNARY:
+            return supportsExpr(((ExprUnary*)expr)->right);
+
+        case EXPR_BINARY: {
+            ExprBinary* binary = (ExprBinary*)expr;
+            switch (binary->operator) {
+                case TOKEN_PLUS:
+                case TOKEN_MINUS:
+                case TOKEN_STAR:
+                case TOKEN_LESS:
+                case TOKEN_GREATER:
+                case TOKEN_EQUAL_EQUAL:
+                case TOKEN_BANG_EQUAL:
+                case TOKEN_AND:
+                case TOKEN_OR:
+                    return supportsExpr(binary->left) && supportsExpr(binary->right);
+                default:
+                    return false;
+            }
+        }
+
+        default:
+            return false;
+    }
+}
+
+static bool supportsStmts(Stmt* stmt) {
+    for (; stmt != NULL; stmt = stmt->next) {
+        switch (stmt->type) {
+            case STMT_ASSIGN:
+                if (!supportsExpr(((StmtAssign*)stmt)->right)) return false;
+                break;
+
+            case STMT_IF: {
+                StmtIf* ifStmt = (StmtIf*)stmt;
+                if (!supportsExpr(ifStmt->condition) ||
+                    !supportsStmts(ifStmt->thenBranch) ||
+                    !supportsStmts(ifStmt->elseBranch)) return false;
+                break;
+            }
+
+            case STMT_WHILE: {
+                StmtWhile* whileStmt = (StmtWhile*)stmt;
+                if (!supportsExpr(whileStmt->condition) || !supportsStmts(whileStmt->body)) return false;
+                break;
+            }
+
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+#endif
+
+bool jitSupports(StmtWhile* stmt) {
+#ifdef JIT_AVAILABLE
+    return supportsExpr(stmt->condition) && supportsStmts(stmt->body);
+#else
+    (void)stmt;
+    return false;
+#endif
+}
+
+void freeJitLoop(JitLoop* loop) {
+    if (loop == NULL) return;
+
+#ifdef JIT_AVAILABLE
+    if (loop->memory != NULL) munmap(loop->memory, loop->size);
+#endif
+    free(loop->slots);
+    free(loop->assigned);
+    free(loop->frame);
+    free(loop);
+}
+
+#ifdef JIT_AVAILABLE
+
+// The generated function keeps every variable in the working frame at rdi,
+// evaluates expressions in rax with rcx and rdx as scratch and the machine
+// stack for temporaries. An iteration that finishes is copied to the
+// committed frame at rsi. Overflow anywhere abandons the iteration, so the
+// interpreter can redo it from the committed values with big integers.
+typedef struct {
+    uint8_t* code;
+    int count;
+    int capacity;
+
+    int* bailouts;      // rel32 operands that jump to the bailout exit
+    int bailoutCount;
+    int bailoutCapacity;
+
+    JitLoop* loop;
+} Assembler;
+
+static Assembler as;
+
+enum {
+    JO  = 0x80,
+    JZ  = 0x84,
+    JNZ = 0x85,
+
+    SETE  = 0x94,
+    SETNE = 0x95,
+    SETL  = 0x9c,
+    SETG  = 0x9f
+};
+
+static void emitByte(uint8_t byte) {
+    if (as.count + 1 > as.capacity) {
+        as.capacity = as.capacity < 256 ? 256 : as.capacity * 2;
+        as.code = realloc(as.code, as.capacity);
+    }
+    as.code[as.count++] = byte;
+}
+
+static void emit(int count, ...) {
+    va_list args;
+    va_start(args, count);
+    for (int i = 0; i < count; ++i) {
+        emitByte((uint8_t)va_arg(args, int));
+    }
+    va_end(args);
+}
+
+static void emit32(uint32_t value) {
+    for (int i = 0; i < 4; ++i) emitByte((value >> (8 * i)) & 0xff);
+}
+
+static void emit64(uint64_t value) {
+    for (int i = 0; i < 8; ++i) emitByte((value >> (8 * i)) & 0xff);
+}
+
+static void patch32(int offset, uint32_t value) {
+    for (int i = 0; i < 4; ++i) as.code[offset + i] = (value >> (8 * i)) & 0xff;
+}
+
+// Returns the offset of the rel32 operand, patched with patchJump
+static int emitJump(uint8_t condition) {
+    if (condition == 0) {
+        emitByte(0xe9);
+    } else {
+        emit(2, 0x0f, condition);
+    }
+    emit32(0);
+    return as.count - 4;
+}
+
+static void patchJump(int offset) {
+    patch32(offset, as.count - (offset + 4));
+}
+
+static void emitLoop(int target) {
+    emitByte(0xe9);
+    emit32(target - (as.count + 4));
+}
+
+static void emitBailout(uint8_t condition) {
+    if (as.bailoutCount + 1 > as.bailoutCapacity) {
+        as.bailoutCapacity = as.bailoutCapacity < 8 ? 8 : as.bailoutCapacity * 2;
+        as.bailouts = realloc(as.bailouts, sizeof(int) * as.bailoutCapacity);
+    }
+    as.bailouts[as.bailoutCount++] = emitJump(condition);
+}
+
+// Each variable gets a frame entry the first time the loop mentions it
+static int frameOffset(int slot) {
+    JitLoop* loop = as.loop;
+
+    int index = 0;
+    while (index < loop->varCount && loop->slots[index] != slot) index++;
+
+    if (index == loop->varCount) {
+        loop->varCount++;
+        loop->slots = realloc(loop->slots, sizeof(int) * loop->varCount);
+        loop->assigned = realloc(loop->assigned, sizeof(bool) * loop->varCount);
+        loop->slots[index] = slot;
+        loop->assigned[index] = false;
+    }
+    return index * 8;
+}
+
+static void testRax() {
+    emit(3, 0x48, 0x85, 0xc0);                  // test rax, rax
+}
+
+// rax = flag ? 1 : 0
+static void setRax(uint8_t flag) {
+    emit(3, 0x0f, flag, 0xc0);                  // setcc al
+    emit(3, 0x0f, 0xb6, 0xc0);                  // movzx eax, al
+}
+
+static void expression(Expr* expr);
+
+static void logical(ExprBinary* expr) {
+    expression(expr->left);
+    testRax();
+
+    if (expr->operator == TOKEN_AND) {
+        int isFalse = emitJump(JZ);             // rax is already 0
+        expression(expr->right);
+        testRax();
+        setRax(SETNE);
+        patchJump(isFalse);
+    } else {
+        int right = emitJump(JZ);
+        emit(5, 0xb8, 1, 0, 0, 0);              // mov eax, 1
+        int end = emitJump(0);
+        patchJump(right);
+        expression(expr->right);
+        testRax();
+        setRax(SETNE);
+        patchJump(end);
+    }
+}
+
+static void binary(ExprBinary* expr) {
+    if (expr->operator == TOKEN_AND || expr->operator == TOKEN_OR) {
+        logical(expr);
+        return;
+    }
+
+    expression(expr->left);
+    emitByte(0x50);                             // push rax
+    expression(expr->right);
+    emit(3, 0x48, 0x89, 0xc1);                  // mov rcx, rax
+    emitByte(0x58);                             // pop rax
+
+    switch (expr->operator) {
+        case TOKEN_PLUS:
+            emit(3, 0x48, 0x01, 0xc8);          // add rax, rcx
+            emitBailout(JO);
+            break;
+
+        case TOKEN_MINUS:
+            emit(3, 0x48, 0x29, 0xc8);          // sub rax, rcx
+            emitBailout(JO);
+            break;
+
+        case TOKEN_STAR:
+            emit(4, 0x48, 0x0f, 0xaf, 0xc1);    // imul rax, rcx
+            emitBailout(JO);
+            break;
+
+        default:
+            emit(3, 0x48, 0x39, 0xc8);          // cmp rax, rcx
+            setRax(expr->operator == TOKEN_LESS    ? SETL :
+                   expr->operator == TOKEN_GREATER ? SETG :
+                   expr->operator == TOKEN_EQUAL_EQUAL ? SETE : SETNE);
+            break;
+    }
+}
+
+static void expression(Expr* expr) {
+    switch (expr->type) {
+        case EXPR_NUMBER:
+            emit(2, 0x48, 0xb8);                // mov rax, imm64
+            emit64((uint64_t)BIGINT_SMALL_VALUE(&((ExprNumber*)expr)->value));
+            break;
+
+        case EXPR_VAR:
+            emit(3, 0x48, 0x8b, 0x87);          // mov rax, [rdi + disp32]
+            emit32(frameOffset(((ExprVar*)expr)->slot));
+            break;
+
+        case EXPR_UNARY:
+            expression(((ExprUnary*)expr)->right);
+            if (((ExprUnary*)expr)->operator == TOKEN_MINUS) {
+                emit(3, 0x48, 0xf7, 0xd8);      // neg rax
+                emitBailout(JO);
+            } else {
+                testRax();
+                setRax(SETE);
+            }
+            break;
+
+        case EXPR_BINARY:
+            binary((ExprBinary*)expr);
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void statements(Stmt* stmt);
+
+// Loop conditions and if conditions are true when nonzero
+static int emitCondition(Expr* condition) {
+    expression(condition);
+    testRax();
+    return emitJump(JZ);
+}
+
+static void assignStmt(StmtAssign* stmt) {
+    expression(stmt->right);
+
+    // Only values that fit inline may be stored back
+    emit(3, 0x48, 0x89, 0xc2);                  // mov rdx, rax
+    emit(4, 0x48, 0xc1, 0xe2, 64 - BIGINT_SMALL_BITS);  // shl rdx, 2
+    emit(4, 0x48, 0xc1, 0xfa, 64 - BIGINT_SMALL_BITS);  // sar rdx, 2
+    emit(3, 0x48, 0x39, 0xc2);                  // cmp rdx, rax
+    emitBailout(JNZ);
+
+    int offset = frameOffset(stmt->left->slot);
+    as.loop->assigned[offset / 8] = true;
+    emit(3, 0x48, 0x89, 0x87);                  // mov [rdi + disp32], rax
+    emit32(offset);
+}
+
+static void ifStmt(StmtIf* stmt) {
+    int elseJump = emitCondition(stmt->condition);
+    statements(stmt->thenBranch);
+
+    if (stmt->elseBranch == NULL) {
+        patchJump(elseJump);
+        return;
+    }
+
+    int end = emitJump(0);
+    patchJump(elseJump);
+    statements(stmt->elseBranch);
+    patchJump(end);
+}
+
+static void whileStmt(StmtWhile* stmt) {
+    int loopStart = as.count;
+    int exit = emitCondition(stmt->condition);
+    statements(stmt->body);
+    emitLoop(loopStart);
+    patchJump(exit);
+}
+
+static void statements(Stmt* stmt) {
+    for (; stmt != NULL; stmt = stmt->next) {
+        switch (stmt->type) {
+            case STMT_ASSIGN: assignStmt((StmtAssign*)stmt); break;
+            case STMT_IF    : ifStmt((StmtIf*)stmt); break;
+            case STMT_WHILE : whileStmt((StmtWhile*)stmt); break;
+            default         : break;
+        }
+    }
+}
+
+static void emitReturn(int status) {
+    emit(3, 0x48, 0x89, 0xec);                  // mov rsp, rbp
+    emitByte(0x5d);                             // pop rbp
+    emitByte(0xb8);                             // mov eax, status
+    emit32(status);
+    emitByte(0xc3);                             // ret
+}
+
+static void compileLoop(StmtWhile* stmt) {
+    emitByte(0x55);                             // push rbp
+    emit(3, 0x48, 0x89, 0xe5);                  // mov rbp, rsp
+
+    int loopStart = as.count;
+    int done = emitCondition(stmt->condition);
+    statements(stmt->body);
+
+    for (int i = 0; i < as.loop->varCount; ++i) {
+        if (!as.loop->assigned[i]) continue;
+        emit(3, 0x48, 0x8b, 0x87);              // mov rax, [rdi + disp32]
+        emit32(i * 8);
+        emit(3, 0x48, 0x89, 0x86);              // mov [rsi + disp32], rax
+        emit32(i * 8);
+    }
+    emitLoop(loopStart);
+
+    patchJump(done);
+    emitReturn(0);
+
+    for (int i = 0; i < as.bailoutCount; ++i) {
+        patchJump(as.bailouts[i]);
+    }
+    emitReturn(1);
+}
+
+// Copies the generated code into fresh pages and makes them executable
+static bool install(JitLoop* loop) {
+    size_t page = 4096;
+    loop->size = (as.count + page - 1) / page * page;
+
+    void* memory = mmap(NULL, loop->size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) return false;
+
+    memcpy(memory, as.code, as.count);
+    if (mprotect(memory, loop->size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, loop->size);
+        return false;
+    }
+
+    loop->memory = memory;
+    loop->code = (JitFunction)memory;
+    return true;
+}
+
+static bool compile(JitLoop* loop, StmtWhile* stmt) {
+    as.code = NULL;
+    as.count = as.capacity = 0;
+    as.bailouts = NULL;
+    as.bailoutCount = as.bailoutCapacity = 0;
+    as.loop = loop;
+
+    compileLoop(stmt);
+    bool installed = install(loop);
+
+    free(as.code);
+    free(as.bailouts);
+    if (!installed) return false;
+
+    loop->frame = malloc(sizeof(int64_t) * 2 * (loop->varCount > 0 ? loop->varCount : 1));
+    return true;
+}
+
+static bool bailOut(JitLoop* loop) {
+    if (++loop->bailouts >= MAX_BAILOUTS) loop->failed = true;
+    return false;
+}
+
+#endif
+
+bool runJitLoop(StmtWhile* stmt) {
+#ifdef JIT_AVAILABLE
+    if (stmt->jit == NULL) {
+        stmt->jit = calloc(1, sizeof(JitLoop));
+        stmt->jit->failed = !jitSupports(stmt);
+    }
+
+    JitLoop* loop = stmt->jit;
+    if (loop->failed) return false;
+
+    if (loop->code == NULL) {
+        if (interp.jit != JIT_FORCED && ++loop->hits < HOT_LOOP) return false;
+        if (!compile(loop, stmt)) {
+            loop->failed = true;
+            return false;
+        }
+    }
+
+    // Native code only knows inline integers
+    int64_t* working = loop->frame;
+    int64_t* committed = loop->frame + loop->varCount;
+    for (int i = 0; i < loop->varCount; ++i) {
+        Value* value = &interp.globals.values[loop->slots[i]];
+        if (value->type != VALUE_NUMBER || !BIGINT_IS_SMALL(&value->number)) return bailOut(loop);
+        working[i] = committed[i] = BIGINT_SMALL_VALUE(&value->number);
+    }
+
+    int status = loop->code(working, committed);
+
+    for (int i = 0; i < loop->varCount; ++i) {
+        if (loop->assigned[i]) {
+            interp.globals.values[loop->slots[i]].number = BIGINT_SMALL(committed[i]);
+        }
+    }
+
+    return status == 0 || bailOut(loop);
+#else
+    (void)stmt;
+    return false;
+#endif
+}
@@ -0,0 +1,46 @@
+#ifndef cryton_jit_h
+#define cryton_jit_h
+
+#include "common.h"
+#include "parser.h"
+
+// Native code needs an x86-64 CPU and mmap
+#if defined(__x86_64__) && defined(__linux__) && !defined(NO_JIT)
+    #define JIT_AVAILABLE
+#endif
+
+typedef enum {
+    JIT_OFF,
+    JIT_ON,         // Compile loops once they run hot
+    JIT_FORCED      // Compile loops the first time they run
+} JitMode;
+
+// Returns 0 when the loop condition turned false, 1 to bail out. Works on
+// untagged copies of the loop's variables.
+typedef int (*JitFunction)(int64_t* working, int64_t* committed);
+
+typedef struct JitLoop {
+    int hits;           // Times the loop head ran in the interpreter
+    int bailouts;
+    bool failed;        // Not compilable, or bails out too often
+
+    JitFunction code;
+    void* memory;
+    size_t size;
+
+    int varCount;
+    int* slots;         // Global slot of each variable, in frame order
+    bool* assigned;
+    int64_t* frame;     // Working copy, then the copy as of the last iteration
+} JitLoop;
+
+// Whether the loop only does small-integer arithmetic, comparisons and
+// assignments, so it could run natively
+bool jitSupports(StmtWhile* stmt);
+// Called at the head of the loop, before its condition. Returns true when
+// the loop ran to completion natively. On false the interpreter evaluates
+// the condition itself; the globals are as of the last full native iteration.
+bool runJitLoop(StmtWhile* stmt);
+void freeJitLoop(JitLoop* loop);
+
+#endif
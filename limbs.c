@@ -0,0 +1,286 @@
+#include "limbs.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__COMPCERT__)
+#define LIMBS_X86_SIMD
+#include <immintrin.h>
+#endif
+
+// Scalar, also used for the limbs left over after the last full vector
+
+static inline limb_t addCarry(limb_t* r, const limb_t* a, const limb_t* b, int n, limb_t carry) {
+    for (int i = 0; i < n; ++i) {
+        limb_t ai = a[i], bi = b[i];
+        limb_t sum = ai + carry;
+        carry = sum < carry;
+        sum += bi;
+        carry += sum < bi;
+        r[i] = sum;
+    }
+
+    return carry;
+}
+
+static inline limb_t subBorrow(limb_t* r, const limb_t* a, const limb_t* b, int n, limb_t borrow) {
+    for (int i = 0; i < n; ++i) {
+        limb_t ai = a[i], bi = b[i];
+        limb_t diff = ai - bi;
+        limb_t under = ai < bi;
+        under |= diff < borrow;
+        r[i] = diff - borrow;
+        borrow = under;
+    }
+
+    return borrow;
+}
+
+static inline int compareFrom(const limb_t* a, const limb_t* b, int n) {
+    for (int i = n - 1; i >= 0; --i) {
+        if (a[i] != b[i]) return a[i] > b[i] ? 1 : -1;
+    }
+    return 0;
+}
+
+static limb_t addScalar(limb_t* r, const limb_t* a, const limb_t* b, int n) {
+    return addCarry(r, a, b, n, 0);
+}
+
+static limb_t subScalar(limb_t* r, const limb_t* a, const limb_t* b, int n) {
+    return subBorrow(r, a, b, n, 0);
+}
+
+static int compareScalar(const limb_t* a, const limb_t* b, int n) {
+    return compareFrom(a, b, n);
+}
+
+static const LimbKernels scalarKernels = { "scalar", addScalar, subScalar, compareScalar };
+
+#ifdef LIMBS_X86_SIMD
+
+// The vector kernels add every lane of a block independently, then fix up
+// the carries with carry-lookahead on bitmasks holding one bit per lane:
+// `generate` marks lanes whose sum wrapped and `propagate` lanes whose sum
+// is all ones (zero when subtracting), which pass an incoming carry on.
+// Adding propagate to the shifted generate mask ripples each carry through
+// its run of propagating lanes in a single integer addition; the lanes that
+// receive one are then corrected with a masked +1 (-1 when subtracting).
+//
+// The carry out of a lane is the top bit of (a & b) | ((a | b) & ~sum) and
+// the borrow the top bit of (~a & b) | ((~a | b) & diff).
+
+static inline int carriesIn(int generate, int propagate, limb_t carry) {
+    return (((generate << 1) | (int)carry) + propagate) ^ propagate;
+}
+
+// laneMasks[m] has all ones in lane i for every bit i set in m
+#define M ~0ULL
+static const limb_t laneMasks[16][4] = {
+    { 0, 0, 0, 0 }, { M, 0, 0, 0 }, { 0, M, 0, 0 }, { M, M, 0, 0 },
+    { 0, 0, M, 0 }, { M, 0, M, 0 }, { 0, M, M, 0 }, { M, M, M, 0 },
+    { 0, 0, 0, M }, { M, 0, 0, M }, { 0, M, 0, M }, { M, M, 0, M },
+    { 0, 0, M, M }, { M, 0, M, M }, { 0, M, M, M }, { M, M, M, M },
+};
+#undef M
+
+// SSE2, four limbs per step in two vectors. There is no 64-bit equality,
+// so a lane matches when both of its 32-bit halves do.
+
+static inline int sse2TopBits(__m128i x) {
+    return _mm_movemask_pd(_mm_castsi128_pd(x));
+}
+
+static inline int sse2LaneMask(__m128i equal32) {
+    return sse2TopBits(_mm_and_si128(equal32, _mm_shuffle_epi32(equal32, _MM_SHUFFLE(2, 3, 0, 1))));
+}
+
+static inline __m128i sse2Load(const limb_t* p) {
+    return _mm_loadu_si128((const __m128i*)p);
+}
+
+static limb_t addSse2(limb_t* r, const limb_t* a, const limb_t* b, int n) {
+    const __m128i ones = _mm_set1_epi32(-1);
+    limb_t carry = 0;
+    int i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i a0 = sse2Load(a + i), a1 = sse2Load(a + i + 2);
+        __m128i b0 = sse2Load(b + i), b1 = sse2Load(b + i + 2);
+        __m128i s0 = _mm_add_epi64(a0, b0), s1 = _mm_add_epi64(a1, b1);
+
+        __m128i g0 = _mm_or_si128(_mm_and_si128(a0, b0), _mm_andnot_si128(s0, _mm_or_si128(a0, b0)));
+        __m128i g1 = _mm_or_si128(_mm_and_si128(a1, b1), _mm_andnot_si128(s1, _mm_or_si128(a1, b1)));
+        int generate = sse2TopBits(g0) | sse2TopBits(g1) << 2;
+        int propagate = sse2LaneMask(_mm_cmpeq_epi32(s0, ones)) |
+                        sse2LaneMask(_mm_cmpeq_epi32(s1, ones)) << 2;
+
+        int in = carriesIn(generate, propagate, carry);
+        carry = in >> 4;
+        const limb_t* fix = laneMasks[in & 15];
+        _mm_storeu_si128((__m128i*)(r + i), _mm_sub_epi64(s0, sse2Load(fix)));
+        _mm_storeu_si128((__m128i*)(r + i + 2), _mm_sub_epi64(s1, sse2Load(fix + 2)));
+    }
+
+    return addCarry(r + i, a + i, b + i, n - i, carry);
+}
+
+static limb_t subSse2(limb_t* r, const limb_t* a, const limb_t* b, int n) {
+    const __m128i ones = _mm_set1_epi32(-1);
+    const __m128i zero = _mm_setzero_si128();
+    limb_t borrow = 0;
+    int i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i a0 = sse2Load(a + i), a1 = sse2Load(a + i + 2);
+        __m128i b0 = sse2Load(b + i), b1 = sse2Load(b + i + 2);
+        __m128i d0 = _mm_sub_epi64(a0, b0), d1 = _mm_sub_epi64(a1, b1);
+
+        __m128i n0 = _mm_xor_si128(a0, ones), n1 = _mm_xor_si128(a1, ones);
+        __m128i g0 = _mm_or_si128(_mm_and_si128(n0, b0), _mm_and_si128(_mm_or_si128(n0, b0), d0));
+        __m128i g1 = _mm_or_si128(_mm_and_si128(n1, b1), _mm_and_si128(_mm_or_si128(n1, b1), d1));
+        int generate = sse2TopBits(g0) | sse2TopBits(g1) << 2;
+        int propagate = sse2LaneMask(_mm_cmpeq_epi32(d0, zero)) |
+                        sse2LaneMask(_mm_cmpeq_epi32(d1, zero)) << 2;
+
+        int in = carriesIn(generate, propagate, borrow);
+        borrow = in >> 4;
+        const limb_t* fix = laneMasks[in & 15];
+        _mm_storeu_si128((__m128i*)(r + i), _mm_add_epi64(d0, sse2Load(fix)));
+        _mm_storeu_si128((__m128i*)(r + i + 2), _mm_add_epi64(d1, sse2Load(fix + 2)));
+    }
+
+    return subBorrow(r + i, a + i, b + i, n - i, borrow);
+}
+
+static int compareSse2(const limb_t* a, const limb_t* b, int n) {
+    int i = n;
+
+    // Skip equal blocks of four from the top, then settle the first
+    // differing block limb by limb
+    for (; i >= 4; i -= 4) {
+        __m128i equal = _mm_and_si128(_mm_cmpeq_epi32(sse2Load(a + i - 4), sse2Load(b + i - 4)),
+                                      _mm_cmpeq_epi32(sse2Load(a + i - 2), sse2Load(b + i - 2)));
+        if (_mm_movemask_epi8(equal) != 0xffff) {
+            return compareFrom(a + i - 4, b + i - 4, 4);
+        }
+    }
+
+    return compareFrom(a, b, i);
+}
+
+static const LimbKernels sse2Kernels = { "sse2", addSse2, subSse2, compareSse2 };
+
+// AVX2, four limbs per vector
+
+__attribute__((target("avx2")))
+static limb_t addAvx2(limb_t* r, const limb_t* a, const limb_t* b, int n) {
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    limb_t carry = 0;
+    int i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+        __m256i sum = _mm256_add_epi64(va, vb);
+
+        __m256i gen = _mm256_or_si256(_mm256_and_si256(va, vb),
+                                      _mm256_andnot_si256(sum, _mm256_or_si256(va, vb)));
+        int generate = _mm256_movemask_pd(_mm256_castsi256_pd(gen));
+        int propagate = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(sum, ones)));
+
+        int in = carriesIn(generate, propagate, carry);
+        carry = in >> 4;
+        sum = _mm256_sub_epi64(sum, _mm256_loadu_si256((const __m256i*)laneMasks[in & 15]));
+        _mm256_storeu_si256((__m256i*)(r + i), sum);
+    }
+
+    return addCarry(r + i, a + i, b + i, n - i, carry);
+}
+
+__attribute__((target("avx2")))
+static limb_t subAvx2(limb_t* r, const limb_t* a, const limb_t* b, int n) {
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    const __m256i zero = _mm256_setzero_si256();
+    limb_t borrow = 0;
+    int i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+        __m256i diff = _mm256_sub_epi64(va, vb);
+
+        __m256i notA = _mm256_xor_si256(va, ones);
+        __m256i gen = _mm256_or_si256(_mm256_and_si256(notA, vb),
+                                      _mm256_and_si256(_mm256_or_si256(notA, vb), diff));
+        int generate = _mm256_movemask_pd(_mm256_castsi256_pd(gen));
+        int propagate = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(diff, zero)));
+
+        int in = carriesIn(generate, propagate, borrow);
+        borrow = in >> 4;
+        diff = _mm256_add_epi64(diff, _mm256_loadu_si256((const __m256i*)laneMasks[in & 15]));
+        _mm256_storeu_si256((__m256i*)(r + i), diff);
+    }
+
+    return subBorrow(r + i, a + i, b + i, n - i, borrow);
+}
+
+__attribute__((target("avx2")))
+static int compareAvx2(const limb_t* a, const limb_t* b, int n) {
+    int i = n;
+
+    // Scan down from the top four limbs at a time until a block differs
+    for (; i >= 4; i -= 4) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i - 4));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i - 4));
+        int equal = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(va, vb)));
+        if (equal != 15) {
+            int top = i - 4 + 31 - __builtin_clz(~equal & 15);
+            return a[top] > b[top] ? 1 : -1;
+        }
+    }
+
+    return compareFrom(a, b, i);
+}
+
+static const LimbKernels avx2Kernels = { "avx2", addAvx2, subAvx2, compareAvx2 };
+
+#endif // LIMBS_X86_SIMD
+
+int availableLimbKernels(const LimbKernels** out, int max) {
+    int count = 0;
+    if (count < max) out[count++] = &scalarKernels;
+
+#ifdef LIMBS_X86_SIMD
+    // SSE2 is part of x86-64 itself
+    if (count < max) out[count++] = &sse2Kernels;
+
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && count < max) out[count++] = &avx2Kernels;
+#endif
+
+    return count;
+}
+
+// limbKernels starts out pointing at stubs that pick the real kernels and
+// forward to them, so callers never check whether dispatch has happened
+
+static const LimbKernels* selectLimbKernels() {
+    const LimbKernels* kernels[4];
+    int count = availableLimbKernels(kernels, 4);
+    limbKernels = kernels[count - 1];
+    return limbKernels;
+}
+
+static limb_t addResolve(limb_t* r, const limb_t* a, const limb_t* b, int n) {
+    return selectLimbKernels()->add(r, a, b, n);
+}
+
+static limb_t subResolve(limb_t* r, const limb_t* a, const limb_t* b, int n) {
+    return selectLimbKernels()->sub(r, a, b, n);
+}
+
+static int compareResolve(const limb_t* a, const limb_t* b, int n) {
+    return selectLimbKernels()->compare(a, b, n);
+}
+
+static const LimbKernels resolveKernels = { "resolve", addResolve, subResolve, compareResolve };
+
+const LimbKernels* limbKernels = &resolveKernels;
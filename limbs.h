@@ -0,0 +1,24 @@
+#ifndef cryton_limbs_h
+#define cryton_limbs_h
+
+#include "bigint.h"
+
+// Kernels over two limb arrays of the same length `n`, least significant
+// limb first. `r` may be `a` or `b` itself but must not partially overlap
+// them. add and sub return the carry or borrow out of the top limb.
+typedef struct {
+    const char* name;
+    limb_t (*add)(limb_t* r, const limb_t* a, const limb_t* b, int n);
+    limb_t (*sub)(limb_t* r, const limb_t* a, const limb_t* b, int n);
+    // returns 1 if a > b, -1 if a < b, 0 if equal
+    int (*compare)(const limb_t* a, const limb_t* b, int n);
+} LimbKernels;
+
+// The fastest variant this CPU supports, picked on first use
+extern const LimbKernels* limbKernels;
+
+// Fills `out` with every variant this build and CPU can run, scalar first,
+// and returns how many there are
+int availableLimbKernels(const LimbKernels** out, int max);
+
+#endif
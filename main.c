@@ -4,58 +4,105 @@
 #include <ctype.h>
 #ifdef _WIN32  // If compiling on Windows
     #define USE_FGETS  // Use fgets for input
+    #include <io.h>
+    #define isatty _isatty
+    #define fileno _fileno
 #else  // If compiling on Linux/Mac
     #include <readline/readline.h>
     #include <readline/history.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
 #endif
 
+#define REPL_HISTORY 1000
+
 #include "bigint.h"
 #include "common.h"
 #include "object.h"
 #include "scanner.h"
 #include "parser.h"
 #include "interpreter.h"
+#include "compiler.h"
+#include "optimizer.h"
+#include "resolver.h"
+#include "emitter.h"
+
+// A source file, mapped when it is a regular file and read otherwise. The
+// scanner works on the byte range, so neither needs a newline or NUL added.
+typedef struct {
+    const char* chars;
+    size_t length;
+    bool mapped;
+} Source;
+
+static void readStream(FILE* file, const char* path, Source* source) {
+    size_t capacity = 4096;
+    size_t length = 0;
+    char* buffer = malloc(capacity);
 
-static char* readFile(const char* path) {
-    FILE* file = fopen(path, "rb");
+    for (;;) {
+        if (length == capacity) {
+            capacity *= 2;
+            buffer = realloc(buffer, capacity);
+        }
 
-    if (file == NULL) {
-        fprintf(stderr, "Could not open file \"%s\".\n", path);
-        exit(74);
+        size_t bytesRead = fread(buffer + length, sizeof(char), capacity - length, file);
+        if (bytesRead == 0) break;
+        length += bytesRead;
     }
 
-    size_t fileSize = 0;
-
-    fseek(file, -1L, SEEK_END);
-    if (fgetc(file) != '\n')
-        fileSize++;
-
-    fileSize += ftell(file) + 1;
-
-    char* buffer = (char*)malloc(fileSize);
-
-    if (buffer == NULL) {
-        fprintf(stderr, "Not enough memory to read \"%s\".\n", path);
+    if (ferror(file)) {
+        fprintf(stderr, "Could not read file \"%s\".\n", path);
         exit(74);
     }
 
-    rewind(file);
-    size_t bytesRead = fread(buffer, sizeof(char), fileSize, file);
+    source->chars = buffer;
+    source->length = length;
+    source->mapped = false;
+}
 
-    if (buffer == NULL) {
-        fprintf(stderr, "Could not read file \"%s\".\n", path);
+static Source loadSource(const char* path) {
+    FILE* file = fopen(path, "rb");
+
+    if (file == NULL) {
+        fprintf(stderr, "Could not open file \"%s\".\n", path);
         exit(74);
     }
 
-    buffer[fileSize - 2] = '\n';
-    buffer[fileSize - 1] = '\0';
+    Source source;
+#ifndef _WIN32
+    // Pipes and empty files cannot be mapped
+    struct stat info;
+    if (fstat(fileno(file), &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        void* chars = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+        if (chars != MAP_FAILED) {
+            source.chars = chars;
+            source.length = info.st_size;
+            source.mapped = true;
+            fclose(file);
+            return source;
+        }
+    }
+#endif
 
+    readStream(file, path, &source);
     fclose(file);
-    return buffer;
+    return source;
+}
+
+static void freeSource(Source* source) {
+#ifndef _WIN32
+    if (source->mapped) {
+        munmap((void*)source->chars, source->length);
+        return;
+    }
+#endif
+    free((void*)source->chars);
 }
 
-static void printTokens(char* source) {
-    initScanner(source);
+static void printTokens(const char* source, size_t length) {
+    initScanner(source, length);
 
     int line = -1;
 
@@ -90,6 +137,13 @@ static void printExpr(Expr* expr) {
 
         printf("Unary %s\n", TokenName[e->operator]);
         printExpr(e->right);
+    } else if (expr->type == EXPR_POWMOD) {
+        ExprPowMod* e = (ExprPowMod*)expr;
+
+        printf("Modular Power\n");
+        printExpr(e->base);
+        printExpr(e->exponent);
+        printExpr(e->modulus);
     } else if (expr->type == EXPR_NUMBER) {
         ExprNumber* e = (ExprNumber*)expr;
 
@@ -210,27 +264,62 @@ static void printStmt(Stmt* stmt) {
     printf("End body\n");
 }
 
+static void printBytecode(Ast* ast) {
+    Chunk chunk;
+    initChunk(&chunk);
+
+    resolve(ast->stmts);
+    if (compile(ast, &chunk)) {
+        disassembleChunk(&chunk);
+    }
+
+    freeChunk(&chunk);
+}
+
 static void runFile(const char* path, bool debug) {
-    char* source = readFile(path);
-    Stmt* stmts;
+    Source source = loadSource(path);
+    Ast* ast;
 
     if (debug) {
-        printTokens(source);
+        printTokens(source.chars, source.length);
     }
 
-    if (!parse(source, &stmts)) {
+    if (!parse(source.chars, source.length, &ast)) {
         fprintf(stderr, "Could not parse file \"%s\".\n", path);
         exit(74);
     }
 
+    // The tree copies the names and numbers it needs
+    freeSource(&source);
+    optimize(ast);
+
     if (debug) {
-        printStmt(stmts);
+        printStmt(ast->stmts);
+        if (interp.engine == ENGINE_VM) printBytecode(ast);
     } else {
-        runInterp(stmts);
+        runInterp(ast);
     }
 
-    freeAST(stmts);
-    free(source);
+    releaseAst(ast);
+}
+
+static void emitFile(const char* path) {
+    Source source = loadSource(path);
+    Ast* ast;
+
+    if (!parse(source.chars, source.length, &ast)) {
+        fprintf(stderr, "Could not parse file \"%s\".\n", path);
+        exit(74);
+    }
+
+    optimize(ast);
+    if (!emitC(ast, source.chars, source.length, path, stdout)) {
+        fprintf(stderr, "Could not compile file \"%s\".\n", path);
+        exit(65);
+    }
+
+    releaseAst(ast);
+    freeSource(&source);
 }
 
 static void repl() {
@@ -264,11 +353,12 @@ static void repl() {
 
         // Interpret if lines are not blank
         if (*head != '\0') {
-            Stmt* stmts;
-            if (parse(line, &stmts)) {
-                runInterp(stmts);
+            Ast* ast;
+            if (parse(line, currentSize, &ast)) {
+                optimize(ast);
+                runInterp(ast);
             }
-            freeAST(stmts);
+            releaseAst(ast);
         }
 
         // Reset line
@@ -276,8 +366,12 @@ static void repl() {
         head = line;
     }
 #else
-    char* line = NULL;  // Current input line
+    char* line = NULL;  // Input being built, kept from one entry to the next
+    int capacity = 0;
     int currentSize = 0;  // Total size of the input being built
+    bool blank = true;  // Only whitespace so far
+
+    stifle_history(REPL_HISTORY);  // Long sessions keep only recent lines
 
     for (;;) {
         // Show prompt
@@ -303,67 +397,88 @@ static void repl() {
             add_history(input);  // Add completed input to history
         }
 
-        // Allocate space to append the new input
-        line = realloc(line, currentSize + inputLength + 2);
-        memcpy(line + currentSize, input, inputLength);  // Append input to the line
-        currentSize += inputLength;
-
-        // Ensure there's a final newline for the parser
-        if (line[currentSize - 1] != '\n') {
-            line[currentSize] = '\n';  // Add newline
-            currentSize++;
+        // Only the new input needs checking
+        for (int j = 0; blank && j < inputLength; j++) {
+            if (!isspace((unsigned char)input[j])) blank = false;
         }
 
-        line[currentSize] = '\0';  // Null-terminate
+        // Grow only for an entry longer than any before it
+        if (currentSize + inputLength > capacity) {
+            capacity = currentSize + inputLength;
+            if (capacity < 2 * currentSize) capacity = 2 * currentSize;
+            line = realloc(line, capacity);
+        }
+        memcpy(line + currentSize, input, inputLength);  // Append input to the line
+        currentSize += inputLength;
         free(input);  // Free temporary input
 
         if (!isContinuation) {  // If it's not a continuation, interpret the input
-            char* head = line;
-            while (*head != '\0' && isspace((unsigned char)*head))
-                ++head;
-
-            if (*head != '\0') {  // If the line is not empty
-                Stmt* stmts;
+            if (!blank) {
+                Ast* ast;
 
-                if (parse(line, &stmts)) {
-                    runInterp(stmts);
+                if (parse(line, currentSize, &ast)) {
+                    optimize(ast);
+                    runInterp(ast);
                 }
-                // freeAST(stmts);
+                releaseAst(ast);    // Templates defined here keep it alive
             }
 
             // Reset after interpreting
             currentSize = 0;
-            free(line);
-            line = NULL;
+            blank = true;
         }
     }
+
+    free(line);
 #endif
 }
 
+static void usage() {
+    fprintf(stderr, "Usage: cryton [-l | -b] [-t] [-j | -J] [[-d | --emit-c] <path>]\n");
+    exit(64);
+}
+
 int main(int argc, char* argv[]) {
-    initInterp();
     char *path = NULL;
     bool debug = false;
+    bool emit = false;
+    Engine engine = ENGINE_VM;
+    JitMode jit = JIT_OFF;
+
+    // Interactive sessions want each line as it is printed, pipes want throughput
+    OutputMode outputMode = isatty(fileno(stdout)) ? OUTPUT_LINE_BUFFERED
+                                                   : OUTPUT_BLOCK_BUFFERED;
 
     for (int i = 1; i < argc; ++i) {
-        switch (argv[i][0]) {
-            case '-':
-                if (strcmp(argv[i], "-d") == 0) {
-                    debug = true;
-                }
-                break;
-            default:
-                path = argv[i];
-                break;
+        if (argv[i][0] != '-') {
+            if (path) usage();
+            path = argv[i];
+        } else if (strcmp(argv[i], "-d") == 0) {
+            debug = true;
+        } else if (strcmp(argv[i], "--emit-c") == 0) {
+            emit = true;
+        } else if (strcmp(argv[i], "-t") == 0) {
+            engine = ENGINE_TREE;
+        } else if (strcmp(argv[i], "-j") == 0) {
+            jit = JIT_ON;
+        } else if (strcmp(argv[i], "-J") == 0) {
+            jit = JIT_FORCED;
+        } else if (strcmp(argv[i], "-l") == 0) {
+            outputMode = OUTPUT_LINE_BUFFERED;
+        } else if (strcmp(argv[i], "-b") == 0) {
+            outputMode = OUTPUT_BLOCK_BUFFERED;
+        } else {
+            usage();
         }
     }
 
-    if (argc > 3 || (!path && argc > 1)) {
-        fprintf(stderr, "Usage: cryton [[-d] <path>]\n");
-        exit(64);
-    }
+    if ((debug || emit) && !path) usage();
+
+    initInterp(outputMode, engine, jit);
 
-    if (path) {
+    if (emit) {
+        emitFile(path);
+    } else if (path) {
         runFile(path, debug);
     } else {
         repl();
@@ -10,11 +10,8 @@ static ObjString* allocateString(char* chars, int length, uint32_t hash) {
     string->chars = chars;
     string->length = length;
     string->hash = hash;
-    
-    Value val;
-    val.type = VALUE_NULL;
-    bigint_init(&val.number, 0);
-    tableSet(&interp.strings, string, val);
+
+    stringSetAdd(&interp.strings, string);
     return string;
 }
 
@@ -30,7 +27,7 @@ static uint32_t hashString(const char* key, int length) {
 ObjString* copyString(const char* chars, int length) {
     uint32_t hash = hashString(chars, length);
 
-    ObjString* interned = tableFindString(&interp.strings, chars, length, hash);
+    ObjString* interned = stringSetFind(&interp.strings, chars, length, hash);
     if (interned != NULL) return interned;
 
     char* heapChars = malloc(sizeof(char) * length + 1);
@@ -45,3 +42,34 @@ void freeString(ObjString* string) {
     if (string->chars != NULL) free(string->chars);
     free(string);
 }
+
+BigInt internNumber(BigInt num) {
+    if (BIGINT_IS_CANONICAL(&num)) return num;
+
+    uint32_t hash = bigint_hash(&num);
+    BigInt* interned = numberSetFind(&interp.numbers, &num, hash);
+    if (interned != NULL) {
+        bigint_free(&num);
+        return bigint_copy(interned);
+    }
+
+    // The set keeps a reference, so the number is never modified in place
+    BigNum* heap = BIGINT_AS_NUM(&num);
+    heap->hash = hash;
+    heap->id = ++interp.numbers.lastId;
+    numberSetAdd(&interp.numbers, bigint_copy(&num));
+    return num;
+}
+
+bool findInternedNumber(const BigInt* num, BigInt* canonical) {
+    if (BIGINT_IS_CANONICAL(num)) {
+        *canonical = *num;
+        return true;
+    }
+
+    BigInt* interned = numberSetFind(&interp.numbers, num, bigint_hash(num));
+    if (interned == NULL) return false;
+
+    *canonical = *interned;
+    return true;
+}
@@ -13,4 +13,12 @@ struct ObjString {
 ObjString* copyString(const char* chars, int length);
 void freeString(ObjString* string);
 
+// Returns the canonical copy of `num`, taking over the caller's reference.
+// Small values are canonical already; heap numbers are shared through
+// interp.numbers, so interned numbers are equal exactly when their words are.
+BigInt internNumber(BigInt num);
+// Borrows the canonical copy of `num` without interning it. Returns false
+// when no equal number has been interned.
+bool findInternedNumber(const BigInt* num, BigInt* canonical);
+
 #endif
@@ -0,0 +1,237 @@
+#include <stdlib.h>
+
+#include "object.h"
+#include "optimizer.h"
+
+// Folding a power grows the tree by the digits of the result, so huge ones
+// are left for the interpreter
+#define MAX_FOLDED_DIGITS 4096
+
+static Ast* ast;     // The unit being optimized
+
+static Expr* fold(Expr* expr);
+static Stmt* optimizeList(Stmt* stmts);
+
+static bool isNumber(Expr* expr) {
+    return expr->type == EXPR_NUMBER;
+}
+
+static const BigInt* valueOf(Expr* expr) {
+    return &((ExprNumber*)expr)->value;
+}
+
+static bool powerIsSmall(const BigInt* base, const BigInt* exponent) {
+    if (!BIGINT_IS_SMALL(exponent)) return false;
+
+    int64_t e = BIGINT_SMALL_VALUE(exponent);
+    return e <= MAX_FOLDED_DIGITS &&
+           (int64_t)bigint_str_bound(base) * e <= MAX_FOLDED_DIGITS;
+}
+
+// Operations that would fail at runtime are left alone, so the error is
+// still reported when and if they run
+static Expr* foldBinary(ExprBinary* expr) {
+    expr->left = fold(expr->left);
+    expr->right = fold(expr->right);
+    if (!isNumber(expr->left) || !isNumber(expr->right)) return (Expr*)expr;
+
+    const BigInt* a = valueOf(expr->left);
+    const BigInt* b = valueOf(expr->right);
+    BigInt result = BIGINT_ZERO;
+
+    switch (expr->operator) {
+        case TOKEN_PLUS:        bigint_add(&result, a, b); break;
+        case TOKEN_MINUS:       bigint_sub(&result, a, b); break;
+        case TOKEN_STAR:        bigint_mul(&result, a, b); break;
+        case TOKEN_LESS:        result = BIGINT_FROM_BOOL(bigint_abs_compare(a, b) < 0); break;
+        case TOKEN_GREATER:     result = BIGINT_FROM_BOOL(bigint_abs_compare(a, b) > 0); break;
+        case TOKEN_EQUAL_EQUAL: result = BIGINT_FROM_BOOL(bigint_equal(a, b)); break;
+        case TOKEN_BANG_EQUAL:  result = BIGINT_FROM_BOOL(!bigint_equal(a, b)); break;
+        case TOKEN_AND:         result = BIGINT_FROM_BOOL(!bigint_is_zero(a) && !bigint_is_zero(b)); break;
+        case TOKEN_OR:          result = BIGINT_FROM_BOOL(!bigint_is_zero(a) || !bigint_is_zero(b)); break;
+
+        case TOKEN_SLASH:
+            if (!bigint_divmod(&result, NULL, a, b)) return (Expr*)expr;
+            break;
+
+        case TOKEN_PERCENT:
+            if (!bigint_divmod(NULL, &result, a, b)) return (Expr*)expr;
+            break;
+
+        case TOKEN_STAR_STAR:
+            if (bigint_is_negative(b) || !powerIsSmall(a, b)) return (Expr*)expr;
+            if (!bigint_pow(&result, a, b)) return (Expr*)expr;
+            break;
+
+        default:
+            return (Expr*)expr;
+    }
+
+    return (Expr*)makeExprNumber(ast, result);
+}
+
+static Expr* foldUnary(ExprUnary* expr) {
+    expr->right = fold(expr->right);
+    if (!isNumber(expr->right)) return (Expr*)expr;
+
+    const BigInt* value = valueOf(expr->right);
+
+    switch (expr->operator) {
+        case TOKEN_MINUS: {
+            BigInt result = bigint_copy(value);
+            bigint_negate(&result);
+            return (Expr*)makeExprNumber(ast, result);
+        }
+
+        case TOKEN_NOT:
+            return (Expr*)makeExprNumber(ast, BIGINT_FROM_BOOL(bigint_is_zero(value)));
+
+        default:
+            return (Expr*)expr;
+    }
+}
+
+static Expr* foldPowMod(ExprPowMod* expr) {
+    expr->base = fold(expr->base);
+    expr->exponent = fold(expr->exponent);
+    expr->modulus = fold(expr->modulus);
+
+    if (!isNumber(expr->base) || !isNumber(expr->exponent) || !isNumber(expr->modulus) ||
+        bigint_is_negative(valueOf(expr->exponent))) {
+        return (Expr*)expr;
+    }
+
+    BigInt result = BIGINT_ZERO;
+    if (!bigint_powmod(&result, valueOf(expr->base), valueOf(expr->exponent), valueOf(expr->modulus))) {
+        return (Expr*)expr;
+    }
+
+    return (Expr*)makeExprNumber(ast, result);
+}
+
+static Expr* fold(Expr* expr) {
+    switch (expr->type) {
+        case EXPR_BINARY:   return foldBinary((ExprBinary*)expr);
+        case EXPR_UNARY:    return foldUnary((ExprUnary*)expr);
+        case EXPR_POWMOD:   return foldPowMod((ExprPowMod*)expr);
+
+        case EXPR_IN: {
+            ExprIn* in = (ExprIn*)expr;
+            in->element = fold(in->element);
+            return expr;
+        }
+
+        case EXPR_MORPHISM: {
+            ExprMorphism* morph = (ExprMorphism*)expr;
+            morph->from = fold(morph->from);
+            morph->to = fold(morph->to);
+            return expr;
+        }
+
+        case EXPR_CAT_INIT: {
+            ExprCatInit* init = (ExprCatInit*)expr;
+            for (int i = 0; i < init->argCount; ++i) {
+                init->args[i] = fold(init->args[i]);
+            }
+            return expr;
+        }
+
+        default:
+            return expr;
+    }
+}
+
+static void foldTemplate(StmtCat* stmt) {
+    for (int i = 0; i < stmt->objects.count; ++i) {
+        stmt->objects.values[i] = fold(stmt->objects.values[i]);
+    }
+
+    for (int i = 0; i < stmt->homset.count; ++i) {
+        TmplAdjMorphisms* morphism = &stmt->homset.morphisms[i];
+        morphism->from = fold(morphism->from);
+        for (int j = 0; j < morphism->toCount; ++j) {
+            morphism->to[j] = fold(morphism->to[j]);
+        }
+    }
+}
+
+static bool isConstantCondition(Expr* condition, bool* isTrue) {
+    if (!isNumber(condition)) return false;
+
+    *isTrue = !bigint_is_zero(valueOf(condition));
+    return true;
+}
+
+// Replaces `*link` with the statements `with` and returns the link after
+// the last one put in
+static Stmt** splice(Stmt** link, Stmt* with) {
+    Stmt* next = (*link)->next;
+
+    *link = with;
+    while (*link != NULL) link = &(*link)->next;
+    *link = next;
+    return link;
+}
+
+// Returns the link to the statement after the optimized one
+static Stmt** optimizeStmt(Stmt** link) {
+    Stmt* stmt = *link;
+    bool isTrue;
+
+    switch (stmt->type) {
+        case STMT_ASSIGN: {
+            StmtAssign* assign = (StmtAssign*)stmt;
+            assign->right = fold(assign->right);
+            break;
+        }
+
+        case STMT_PRINT: {
+            StmtPrint* print = (StmtPrint*)stmt;
+            print->expr = fold(print->expr);
+            break;
+        }
+
+        case STMT_IF: {
+            StmtIf* ifStmt = (StmtIf*)stmt;
+            ifStmt->condition = fold(ifStmt->condition);
+            ifStmt->thenBranch = optimizeList(ifStmt->thenBranch);
+            ifStmt->elseBranch = optimizeList(ifStmt->elseBranch);
+
+            if (isConstantCondition(ifStmt->condition, &isTrue)) {
+                return splice(link, isTrue ? ifStmt->thenBranch : ifStmt->elseBranch);
+            }
+            break;
+        }
+
+        case STMT_WHILE: {
+            StmtWhile* whileStmt = (StmtWhile*)stmt;
+            whileStmt->condition = fold(whileStmt->condition);
+            whileStmt->body = optimizeList(whileStmt->body);
+
+            if (isConstantCondition(whileStmt->condition, &isTrue) && !isTrue) {
+                return splice(link, NULL);
+            }
+            break;
+        }
+
+        case STMT_CAT:
+            foldTemplate((StmtCat*)stmt);
+            break;
+    }
+
+    return &stmt->next;
+}
+
+static Stmt* optimizeList(Stmt* stmts) {
+    Stmt** link = &stmts;
+    while (*link != NULL) {
+        link = optimizeStmt(link);
+    }
+    return stmts;
+}
+
+void optimize(Ast* unit) {
+    ast = unit;
+    ast->stmts = optimizeList(ast->stmts);
+    ast = NULL;
+}
@@ -0,0 +1,11 @@
+#ifndef cryton_optimizer_h
+#define cryton_optimizer_h
+
+#include "parser.h"
+
+// Folds constant expressions into numbers and drops if branches and while
+// loops whose condition is constant. Rewrites the tree in place; new nodes
+// go in the same arena and dropped ones stay there until it is freed.
+void optimize(Ast* ast);
+
+#endif
@@ -0,0 +1,44 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "output.h"
+
+void initOutput(Output* out, OutputMode mode) {
+    out->mode = mode;
+    out->length = 0;
+}
+
+void flushOutput(Output* out) {
+    if (out->length == 0) return;
+
+    fwrite(out->buffer, 1, out->length, stdout);
+    fflush(stdout);
+    out->length = 0;
+}
+
+void writeNumber(Output* out, const BigInt* num) {
+    size_t bound = bigint_str_bound(num);
+
+    if (out->length + bound > OUTPUT_BUFFER_SIZE)
+        flushOutput(out);
+
+    if (bound <= OUTPUT_BUFFER_SIZE) {
+        out->length += bigint_format(num, out->buffer + out->length);
+        return;
+    }
+
+    // Too long for the buffer, format it on its own
+    char* digits = malloc(bound);
+    fwrite(digits, 1, bigint_format(num, digits), stdout);
+    free(digits);
+}
+
+void writeNewline(Output* out) {
+    if (out->length == OUTPUT_BUFFER_SIZE)
+        flushOutput(out);
+
+    out->buffer[out->length++] = '\n';
+
+    if (out->mode == OUTPUT_LINE_BUFFERED)
+        flushOutput(out);
+}
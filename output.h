@@ -0,0 +1,25 @@
+#ifndef cryton_output_h
+#define cryton_output_h
+
+#include "common.h"
+#include "bigint.h"
+
+#define OUTPUT_BUFFER_SIZE (64 * 1024)
+
+typedef enum {
+    OUTPUT_LINE_BUFFERED,   // Flush after every line, for interactive use
+    OUTPUT_BLOCK_BUFFERED   // Flush only when the buffer fills up
+} OutputMode;
+
+typedef struct {
+    OutputMode mode;
+    size_t length;
+    char buffer[OUTPUT_BUFFER_SIZE];
+} Output;
+
+void initOutput(Output* out, OutputMode mode);
+void writeNumber(Output* out, const BigInt* num);
+void writeNewline(Output* out);
+void flushOutput(Output* out);
+
+#endif
@@ -1,7 +1,9 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include "arena.h"
 #include "bigint.h"
 #include "common.h"
+#include "jit.h"
 #include "object.h"
 #include "parser.h"
 #include "scanner.h"
@@ -11,10 +13,15 @@ typedef struct {
     Token previous;
     bool hadError;
     bool panicMode;
+    Ast* ast;       // Where the nodes go
 } Parser;
 
 Parser parser;
 
+#define ALLOCATE_NODE(type) ((type*)arenaAlloc(&parser.ast->arena, sizeof(type)))
+#define GROW_NODES(type, array, oldCount, newCount) \
+    ((type*)arenaGrow(&parser.ast->arena, array, sizeof(type) * (oldCount), sizeof(type) * (newCount)))
+
 static void errorAt(Token* token, const char* message) {
     if (parser.panicMode) return;
     parser.panicMode = true;
@@ -61,8 +68,9 @@ static void consume(TokenType type, const char* message) {
 }
 
 static ExprBinary* makeExprBinary(TokenType operator, Expr* left, Expr* right) {
-    ExprBinary* expr = malloc(sizeof(ExprBinary));
+    ExprBinary* expr = ALLOCATE_NODE(ExprBinary);
     expr->type = EXPR_BINARY;
+    expr->staticType = STATIC_UNKNOWN;
     expr->operator = operator;
     expr->left = left;
     expr->right = right;
@@ -70,24 +78,86 @@ static ExprBinary* makeExprBinary(TokenType operator, Expr* left, Expr* right) {
 }
 
 static ExprUnary* makeExprUnary(TokenType operator, Expr* right) {
-    ExprUnary* expr = malloc(sizeof(ExprUnary));
+    ExprUnary* expr = ALLOCATE_NODE(ExprUnary);
     expr->type = EXPR_UNARY;
+    expr->staticType = STATIC_UNKNOWN;
     expr->operator = operator;
     expr->right = right;
     return expr;
 }
 
-static ExprNumber* makeExprNumber(BigInt value) {
-    ExprNumber* expr = malloc(sizeof(ExprNumber));
-    expr->type = EXPR_NUMBER;
-    expr->value = value;
+static ExprPowMod* makeExprPowMod(Expr* base, Expr* exponent, Expr* modulus) {
+    ExprPowMod* expr = ALLOCATE_NODE(ExprPowMod);
+    expr->type = EXPR_POWMOD;
+    expr->staticType = STATIC_UNKNOWN;
+    expr->base = base;
+    expr->exponent = exponent;
+    expr->modulus = modulus;
     return expr;
 }
 
+#define POOL_MAX_LOAD 0.75
+
+static ExprNumber** findConstant(ExprNumber** table, int capacity, uint64_t bits) {
+    uint32_t index = (uint32_t)((bits * UINT64_C(0x9e3779b97f4a7c15)) >> 32) & (capacity - 1);
+
+    for (;;) {
+        ExprNumber** entry = &table[index];
+        if (*entry == NULL || (*entry)->value.bits == bits) return entry;
+        index = (index + 1) & (capacity - 1);
+    }
+}
+
+static void growConstantTable(ConstantPool* pool) {
+    int capacity = pool->tableCapacity < 8 ? 8 : pool->tableCapacity * 2;
+    ExprNumber** table = calloc(capacity, sizeof(ExprNumber*));
+
+    for (int i = 0; i < pool->count; ++i) {
+        *findConstant(table, capacity, pool->numbers[i]->value.bits) = pool->numbers[i];
+    }
+
+    free(pool->table);
+    pool->table = table;
+    pool->tableCapacity = capacity;
+}
+
+// Returns the unit's node for the number, making it the first time. Each
+// node holds a reference to the interned number, so the set keeps it while
+// the unit lives.
+ExprNumber* makeExprNumber(Ast* ast, BigInt value) {
+    ConstantPool* pool = &ast->constants;
+    if (pool->count + 1 > pool->tableCapacity * POOL_MAX_LOAD) {
+        growConstantTable(pool);
+    }
+
+    BigInt interned = internNumber(value);
+    ExprNumber** entry = findConstant(pool->table, pool->tableCapacity, interned.bits);
+    if (*entry == NULL) {
+        ExprNumber* expr = arenaAlloc(&ast->arena, sizeof(ExprNumber));
+        expr->type = EXPR_NUMBER;
+        expr->staticType = STATIC_NUMBER;
+        expr->constant = pool->count;
+        expr->value = interned;
+
+        if (pool->count == pool->capacity) {
+            pool->capacity = pool->capacity < 8 ? 8 : pool->capacity * 2;
+            pool->numbers = realloc(pool->numbers, sizeof(ExprNumber*) * pool->capacity);
+        }
+        pool->numbers[pool->count++] = expr;
+        *entry = expr;
+        return expr;
+    }
+
+    bigint_free(&interned);
+    return *entry;
+}
+
 static ExprVar* makeExprVar(const char* name, int length) {
-    ExprVar* expr = malloc(sizeof(ExprVar));
+    ExprVar* expr = ALLOCATE_NODE(ExprVar);
     expr->type = EXPR_VAR;
+    expr->staticType = STATIC_UNKNOWN;
     expr->name = copyString(name, length);
+    expr->slot = -1;
     return expr;
 }
 
@@ -101,8 +171,8 @@ static Expr* expression();
 
 static Expr* atom() {
     if (match(TOKEN_NUMBER)) {
-        BigInt a = bigint_from_str(parser.previous.start, parser.previous.length);
-        return (Expr*)makeExprNumber(a);
+        BigInt value = bigint_from_str(parser.previous.start, parser.previous.length);
+        return (Expr*)makeExprNumber(parser.ast, value);
     }
     if (match(TOKEN_IDENTIFIER))
         return (Expr*)makeExprVar(parser.previous.start, parser.previous.length);
@@ -117,6 +187,19 @@ static Expr* atom() {
     return NULL;
 }
 
+static Expr* term();
+
+// Right associative and tighter than a unary minus on its left, as in Python
+static Expr* power() {
+    Expr* expr = atom();
+
+    if (match(TOKEN_STAR_STAR)) {
+        expr = (Expr*)makeExprBinary(TOKEN_STAR_STAR, expr, term());
+    }
+
+    return expr;
+}
+
 static Expr* term() {
     if (parser.current.type == TOKEN_MINUS) {
         advance();
@@ -124,17 +207,43 @@ static Expr* term() {
         return (Expr*)makeExprUnary(operator, term());
     }
 
-    return atom();
+    return power();
 }
 
-static Expr* sum() {
+static bool isPower(Expr* expr) {
+    return expr->type == EXPR_BINARY && ((ExprBinary*)expr)->operator == TOKEN_STAR_STAR;
+}
+
+static Expr* product() {
     Expr* expr = term();
 
+    while (parser.current.type == TOKEN_STAR ||
+           parser.current.type == TOKEN_SLASH ||
+           parser.current.type == TOKEN_PERCENT) {
+        advance();
+        TokenType operator = parser.previous.type;
+        Expr* right = term();
+
+        // a ** e % m is the three-argument modular power
+        if (operator == TOKEN_PERCENT && isPower(expr)) {
+            ExprBinary* pow = (ExprBinary*)expr;
+            expr = (Expr*)makeExprPowMod(pow->left, pow->right, right);
+        } else {
+            expr = (Expr*)makeExprBinary(operator, expr, right);
+        }
+    }
+
+    return expr;
+}
+
+static Expr* sum() {
+    Expr* expr = product();
+
     while (parser.current.type == TOKEN_PLUS ||
            parser.current.type == TOKEN_MINUS) {
         advance();
         TokenType operator = parser.previous.type;
-        expr = (Expr*)makeExprBinary(operator, expr, term());
+        expr = (Expr*)makeExprBinary(operator, expr, product());
     }
 
     return expr;
@@ -165,16 +274,18 @@ static Expr* comparison() {
 }
 
 ExprIn* makeInExpr(Expr* element, ExprVar* name) {
-    ExprIn* expr = malloc(sizeof(ExprIn));
+    ExprIn* expr = ALLOCATE_NODE(ExprIn);
     expr->expr.type = EXPR_IN;
+    expr->expr.staticType = STATIC_UNKNOWN;
     expr->element = element;
     expr->name = name;
     return expr;
 }
 
 ExprMorphism* makeMorphismExpr(Expr* from, Expr* to) {
-    ExprMorphism* expr = malloc(sizeof(ExprMorphism));
+    ExprMorphism* expr = ALLOCATE_NODE(ExprMorphism);
     expr->type = EXPR_MORPHISM;
+    expr->staticType = STATIC_UNKNOWN;
     expr->from = from;
     expr->to = to;
     return expr;
@@ -241,7 +352,7 @@ static Expr* expression() {
 }
 
 StmtAssign* makeStmtAssign(ExprVar* variable, Expr* expr) {
-    StmtAssign* assign = malloc(sizeof(StmtAssign));
+    StmtAssign* assign = ALLOCATE_NODE(StmtAssign);
     assign->stmt.type = STMT_ASSIGN;
     assign->stmt.next = NULL;
     assign->left = variable;
@@ -250,7 +361,7 @@ StmtAssign* makeStmtAssign(ExprVar* variable, Expr* expr) {
 }
 
 StmtPrint* makeStmtPrint(Expr* expr) {
-    StmtPrint* print = malloc(sizeof(StmtPrint));
+    StmtPrint* print = ALLOCATE_NODE(StmtPrint);
     print->stmt.type = STMT_PRINT;
     print->stmt.next = NULL;
     print->expr = expr;
@@ -258,7 +369,7 @@ StmtPrint* makeStmtPrint(Expr* expr) {
 }
 
 StmtIf* makeStmtIf(Expr* condition, Stmt* thenBranch, Stmt* elseBranch) {
-    StmtIf* ifStmt = malloc(sizeof(StmtIf));
+    StmtIf* ifStmt = ALLOCATE_NODE(StmtIf);
     ifStmt->stmt.type = STMT_IF;
     ifStmt->stmt.next = NULL;
     ifStmt->condition = condition;
@@ -268,11 +379,14 @@ StmtIf* makeStmtIf(Expr* condition, Stmt* thenBranch, Stmt* elseBranch) {
 }
 
 StmtWhile* makeStmtWhile(Expr* condition, Stmt* body) {
-    StmtWhile* whileStmt = malloc(sizeof(StmtWhile));
+    StmtWhile* whileStmt = ALLOCATE_NODE(StmtWhile);
     whileStmt->stmt.type = STMT_WHILE;
     whileStmt->stmt.next = NULL;
     whileStmt->condition = condition;
     whileStmt->body = body;
+    whileStmt->jit = NULL;
+    whileStmt->nextLoop = parser.ast->loops;
+    parser.ast->loops = whileStmt;
     return whileStmt;
 }
 
@@ -343,8 +457,9 @@ static bool isExprStart(TokenType type) {
 }
 
 static ExprCatInit* makeExprCatInit(ObjString* callee, Expr** args, int argCount) {
-    ExprCatInit* expr = malloc(sizeof(ExprCatInit));
+    ExprCatInit* expr = ALLOCATE_NODE(ExprCatInit);
     expr->expr.type = EXPR_CAT_INIT;
+    expr->expr.staticType = STATIC_UNKNOWN;
     expr->callee = callee;
     expr->args = args;
     expr->argCount = argCount;
@@ -358,12 +473,12 @@ static Expr* parseMaybeCatInit(Expr* expr) {
 
     int capacity = 8;
     int count = 0;
-    Expr** args = malloc(sizeof(Expr*) * capacity);
+    Expr** args = GROW_NODES(Expr*, NULL, 0, capacity);
 
     while (isTermStart(parser.current.type)) {
         if (count >= capacity) {
+            args = GROW_NODES(Expr*, args, capacity, capacity * 2);
             capacity *= 2;
-            args = realloc(args, sizeof(Expr*) * capacity);
         }
         args[count++] = term();
     }
@@ -371,7 +486,6 @@ static Expr* parseMaybeCatInit(Expr* expr) {
     consume(TOKEN_RIGHT_PAREN, "Expect ')' after category init arguments.");
 
     ObjString* callee = ((ExprVar*)expr)->name;
-    free(expr);
 
     return (Expr*)makeExprCatInit(callee, args, count);
 }
@@ -410,12 +524,12 @@ static void synchronize() {
 static void parseObjectSequence(Expr*** list, int* outCount, bool allow_newlines) {
     int capacity = 8;
     int count = 0;
-    Expr** values = malloc(sizeof(Expr*) * capacity);
+    Expr** values = GROW_NODES(Expr*, NULL, 0, capacity);
 
     while (isTermStart(parser.current.type)) {
         if (count >= capacity) {
+            values = GROW_NODES(Expr*, values, capacity, capacity * 2);
             capacity *= 2;
-            values = realloc(values, sizeof(Expr*) * capacity);
         }
 
         values[count++] = term();
@@ -444,7 +558,7 @@ TmplAdjMorphisms parseMorphism() {
 
 void parseHomset(TmplHomSet* homset) {
     int capacity = 8;
-    homset->morphisms = malloc(sizeof(TmplAdjMorphisms) * capacity);
+    homset->morphisms = GROW_NODES(TmplAdjMorphisms, NULL, 0, capacity);
     homset->count = 0;
 
     consume(TOKEN_NEWLINE, "Expect NEWLINE after 'hom'.");
@@ -452,8 +566,8 @@ void parseHomset(TmplHomSet* homset) {
     if (match(TOKEN_INDENT)) {
         while (isTermStart(parser.current.type)) {
             if (homset->count >= capacity) {
+                homset->morphisms = GROW_NODES(TmplAdjMorphisms, homset->morphisms, capacity, capacity * 2);
                 capacity *= 2;
-                homset->morphisms = realloc(homset->morphisms, sizeof(TmplAdjMorphisms) * capacity);
             }
 
             homset->morphisms[homset->count++] = parseMorphism();
@@ -488,7 +602,7 @@ void parseCategoryBlock(TmplObjects* objects, TmplHomSet* homset) {
 }
 
 StmtCat* makeStmtCat(ObjString* name, ObjString** params, int paramCount, TmplObjects objects, TmplHomSet homset) {
-    StmtCat* stmt = malloc(sizeof(StmtCat));
+    StmtCat* stmt = ALLOCATE_NODE(StmtCat);
     stmt->stmt.type = STMT_CAT;
     stmt->stmt.next = NULL;
     stmt->name = name;
@@ -496,6 +610,7 @@ StmtCat* makeStmtCat(ObjString* name, ObjString** params, int paramCount, TmplOb
     stmt->paramCount = paramCount;
     stmt->objects = objects;
     stmt->homset = homset;
+    stmt->ast = parser.ast;
     return stmt;
 }
 
@@ -511,13 +626,13 @@ Stmt* catStmt() {
     
     if (parser.current.type != (TOKEN_RIGHT_PAREN)) {
         capacity = 4;
-        params = malloc(sizeof(ObjString*) * capacity);
+        params = GROW_NODES(ObjString*, NULL, 0, capacity);
 
         do {
             consume(TOKEN_IDENTIFIER, "Expect parameter name.");
             if (paramCount >= capacity) {
+                params = GROW_NODES(ObjString*, params, capacity, capacity * 2);
                 capacity *= 2;
-                params = realloc(params, sizeof(ObjString*) * capacity);
             }
 
             params[paramCount++] = copyString(parser.previous.start, parser.previous.length);
@@ -550,13 +665,22 @@ static Stmt* statement() {
     return NULL;
 }
 
-bool parse(const char* source, Stmt** stmts) {
-    initScanner(source);
+bool parse(const char* source, size_t length, Ast** result) {
+    Ast* ast = malloc(sizeof(Ast));
+    ast->stmts = NULL;
+    initArena(&ast->arena);
+    ast->constants = (ConstantPool){ 0 };
+    ast->loops = NULL;
+    ast->refs = 1;
+    *result = ast;
+
+    initScanner(source, length);
     parser.hadError = false;
     parser.panicMode = false;
+    parser.ast = ast;
     advance();
 
-    *stmts = NULL;
+    Stmt** stmts = &ast->stmts;
 
     while (parser.current.type != TOKEN_EOF) {
         *stmts = statement();
@@ -565,118 +689,25 @@ bool parse(const char* source, Stmt** stmts) {
             stmts = &((*stmts)->next); // sorry >> no
     }
 
+    parser.ast = NULL;
     return !parser.hadError;
 }
 
-static void freeExpr(Expr* expr);
-
-static void freeExprBinary(ExprBinary* expr) {
-    freeExpr(expr->left);
-    freeExpr(expr->right);
-    free(expr);
-}
-
-static void freeExprUnary(ExprUnary* expr) {
-    freeExpr(expr->right);
-    free(expr);
-}
-
-static void freeExprIn(ExprIn* expr) {
-    freeExpr(expr->element);
-    if (expr->name != NULL)
-        free(expr->name);  // expr->name is an ExprVar* with allocated name string
-    free(expr);
-}
-
-static void freeExprMorphism(ExprMorphism* expr) {
-    freeExpr(expr->from);
-    freeExpr(expr->to);
-    free(expr);
-}
-
-static void freeExprCatInit(ExprCatInit* expr) {
-    for (int i = 0; i < expr->argCount; i++) {
-        freeExpr(expr->args[i]);
-    }
-    free(expr->args);
-    free(expr);
-}
-
-static void freeExpr(Expr* expr) {
-    if (expr == NULL)
-        return;
-    
-    switch (expr->type) {
-        case EXPR_BINARY : freeExprBinary((ExprBinary*)expr); break;
-        case EXPR_UNARY  : freeExprUnary((ExprUnary*)expr);   break;
-        case EXPR_NUMBER : free(expr);                        break;
-        case EXPR_VAR    : free(expr);                        break;
-        case EXPR_IN     : freeExprIn((ExprIn*)expr);         break;
-        case EXPR_MORPHISM: freeExprMorphism((ExprMorphism*)expr); break;
-        case EXPR_CAT_INIT: freeExprCatInit((ExprCatInit*)expr); break;
-
-
-    }
-}
-
-static void freeStmtAssign(StmtAssign* stmt) {
-    freeExpr((Expr*)stmt->left);
-    freeExpr(stmt->right);
-    free(stmt);
-}
-
-static void freeStmtPrint(StmtPrint* stmt) {
-    freeExpr(stmt->expr);
-    free(stmt);
+void retainAst(Ast* ast) {
+    ast->refs++;
 }
 
-static void freeStmtIf(StmtIf* stmt) {
-    freeExpr(stmt->condition);
-    freeAST(stmt->thenBranch);
-    freeAST(stmt->elseBranch);
-    free(stmt);
-}
-static void freeStmtWhile(StmtWhile* stmt) {
-    freeExpr(stmt->condition);
-    freeAST(stmt->body);
-    free(stmt);
-}
+void releaseAst(Ast* ast) {
+    if (ast == NULL || --ast->refs > 0) return;
 
-static void freeStmtCat(StmtCat* stmt) {
-    for (int i = 0; i < stmt->objects.count; i++) {
-        freeExpr(stmt->objects.values[i]);
-    }
-    free(stmt->objects.values);
-
-    for (int i = 0; i < stmt->homset.count; i++) {
-        freeExpr(stmt->homset.morphisms[i].from);
-        for (int j = 0; j < stmt->homset.morphisms[i].toCount; j++) {
-            freeExpr(stmt->homset.morphisms[i].to[j]);
-        }
-        free(stmt->homset.morphisms[i].to);
+    for (StmtWhile* loop = ast->loops; loop != NULL; loop = loop->nextLoop) {
+        freeJitLoop(loop->jit);
     }
-
-    free(stmt->homset.morphisms);
-    free(stmt->params);
-
-    free(stmt);
-}
-
-
-
-void freeAST(Stmt* stmts) {
-    if (stmts == NULL)
-        return;
-
-    while (stmts != NULL) {
-        Stmt* next = stmts->next;
-        switch (stmts->type) {
-            case STMT_ASSIGN : freeStmtAssign((StmtAssign*)stmts); break;
-            case STMT_PRINT  : freeStmtPrint((StmtPrint*)stmts);   break;
-            case STMT_IF     : freeStmtIf((StmtIf*)stmts);         break;
-            case STMT_WHILE  : freeStmtWhile((StmtWhile*)stmts);   break;
-            case STMT_CAT    : freeStmtCat((StmtCat*)stmts);       break; //TODO repl problem
-        }
-        stmts = next;
+    for (int i = 0; i < ast->constants.count; i++) {
+        bigint_free(&ast->constants.numbers[i]->value);
     }
+    free(ast->constants.numbers);
+    free(ast->constants.table);
+    freeArena(&ast->arena);
+    free(ast);
 }
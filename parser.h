@@ -1,46 +1,80 @@
 #ifndef cryton_parser_h
 #define cryton_parser_h
 
+#include "arena.h"
 #include "value.h"
 #include "bigint.h"
 #include "scanner.h"
 
 typedef enum {
-    EXPR_BINARY, EXPR_UNARY,
+    EXPR_BINARY, EXPR_UNARY, EXPR_POWMOD,
     EXPR_NUMBER, EXPR_VAR,
     EXPR_IN, EXPR_MORPHISM,
     EXPR_CAT_INIT
 } ExprType;
 
 
+// What the type checker proved an expression evaluates to, without any
+// check failing on the way. Unknown ones are checked as they run.
+typedef enum {
+    STATIC_UNKNOWN,
+    STATIC_NUMBER,
+    STATIC_CATEGORY,
+    STATIC_TEMPLATE
+} StaticType;
+
+// Every expression starts with these. They are single bytes so that the
+// nodes evaluated most, operators, variables and numbers, take 16 or 24
+// bytes and several share a cache line.
 typedef struct Expr{
-    ExprType type;
+    uint8_t type;           // ExprType
+    uint8_t staticType;     // StaticType
 } Expr;
 
 typedef struct
 {
-    ExprType type;
-    TokenType operator;
+    uint8_t type;
+    uint8_t staticType;
+    uint8_t operator;       // TokenType
     Expr* left;
     Expr* right;
 } ExprBinary;
 
 typedef struct {
-    ExprType type;
-    TokenType operator;
+    uint8_t type;
+    uint8_t staticType;
+    uint8_t operator;
     Expr* right;
 } ExprUnary;
 
+// base ** exponent % modulus, evaluated without the full power
+typedef struct {
+    uint8_t type;
+    uint8_t staticType;
+    Expr* base;
+    Expr* exponent;
+    Expr* modulus;
+} ExprPowMod;
+
+// Shared by every occurrence of the number in its unit. The value is
+// interned, so equal numbers have equal words.
 typedef struct {
-    ExprType type;
+    uint8_t type;
+    uint8_t staticType;
+    int constant;   // Index in the unit's constant pool
     BigInt value;
 } ExprNumber;
 
 typedef struct {
-    ExprType type;
+    uint8_t type;
+    uint8_t staticType;
+    int slot;   // Global slot from the resolver, -1 inside category templates
     ObjString* name;
 } ExprVar;
 
+_Static_assert(sizeof(ExprBinary) <= 24 && sizeof(ExprVar) <= 16 && sizeof(ExprNumber) <= 16,
+               "Hot expression nodes must stay compact");
+
 typedef enum {
     STMT_ASSIGN, STMT_PRINT,
     STMT_IF, STMT_WHILE,
@@ -79,12 +113,36 @@ typedef struct {
     Stmt* elseBranch;
 } StmtIf;
 
-typedef struct {
+struct JitLoop;
+
+typedef struct StmtWhile {
     Stmt stmt;
     Expr* condition;
     Stmt* body;
+    struct JitLoop* jit;    // Native code for the loop, made once it runs hot
+    struct StmtWhile* nextLoop;     // The loop parsed before it, so its code can be freed
 } StmtWhile;
 
+// The distinct numbers of a unit, numbered in the order they first appear.
+// The VM takes its constant table from here.
+typedef struct {
+    int count;
+    int capacity;
+    ExprNumber** numbers;
+    int tableCapacity;
+    ExprNumber** table;     // By value, NULL marks an empty slot
+} ConstantPool;
+
+// One parsed source. Every node lives in the arena and goes away with it,
+// once the caller and each template defined by the source let go.
+typedef struct Ast {
+    Stmt* stmts;
+    Arena arena;
+    ConstantPool constants;
+    StmtWhile* loops;
+    int refs;
+} Ast;
+
 typedef struct {
     Stmt stmt;
     ObjString* name;
@@ -92,13 +150,19 @@ typedef struct {
     int paramCount;
     TmplObjects objects;
     TmplHomSet homset;
+    Ast* ast;       // Templates keep it alive, as their parts are its nodes
 } StmtCat;
 
-bool parse(const char* source, Stmt** stmts);
-void freeAST(Stmt* stmts);
+// Parses `length` bytes of `source`. Returns the unit even when there are
+// errors, so it can be released.
+bool parse(const char* source, size_t length, Ast** ast);
+void retainAst(Ast* ast);
+void releaseAst(Ast* ast);
+ExprNumber* makeExprNumber(Ast* ast, BigInt value);
 
 typedef struct {
-    ExprType type;
+    uint8_t type;
+    uint8_t staticType;
     Expr* from;
     Expr* to;
 } ExprMorphism;
@@ -0,0 +1,99 @@
+#include "interpreter.h"
+#include "resolver.h"
+
+static void resolveExpr(Expr* expr);
+
+static void resolveVar(ExprVar* var) {
+    var->slot = globalSlot(&interp.globals, var->name);
+}
+
+static void resolveExpr(Expr* expr) {
+    switch (expr->type) {
+        case EXPR_BINARY: {
+            ExprBinary* binary = (ExprBinary*)expr;
+            resolveExpr(binary->left);
+            resolveExpr(binary->right);
+            break;
+        }
+
+        case EXPR_UNARY:
+            resolveExpr(((ExprUnary*)expr)->right);
+            break;
+
+        case EXPR_POWMOD: {
+            ExprPowMod* powMod = (ExprPowMod*)expr;
+            resolveExpr(powMod->base);
+            resolveExpr(powMod->exponent);
+            resolveExpr(powMod->modulus);
+            break;
+        }
+
+        case EXPR_VAR:
+            resolveVar((ExprVar*)expr);
+            break;
+
+        case EXPR_IN: {
+            ExprIn* in = (ExprIn*)expr;
+            resolveExpr(in->element);
+            resolveVar(in->name);
+            break;
+        }
+
+        case EXPR_MORPHISM: {
+            ExprMorphism* morph = (ExprMorphism*)expr;
+            resolveExpr(morph->from);
+            resolveExpr(morph->to);
+            break;
+        }
+
+        case EXPR_CAT_INIT: {
+            ExprCatInit* init = (ExprCatInit*)expr;
+            globalSlot(&interp.globals, init->callee);
+            for (int i = 0; i < init->argCount; ++i) {
+                resolveExpr(init->args[i]);
+            }
+            break;
+        }
+
+        case EXPR_NUMBER:
+            break;
+    }
+}
+
+// Slots are created up front, so the globals array never grows while a
+// program holds pointers into it
+void resolve(Stmt* stmt) {
+    for (; stmt != NULL; stmt = stmt->next) {
+        switch (stmt->type) {
+            case STMT_ASSIGN: {
+                StmtAssign* assign = (StmtAssign*)stmt;
+                resolveVar(assign->left);
+                resolveExpr(assign->right);
+                break;
+            }
+
+            case STMT_PRINT:
+                resolveExpr(((StmtPrint*)stmt)->expr);
+                break;
+
+            case STMT_IF: {
+                StmtIf* ifStmt = (StmtIf*)stmt;
+                resolveExpr(ifStmt->condition);
+                resolve(ifStmt->thenBranch);
+                resolve(ifStmt->elseBranch);
+                break;
+            }
+
+            case STMT_WHILE: {
+                StmtWhile* whileStmt = (StmtWhile*)stmt;
+                resolveExpr(whileStmt->condition);
+                resolve(whileStmt->body);
+                break;
+            }
+
+            case STMT_CAT:
+                globalSlot(&interp.globals, ((StmtCat*)stmt)->name);
+                break;
+        }
+    }
+}
@@ -0,0 +1,11 @@
+#ifndef cryton_resolver_h
+#define cryton_resolver_h
+
+#include "parser.h"
+
+// Gives every top-level variable a slot in interp.globals. Names inside
+// category templates stay unresolved: they refer to the template's
+// parameters, which are bound by name when the category is created.
+void resolve(Stmt* stmts);
+
+#endif
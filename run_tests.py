@@ -14,6 +14,14 @@ INDENT = "   "
 EXECUTABLE = "./build/cryton"
 TEST_DIR = "tests"
 VALGRIND_MODE = "--valgrind" in sys.argv
+# Run the tree-walking interpreter instead of the bytecode VM
+ENGINE_FLAGS = ["-t"] if "--tree" in sys.argv else []
+# Compile every eligible loop to native code the first time it runs
+if "--jit" in sys.argv:
+    ENGINE_FLAGS.append("-J")
+# Compile each test to C with --emit-c and run the native program instead
+AOT_MODE = "--aot" in sys.argv
+AOT_BUILD_DIR = "build/aot"
 
 
 def format_block(header, content):
@@ -68,7 +76,7 @@ def parse_valgrind_leaks(stderr_output):
 
 def run_valgrind(test_file):
     result = subprocess.run([
-        "valgrind", "--leak-check=full", "--error-exitcode=99", EXECUTABLE, test_file
+        "valgrind", "--leak-check=full", "--error-exitcode=99", EXECUTABLE, *ENGINE_FLAGS, test_file
     ], capture_output=True, text=True)
 
     stderr = result.stderr.strip()
@@ -90,18 +98,44 @@ def run_valgrind(test_file):
         return True
 
 
+def run_aot(test_file):
+    name = os.path.splitext(os.path.relpath(test_file, TEST_DIR))[0].replace(os.sep, "_")
+    c_file = os.path.join(AOT_BUILD_DIR, name + ".c")
+    binary = os.path.join(AOT_BUILD_DIR, name)
+
+    # Parse errors come from the emitter, like they come from the interpreter
+    result = subprocess.run([EXECUTABLE, "--emit-c", test_file], capture_output=True, text=True, timeout=5)
+    if result.returncode != 0:
+        return result
+
+    os.makedirs(AOT_BUILD_DIR, exist_ok=True)
+    with open(c_file, "w") as file:
+        file.write(result.stdout)
+
+    compiled = subprocess.run([os.environ.get("CC", "cc"), "-O2", "-I.", c_file, "build/libcryton.a", "-o", binary],
+                              capture_output=True, text=True)
+    if compiled.returncode != 0:
+        return compiled
+
+    return subprocess.run([binary], capture_output=True, text=True, timeout=5)
+
+
 def run_test(test_file):
     if VALGRIND_MODE:
         return run_valgrind(test_file)
 
     expected_output, expected_error = extract_expected_output(test_file)
 
-    result = subprocess.run([EXECUTABLE, test_file], capture_output=True, text=True, timeout=5)
+    if AOT_MODE:
+        result = run_aot(test_file)
+    else:
+        result = subprocess.run([EXECUTABLE, *ENGINE_FLAGS, test_file], capture_output=True, text=True, timeout=5)
     actual_output = result.stdout.strip().replace('\r\n', '\n')
     stderr_output = result.stderr.strip()
 
     if expected_error:
-        if expected_error in stderr_output:
+        # A crash after printing the message still fails
+        if expected_error in stderr_output and result.returncode >= 0:
             print(f"{GREEN}[EXPECTED ERROR]{RESET} {os.path.relpath(test_file, TEST_DIR)}")
             return True
         else:
@@ -142,6 +176,12 @@ def main():
                     failed += 1
 
     mode_msg = "Memory check (Valgrind)" if VALGRIND_MODE else "Functional test"
+    if "-t" in ENGINE_FLAGS:
+        mode_msg += " (tree walker)"
+    if "-J" in ENGINE_FLAGS:
+        mode_msg += " (JIT forced)"
+    if AOT_MODE:
+        mode_msg += " (compiled to C)"
     print(f"\n{CYAN}{mode_msg} result: {passed}/{total} passed, {failed} failed.{RESET}")
     sys.exit(1 if failed else 0)
 
@@ -6,7 +6,7 @@
 
 const char* TokenName[] = {
     "TOKEN_LEFT_PAREN", "TOKEN_RIGHT_PAREN", "TOKEN_COLON",
-    "TOKEN_PLUS", "TOKEN_MINUS", "TOKEN_SLASH", "TOKEN_STAR",
+    "TOKEN_PLUS", "TOKEN_MINUS", "TOKEN_SLASH", "TOKEN_STAR", "TOKEN_STAR_STAR", "TOKEN_PERCENT",
     "TOKEN_LESS", "TOKEN_GREATER",
 
     "TOKEN_EQUAL", "TOKEN_EQUAL_EQUAL",
@@ -30,11 +30,13 @@ const char* TokenName[] = {
 typedef struct {
     const char* start;
     const char* current;
+    const char* end;        // The source is [start, end), with no sentinel
     int line;
     int indent;
     int indentLevel;
     int indentStack[128];
     bool blankLine;
+    bool lineStart;         // Nothing but indentation since the last NEWLINE
 } Scanner;
 
 Scanner scanner;
@@ -83,7 +85,7 @@ static bool isWhitespace(char c) {
 }
 
 static bool isAtEnd() {
-    return *scanner.current == '\0';
+    return scanner.current >= scanner.end;
 }
 
 static char advance() {
@@ -92,11 +94,12 @@ static char advance() {
 }
 
 static char peek() {
+    if (isAtEnd()) return '\0';
     return *scanner.current;
 }
 
 static char peekNext() {
-    if (isAtEnd()) return '\0';
+    if (scanner.current + 1 >= scanner.end) return '\0';
     return scanner.current[1];
 }
 
@@ -232,6 +235,7 @@ static Token indent() {
 static Token newline() {
     Token token = makeTokenCustom(TOKEN_NEWLINE, "NEWLINE");
     scanner.line++;
+    scanner.lineStart = true;
     consumeIndent();
     return token;
 }
@@ -241,8 +245,13 @@ Token scanToken() {
     scanner.start = scanner.current;
 
     if (pendingIndent()) return indent();
-    if (isAtEnd()) return makeToken(TOKEN_EOF);
+    if (isAtEnd()) {
+        // A last line without its newline still ends its statement
+        if (!scanner.lineStart) return newline();
+        return makeToken(TOKEN_EOF);
+    }
 
+    scanner.lineStart = false;
     char c = advance();
 
     if (isAlpha(c)) return identifier();
@@ -256,7 +265,9 @@ Token scanToken() {
         case '-' : 
             return makeToken(match('>') ? TOKEN_ARROW : TOKEN_MINUS);
         case '/' : return makeToken(TOKEN_SLASH);
-        case '*' : return makeToken(TOKEN_STAR);
+        case '*' :
+            return makeToken(match('*') ? TOKEN_STAR_STAR : TOKEN_STAR);
+        case '%' : return makeToken(TOKEN_PERCENT);
         case '<' : return makeToken(TOKEN_LESS);
         case '>' : return makeToken(TOKEN_GREATER);
 
@@ -271,12 +282,14 @@ Token scanToken() {
     return errorToken("Unexpected character.");
 }
 
-void initScanner(const char* source) {
+void initScanner(const char* source, size_t length) {
     scanner.start = source;
     scanner.current = source;
+    scanner.end = source + length;
     scanner.line = 1;
     scanner.indentLevel = 0;
     scanner.indentStack[scanner.indentLevel] = 0;
     scanner.blankLine = true;
+    scanner.lineStart = true;
     consumeIndent();
 }
@@ -1,9 +1,11 @@
 #ifndef cryton_scanner_h
 #define cryton_scanner_h
 
+#include <stddef.h>
+
 typedef enum {
     TOKEN_LEFT_PAREN, TOKEN_RIGHT_PAREN, TOKEN_COLON,
-    TOKEN_PLUS, TOKEN_MINUS, TOKEN_SLASH, TOKEN_STAR,
+    TOKEN_PLUS, TOKEN_MINUS, TOKEN_SLASH, TOKEN_STAR, TOKEN_STAR_STAR, TOKEN_PERCENT,
     TOKEN_LESS, TOKEN_GREATER, 
 
     TOKEN_EQUAL, TOKEN_EQUAL_EQUAL,
@@ -33,7 +35,8 @@ typedef struct {
     int line;
 } Token;
 
-void initScanner(const char* source);
+// Scans `length` bytes of `source`, which needs no trailing newline or NUL
+void initScanner(const char* source, size_t length);
 Token scanToken();
 
 #endif
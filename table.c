@@ -15,64 +15,29 @@ void initTable(Table* table) {
     table->entries = NULL;
 }
 
-void freeCategory(RuntimeCategory* cat) {
-    if (cat == NULL) return;
-
-    // Free the array of objects
-    if (cat->objects.values != NULL) {
-        free(cat->objects.values);
-        cat->objects.values = NULL;
-    }
-
-    // Free each morphism's `to` array
-    for (int i = 0; i < cat->homset.count; i++) {
-        Morphism* m = &cat->homset.morphisms[i];
-        if (m->to != NULL) {
-            free(m->to);
-            m->to = NULL;
-        }
-    }
-
-    // Free the array of morphisms
-    if (cat->homset.morphisms != NULL) {
-        free(cat->homset.morphisms);
-        cat->homset.morphisms = NULL;
-    }
-
-    // Finally, free the category structure itself
-    free(cat);
-}
-
-void freeTemplate(CategoryTemplate* templ) {
-    if (templ == NULL) return;
-    
-    free(templ);
-}
-
-// Free table and all contained strings
-void freeTable(Table* table, bool freeKeys) {
+void freeTable(Table* table) {
     if (table == NULL || table->entries == NULL)
         return;
 
     for (int i = 0; i < table->capacity; ++i) {
-    Entry* entry = &table->entries[i];
-    if (entry->key != NULL) {
-        if (freeKeys) {
-            freeString(entry->key);  // Clean key
-            if (entry->value.type == VALUE_CATEGORY && entry->value.category != NULL) {
-                freeCategory(entry->value.category);
-            }
-        }
-        if (entry->value.type == VALUE_CAT_TEMPLATE && entry->value.template != NULL) {
-            freeTemplate(entry->value.template);
-        }
+        freeValue(&table->entries[i].value);
     }
-}
 
     free(table->entries);
     initTable(table);
 }
 
+void tableClear(Table* table) {
+    for (int i = 0; i < table->capacity; ++i) {
+        Entry* entry = &table->entries[i];
+        freeValue(&entry->value);
+        entry->key = NULL;
+        entry->value.type = VALUE_NULL;
+        bigint_init(&entry->value.number, 0);
+    }
+    table->count = 0;
+}
+
 static Entry* findEntry(Entry* entries, int capacity, ObjString* key) {
     uint32_t index = key->hash % capacity;
     Entry* tombstone = NULL;
@@ -139,6 +104,15 @@ bool tableGet(Table* table, ObjString* key, Value* value) {
     return true;
 }
 
+Value* tableGetRef(Table* table, ObjString* key) {
+    if (table->count == 0) return NULL;
+
+    Entry* entry = findEntry(table->entries, table->capacity, key);
+    if (entry->key == NULL) return NULL;
+
+    return &entry->value;
+}
+
 bool tableSet(Table* table, ObjString* key, Value value) {
     if (table->count + 1 > table->capacity * TABLE_MAX_LOAD) {
         int capacity = GROW_CAPACITY(table->capacity);
@@ -149,11 +123,7 @@ bool tableSet(Table* table, ObjString* key, Value value) {
     bool isNewKey = entry->key == NULL;
 
     if (!isNewKey) {
-        if (entry->value.type == VALUE_CATEGORY && entry->value.category != NULL) {
-            freeCategory(entry->value.category);
-        } else if (entry->value.type == VALUE_CAT_TEMPLATE && entry->value.template != NULL) {
-            freeTemplate(entry->value.template);
-        }
+        freeValue(&entry->value);
     }
     
     
@@ -178,23 +148,177 @@ bool tableDelete(Table* table, ObjString* key) {
     return true;
 }
 
-ObjString* tableFindString(Table* table, const char* chars, int length, uint32_t hash) {
-    if (table->count == 0) return NULL;
+void initStringSet(StringSet* set) {
+    set->count = 0;
+    set->capacity = 0;
+    set->entries = NULL;
+}
+
+void freeStringSet(StringSet* set) {
+    for (int i = 0; i < set->capacity; ++i) {
+        freeString(set->entries[i]);
+    }
+    free(set->entries);
+    initStringSet(set);
+}
 
-    uint32_t index = hash % table->capacity;
+ObjString* stringSetFind(StringSet* set, const char* chars, int length, uint32_t hash) {
+    if (set->count == 0) return NULL;
 
+    uint32_t index = hash % set->capacity;
     for (;;) {
-        Entry* entry = &table->entries[index];
+        ObjString* entry = set->entries[index];
+        if (entry == NULL) return NULL;
 
-        if (entry->key == NULL) {
-            if (entry->value.type == VALUE_NULL)
-                return NULL;
-        } else if (entry->key->length == length &&
-                   entry->key->hash == hash &&
-                   memcmp(entry->key->chars, chars, length) == 0) {
-            return entry->key;
+        if (entry->hash == hash && entry->length == length &&
+            memcmp(entry->chars, chars, length) == 0) {
+            return entry;
         }
 
-        index = (index + 1) % table->capacity;
+        index = (index + 1) % set->capacity;
     }
 }
+
+static void stringSetInsert(ObjString** entries, int capacity, ObjString* string) {
+    uint32_t index = string->hash % capacity;
+    while (entries[index] != NULL) {
+        index = (index + 1) % capacity;
+    }
+    entries[index] = string;
+}
+
+void stringSetAdd(StringSet* set, ObjString* string) {
+    if (set->count + 1 > set->capacity * TABLE_MAX_LOAD) {
+        int capacity = GROW_CAPACITY(set->capacity);
+        ObjString** entries = calloc(capacity, sizeof(ObjString*));
+
+        for (int i = 0; i < set->capacity; ++i) {
+            if (set->entries[i] != NULL) stringSetInsert(entries, capacity, set->entries[i]);
+        }
+
+        free(set->entries);
+        set->entries = entries;
+        set->capacity = capacity;
+    }
+
+    stringSetInsert(set->entries, set->capacity, string);
+    set->count++;
+}
+
+void initGlobals(Globals* globals) {
+    globals->count = 0;
+    globals->capacity = 0;
+    globals->values = NULL;
+    globals->names = NULL;
+    initTable(&globals->slots);
+}
+
+void freeGlobals(Globals* globals) {
+    for (int i = 0; i < globals->count; ++i) {
+        freeValue(&globals->values[i]);
+    }
+    free(globals->values);
+    free(globals->names);
+    freeTable(&globals->slots);
+    initGlobals(globals);
+}
+
+int findGlobalSlot(Globals* globals, ObjString* name) {
+    Value* slot = tableGetRef(&globals->slots, name);
+    return slot == NULL ? -1 : (int)BIGINT_SMALL_VALUE(&slot->number);
+}
+
+int globalSlot(Globals* globals, ObjString* name) {
+    int slot = findGlobalSlot(globals, name);
+    if (slot >= 0) return slot;
+
+    if (globals->count + 1 > globals->capacity) {
+        globals->capacity = GROW_CAPACITY(globals->capacity);
+        globals->values = realloc(globals->values, sizeof(Value) * globals->capacity);
+        globals->names = realloc(globals->names, sizeof(ObjString*) * globals->capacity);
+    }
+
+    slot = globals->count++;
+    globals->values[slot].type = VALUE_NULL;
+    globals->values[slot].number = BIGINT_ZERO;
+    globals->names[slot] = name;
+
+    Value index = { .type = VALUE_NUMBER, .number = bigint_from_i64(slot) };
+    tableSet(&globals->slots, name, index);
+    return slot;
+}
+
+void setGlobal(Globals* globals, int slot, Value value) {
+    freeValue(&globals->values[slot]);
+    globals->values[slot] = value;
+}
+
+void initNumberSet(NumberSet* set) {
+    set->count = 0;
+    set->capacity = 0;
+    set->entries = NULL;
+    set->lastId = 0;
+}
+
+void freeNumberSet(NumberSet* set) {
+    for (int i = 0; i < set->capacity; ++i) {
+        if (set->entries[i].bits != 0) bigint_free(&set->entries[i]);
+    }
+    free(set->entries);
+    initNumberSet(set);
+}
+
+static BigInt* findNumberEntry(BigInt* entries, int capacity, const BigInt* num, uint32_t hash) {
+    uint32_t index = hash % capacity;
+    for (;;) {
+        BigInt* entry = &entries[index];
+        if (entry->bits == 0) return entry;
+
+        BigNum* heap = BIGINT_AS_NUM(entry);
+        if (heap->hash == hash && bigint_abs_compare(entry, num) == 0) return entry;
+
+        index = (index + 1) % capacity;
+    }
+}
+
+BigInt* numberSetFind(NumberSet* set, const BigInt* num, uint32_t hash) {
+    if (set->count == 0) return NULL;
+
+    BigInt* entry = findNumberEntry(set->entries, set->capacity, num, hash);
+    return entry->bits == 0 ? NULL : entry;
+}
+
+void numberSetAdd(NumberSet* set, BigInt num) {
+    if (set->count + 1 > set->capacity * TABLE_MAX_LOAD) {
+        // Numbers only the set refers to are dead. Dropping them first keeps
+        // the set the size of what is live, growing only if that is still full.
+        int live = 0;
+        for (int i = 0; i < set->capacity; ++i) {
+            BigInt* old = &set->entries[i];
+            if (old->bits != 0 && BIGINT_AS_NUM(old)->refCount > 1) live++;
+        }
+
+        int capacity = set->capacity;
+        if (live + 1 > capacity * TABLE_MAX_LOAD / 2) capacity = GROW_CAPACITY(capacity);
+        BigInt* entries = calloc(capacity, sizeof(BigInt));
+
+        for (int i = 0; i < set->capacity; ++i) {
+            BigInt* old = &set->entries[i];
+            if (old->bits == 0) continue;
+
+            if (BIGINT_AS_NUM(old)->refCount == 1) {
+                bigint_free(old);
+            } else {
+                *findNumberEntry(entries, capacity, old, BIGINT_AS_NUM(old)->hash) = *old;
+            }
+        }
+
+        free(set->entries);
+        set->entries = entries;
+        set->capacity = capacity;
+        set->count = live;
+    }
+
+    *findNumberEntry(set->entries, set->capacity, &num, BIGINT_AS_NUM(&num)->hash) = num;
+    set->count++;
+}
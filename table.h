@@ -9,18 +9,68 @@ typedef struct {
     Value value;
 } Entry;
 
+// Maps names to values. Keys belong to interp.strings, and the table holds
+// a reference to each value.
 typedef struct {
     int count;
     int capacity;
     Entry* entries;
 } Table;
 
+// Interned identifiers. The set owns the strings.
+typedef struct {
+    int count;
+    int capacity;
+    ObjString** entries;    // NULL marks an empty slot
+} StringSet;
+
+// Interned heap numbers, keyed by value. Each entry holds a reference, and
+// entries nothing else refers to are dropped when the set fills up.
+typedef struct {
+    int count;
+    int capacity;
+    BigInt* entries;  // bits == 0 marks an empty slot
+    uint32_t lastId;  // Only increases, so dropped entries never lend their IDs
+} NumberSet;
+
+// Global variables in dense slots, so resolved code reads them by index.
+// `slots` maps each name to its slot for the resolver, name-based lookups
+// and later REPL entries. Each slot holds a reference to its value.
+typedef struct {
+    int count;
+    int capacity;
+    Value* values;      // VALUE_NULL until first assigned
+    ObjString** names;
+    Table slots;
+} Globals;
+
 void initTable(Table* table);
-void freeTable(Table* table, bool freeKeys);
+void freeTable(Table* table);
+// Empties the table but keeps its storage for the next use
+void tableClear(Table* table);
 ObjString* tableFindKey(Table* table, Value val);
 bool tableGet(Table* table, ObjString* key, Value* value);
+// Borrowed pointer to the stored value, valid until the table next changes
+Value* tableGetRef(Table* table, ObjString* key);
 bool tableSet(Table* table, ObjString* key, Value value);
 bool tableDelete(Table* table, ObjString* key);
-ObjString* tableFindString(Table* table, const char* chars, int length, uint32_t hash);
+
+void initStringSet(StringSet* set);
+void freeStringSet(StringSet* set);
+ObjString* stringSetFind(StringSet* set, const char* chars, int length, uint32_t hash);
+void stringSetAdd(StringSet* set, ObjString* string);
+
+void initGlobals(Globals* globals);
+void freeGlobals(Globals* globals);
+// Finds the slot for `name`, adding an empty one the first time
+int globalSlot(Globals* globals, ObjString* name);
+// Returns -1 when `name` has no slot
+int findGlobalSlot(Globals* globals, ObjString* name);
+void setGlobal(Globals* globals, int slot, Value value);
+
+void initNumberSet(NumberSet* set);
+void freeNumberSet(NumberSet* set);
+BigInt* numberSetFind(NumberSet* set, const BigInt* num, uint32_t hash);
+void numberSetAdd(NumberSet* set, BigInt num);
 
 #endif
@@ -0,0 +1,7 @@
+a = 10
+b = 0
+
+print(a / (b + 1))
+print(a % b)
+
+# EXPECT ERROR: Division by zero.
@@ -0,0 +1,5 @@
+# The category after 'in' is checked before the element is evaluated
+k = 5
+print(zz in k)
+
+# EXPECT ERROR: Expected a variable of type category after 'in', but got 'Number'.
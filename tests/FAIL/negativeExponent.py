@@ -0,0 +1,4 @@
+print(2 ** 5)
+print(2 ** -1)
+
+# EXPECT ERROR: Negative exponent.
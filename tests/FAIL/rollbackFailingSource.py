@@ -0,0 +1,20 @@
+# The half-built category owns big numbers and a nested category's
+# morphisms when the second morphism's source fails
+cat Inner():
+    obj:
+        1 2
+    hom:
+        1 -> 2
+
+cat T(big inner):
+    obj:
+        big (big + 1) inner
+    hom:
+        big -> (big + 1) 1
+        (big / 0) -> big
+
+big = 123456789012345678901234567890
+inner = Inner()
+t = T(big inner)
+
+# EXPECT ERROR: Division by zero.
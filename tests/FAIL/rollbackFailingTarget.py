@@ -0,0 +1,21 @@
+# The half-built category owns big numbers, a nested category's
+# morphisms and one target of the failing morphism when its second
+# target fails
+cat Inner():
+    obj:
+        1 2
+    hom:
+        1 -> 2
+
+cat T(big inner):
+    obj:
+        big (big + 1) inner
+    hom:
+        big -> (big + 1)
+        (big + 1) -> big zz 2
+
+big = 123456789012345678901234567890
+inner = Inner()
+t = T(big inner)
+
+# EXPECT ERROR: Undefined variable 'zz'.
@@ -0,0 +1,19 @@
+cat Pair(a b):
+    obj:
+        a b
+    hom:
+        a -> b
+
+# Whether a loop finishes is not known before running, so the error after it
+# is reported when it is reached, after the loop's output
+i = 0
+total = 0
+while i < 100000:
+    total = total + i
+    i = i + 1
+
+print(total)
+# EXPECT: 4999950000
+print(Pair + 1)
+
+# EXPECT ERROR: But got values of types 'Category Template' and 'Number'
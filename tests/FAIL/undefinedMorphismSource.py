@@ -0,0 +1,9 @@
+cat T():
+    obj:
+        1 2
+    hom:
+        zz -> 1
+
+x = T()
+
+# EXPECT ERROR: Undefined variable 'zz'.
@@ -0,0 +1,14 @@
+cat Pair(a):
+    obj:
+        a (a + 1)
+    hom:
+        a -> (a + 1)
+
+p = Pair(1)
+big = 100000000000000000000000000
+
+if big < 0:
+    later = 1
+
+print((big * big) < (p -> later in p))
+# EXPECT ERROR: Undefined variable 'later'.
@@ -0,0 +1,29 @@
+# Operands large enough to take the Karatsuba and Toom-3 paths
+f = 1
+i = 1
+while i < 1201:
+    f = f * i
+    i = i + 1
+
+g = f * f
+print(g % 1000000007)
+print(g / f == f)
+print((g + 12345) % f)
+print(g / (f - 1) - f)
+
+p = 1
+i = 0
+while i < 300:
+    p = p * 18446744073709551557
+    i = i + 1
+print(p * p % 998244353)
+print(p * p / p == p)
+
+# EXPECT START
+# 857456308
+# 1
+# 12345
+# 1
+# 679638038
+# 1
+# EXPECT END
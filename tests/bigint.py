@@ -0,0 +1,42 @@
+x = 1
+i = 0
+while i < 4000:
+    x = x + x
+    i = i + 1
+
+print(x)
+
+# Crossing the inline/heap boundary in both directions
+a = 2305843009213693951
+b = a + 1
+print(b)
+print(b - 1)
+c = 0 - b
+print(c)
+print(c - 1)
+print(-c)
+print(b - b)
+print(c < a)
+print(b > a)
+print(99999999999999999999999999 == 99999999999999999999999999)
+
+y = x - 1
+print(x - y - 1)
+print(x - y)
+print(1 - x)
+
+# EXPECT START
+# 13182040934309431001038897942365913631840191610932727690928034502417569281128344551079752123172122033140940756480716823038446817694240581281731062452512184038544674444386888956328970642771993930036586552924249514488832183389415832375620009284922608946111038578754077913265440918583125586050431647284603636490823850007826811672468900210689104488089485347192152708820119765006125944858397761874669301278745233504796586994514054435217053803732703240283400815926169348364799472716094576894007243168662568886603065832486830606125017643356469732407252874567217733694824236675323341755681839221954693820456072020253884371226826844858636194212875139566587445390068014747975813971748114770439248826688667129237954128555841874460665729630492658600179338272579110020881228767361200603478973120168893997574353727653998969223092798255701666067972698906236921628764772837915526086464389161570534616956703744840502975279094087587298968423516531626090898389351449020056851221079048966718878943309232071978575639877208621237040940126912767610658141079378758043403611425454744180577150855204937163460902512732551260539639221457005977247266676344018155647509515396711351487546062479444592779055555421362722504575706910949376
+# 2305843009213693952
+# 2305843009213693951
+# -2305843009213693952
+# -2305843009213693953
+# 2305843009213693952
+# 0
+# 1
+# 1
+# 1
+# 0
+# 1
+# -13182040934309431001038897942365913631840191610932727690928034502417569281128344551079752123172122033140940756480716823038446817694240581281731062452512184038544674444386888956328970642771993930036586552924249514488832183389415832375620009284922608946111038578754077913265440918583125586050431647284603636490823850007826811672468900210689104488089485347192152708820119765006125944858397761874669301278745233504796586994514054435217053803732703240283400815926169348364799472716094576894007243168662568886603065832486830606125017643356469732407252874567217733694824236675323341755681839221954693820456072020253884371226826844858636194212875139566587445390068014747975813971748114770439248826688667129237954128555841874460665729630492658600179338272579110020881228767361200603478973120168893997574353727653998969223092798255701666067972698906236921628764772837915526086464389161570534616956703744840502975279094087587298968423516531626090898389351449020056851221079048966718878943309232071978575639877208621237040940126912767610658141079378758043403611425454744180577150855204937163460902512732551260539639221457005977247266676344018155647509515396711351487546062479444592779055555421362722504575706910949375
+# EXPECT END
@@ -0,0 +1,36 @@
+a = 100000000000000000000000000000
+b = a * a
+c = b + 1
+
+cat T(x y z):
+    obj:
+        x y z
+    hom:
+        x -> y
+        y -> z
+
+big = T(a b c)
+
+print(100000000000000000000000000000 in big)
+print(a * a in big)
+print(a * a + 1 in big)
+print(a * a + 2 in big)
+print(a -> c in big)
+print(c -> a in big)
+print(a * a - 1 -> c in big)
+print(b -> b in big)
+
+# EXPECT: 1
+# EXPECT: 1
+# EXPECT: 1
+# EXPECT: 0
+# EXPECT: 1
+# EXPECT: 0
+# EXPECT: 0
+# EXPECT: 1
+
+d = a * 10 / 10
+same = T(a d b)
+print(a -> a * a in same)
+
+# EXPECT: 1
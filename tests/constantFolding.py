@@ -0,0 +1,50 @@
+# Constant expressions
+# ==============================
+print(-3)
+print(2 * (3 + 4) - 10 / 3)
+print(1 and 8 or 9 - 6 + 8154)
+print(not (5 > 2))
+print(2 ** 100 % 1000)
+# EXPECT: -3
+# EXPECT: 11
+# EXPECT: 1
+# EXPECT: 0
+# EXPECT: 376
+# ==============================
+
+# Constant conditions
+# ==============================
+if (1 < 0):
+    print(1 / 0)
+elif (2 == 2):
+    print(200)
+else:
+    print(300)
+# EXPECT: 200
+
+while (0):
+    print(400)
+
+x = 0
+while (1 and x < 2):
+    x = x + 1
+print(x)
+# EXPECT: 2
+# ==============================
+
+# Folded values inside categories
+# ==============================
+cat T(a):
+    obj:
+        (1 and 8 or 9) -3 (a * 2) (2 ** 70)
+    hom:
+        -3 -> (2 ** 70)
+
+t = T(5)
+print(1 in t)
+print(-3 -> 1180591620717411303424 in t)
+print(10 in t)
+# EXPECT: 1
+# EXPECT: 1
+# EXPECT: 1
+# ==============================
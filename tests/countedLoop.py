@@ -0,0 +1,47 @@
+# Counters cross the inline range in both directions
+# ==============================
+i = 2305843009213693945
+while i < 2305843009213693955:
+    i = i + 3
+print(i)
+# EXPECT: 2305843009213693957
+
+step = 4611686018427387904
+while i > -10000000000000000000:
+    i = i - step
+print(i)
+# EXPECT: -11529215046068469755
+# ==============================
+
+# Variable steps and bounds, != tests, and the body reading the counter
+# ==============================
+n = 10
+k = 0
+sum = 0
+while k != n:
+    sum = sum + k * k
+    k = k + 2
+print(sum)
+# EXPECT: 120
+
+dividend = 23
+divisor = 5
+while (dividend > 0):
+    dividend = dividend - divisor
+print(dividend)
+# EXPECT: -2
+# ==============================
+
+# Nested counted loops
+# ==============================
+a = 0
+count = 0
+while a < 3:
+    b = a
+    while b < 3:
+        count = count + 1
+        b = b + 1
+    a = a + 1
+print(count)
+# EXPECT: 6
+# ==============================
@@ -0,0 +1,40 @@
+a = 4
+b = -11
+
+print(a * b)
+print(a * b + 1 * 2)
+print(2 + a * 3 - 10 / 4)
+print(-a * -b)
+
+# Division rounds towards negative infinity, the remainder takes the divisor's sign
+x = 7
+y = 2
+print(x / y)
+print(x % y)
+print(-x / y)
+print(-x % y)
+print(x / -y)
+print(x % -y)
+print(-x / -y)
+print(-x % -y)
+print(0 / 5)
+print(123456789123456789123456789 / 987654321)
+print(123456789123456789123456789 % 987654321)
+
+# EXPECT START
+# -44
+# -42
+# 12
+# -44
+# 3
+# 1
+# -4
+# 1
+# -4
+# -1
+# 3
+# -1
+# 0
+# 124999998985937499
+# 173610
+# EXPECT END
@@ -0,0 +1,54 @@
+# Loops of small-integer arithmetic, which the JIT runs natively
+# ==============================
+i = 0
+total = 0
+while i < 5000:
+    if i > 2500 and not (i == 4000 or i == 4001):
+        total = total + i * 3
+    else:
+        total = total - i
+    i = i + 1
+print(total)
+# EXPECT: 24955496
+# ==============================
+
+# Overflowing the inline range bails out to the interpreter, which carries
+# on with big integers
+# ==============================
+x = 1
+n = 0
+while n < 100:
+    x = x * 3
+    n = n + 1
+print(x)
+# EXPECT: 515377520732011331036461129765621272702107522001
+
+y = 2305843009213693000
+while y < 2305843009213694000:
+    y = y + 7
+print(y)
+# EXPECT: 2305843009213694001
+
+z = 0
+while z > -3000000000000000000:
+    z = z - 1000000000000000000
+print(-z)
+# EXPECT: 3000000000000000000
+# ==============================
+
+# Nested loops, and a variable first assigned inside the loop
+# ==============================
+a = 0
+count = 0
+while a < 60:
+    b = 0
+    while b < a:
+        last = a - b
+        count = count + 1
+        b = b + 1
+    a = a + 1
+print(count)
+print(last)
+# EXPECT: 1770
+# EXPECT: 1
+# ==============================
@@ -0,0 +1,15 @@
+# The file ends inside a block, with no newline after its last line
+i = 0
+while i < 3:
+    print(i)
+    i = i + 1
+
+# EXPECT START
+# 0
+# 1
+# 2
+# 30
+# EXPECT END
+
+if i == 3:
+    print(i * 10)
\ No newline at end of file
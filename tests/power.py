@@ -0,0 +1,28 @@
+print(2 ** 10)
+print(2 ** 3 ** 2)
+print(-2 ** 2)
+print((-2) ** 3)
+print(10 ** 0)
+print(0 ** 0)
+print(2 ** 4096 % 100000000000000000000)
+
+# EXPECT: 1024
+# EXPECT: 512
+# EXPECT: -4
+# EXPECT: -8
+# EXPECT: 1
+# EXPECT: 1
+# EXPECT: 4708340403154190336
+
+# Three-argument modular power, odd and even moduli
+print(3 ** 1000000000000000000000000000000 % 1000000007)
+print(7 ** 100000000000000000000 % 18446744073709551616)
+print(12345678901234567890 ** 65537 % 170141183460469231731687303715884105727)
+print((-5) ** 77 % -1000)
+print(5 ** 3 % 1)
+
+# EXPECT: 965115194
+# EXPECT: 7795500593962811393
+# EXPECT: 127352203508635771842305703701533661349
+# EXPECT: -125
+# EXPECT: 0
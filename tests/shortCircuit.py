@@ -0,0 +1,47 @@
+x = 0
+y = 1
+
+# The right operand is skipped once the left one decides
+# ==============================
+if x and 1 / x:
+    print(1)
+else:
+    print(2)
+# EXPECT: 2
+
+print(y or undefined)
+print(x and undefined)
+print(not (x and undefined))
+# EXPECT: 1
+# EXPECT: 0
+# EXPECT: 1
+# ==============================
+
+# Both operands are used when needed
+# ==============================
+while x < 3 and y:
+    x = x + 1
+print(x)
+print(x > 2 or y > 2)
+print(x > 5 or y > 2)
+# EXPECT: 3
+# EXPECT: 1
+# EXPECT: 0
+# ==============================
+
+# Membership tests stop early too
+# ==============================
+cat T(a):
+    obj:
+        a 2
+    hom:
+        a -> 2
+
+t = T(1)
+print(1 -> 2 in t and 2 in t)
+print(3 in t and 1 -> 2 in t)
+print(3 in t or 1 -> 2 in t)
+# EXPECT: 1
+# EXPECT: 0
+# EXPECT: 1
+# ==============================
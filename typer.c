@@ -0,0 +1,399 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "interpreter.h"
+#include "object.h"
+#include "typer.h"
+
+// The value types a variable or expression may have, one bit per ValueType.
+// VALUE_NULL stands for a variable not assigned yet.
+typedef uint8_t TypeSet;
+
+#define TYPE(valueType) ((TypeSet)(1 << (valueType)))
+#define TYPE_NUMBER     TYPE(VALUE_NUMBER)
+#define TYPE_CATEGORY   TYPE(VALUE_CATEGORY)
+#define TYPE_TEMPLATE   TYPE(VALUE_CAT_TEMPLATE)
+#define TYPE_NULL       TYPE(VALUE_NULL)
+#define TYPE_ANY        (TYPE_NUMBER | TYPE_CATEGORY | TYPE_TEMPLATE | TYPE_NULL)
+
+typedef struct {
+    TypeSet* vars;      // By global slot, at the current point of the program
+    int count;
+    bool reached;       // Runs whenever the program does, with no loop before it that might not finish
+    bool certain;       // No check before this point could have failed
+    bool failed;
+} Typer;
+
+static Typer typer;
+
+// A failure is only certain, and reported, when the program gets that far.
+// Anything after it may not run.
+static void fail(const char* format, ...) {
+    bool report = typer.reached && typer.certain;
+    typer.certain = false;
+    if (!report) return;
+    typer.failed = true;
+
+    flushOutput(&interp.out);
+
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+}
+
+static void mayFail() {
+    typer.certain = false;
+}
+
+static bool single(TypeSet set, ValueType* type) {
+    for (int i = VALUE_NUMBER; i <= VALUE_NULL; ++i) {
+        if (set == TYPE(i)) {
+            *type = (ValueType)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static StaticType staticOf(TypeSet set) {
+    switch (set) {
+        case TYPE_NUMBER:   return STATIC_NUMBER;
+        case TYPE_CATEGORY: return STATIC_CATEGORY;
+        case TYPE_TEMPLATE: return STATIC_TEMPLATE;
+        default:            return STATIC_UNKNOWN;
+    }
+}
+
+static TypeSet* saveVars() {
+    TypeSet* saved = malloc(sizeof(TypeSet) * (typer.count + 1));
+    memcpy(saved, typer.vars, sizeof(TypeSet) * typer.count);
+    return saved;
+}
+
+static TypeSet typeExpr(Expr* expr);
+static bool typeCondition(Expr* expr);
+
+// Returns the types the variable has once read, an undefined one fails
+static TypeSet typeVar(ExprVar* var) {
+    if (var->slot < 0) {
+        mayFail();
+        return TYPE_ANY & ~TYPE_NULL;
+    }
+
+    TypeSet set = typer.vars[var->slot];
+    if (set == TYPE_NULL) {
+        fail("Undefined variable '%.*s'.", var->name->length, var->name->chars);
+    } else if (set & TYPE_NULL) {
+        mayFail();
+    }
+
+    var->staticType = staticOf(set);
+    return set & ~TYPE_NULL;
+}
+
+// Whether both operands are certainly numbers, so the operator needs no check
+static bool numbers(TypeSet left, TypeSet right) {
+    ValueType leftType, rightType;
+    if (single(left, &leftType) && single(right, &rightType) &&
+        (leftType != VALUE_NUMBER || rightType != VALUE_NUMBER)) {
+        fail("Binary operators can only be applied to numbers.\n"
+                "But got values of types '%s' and '%s'",
+                typeName(leftType), typeName(rightType));
+    }
+
+    bool checked = left == TYPE_NUMBER && right == TYPE_NUMBER;
+    if (!checked) mayFail();
+    return checked;
+}
+
+// `and` and `or` may skip their right operand
+static bool typeLogical(ExprBinary* expr) {
+    bool left = typeCondition(expr->left);
+
+    bool reached = typer.reached;
+    typer.reached = false;
+    bool right = typeCondition(expr->right);
+    typer.reached = reached;
+
+    expr->staticType = left && right ? STATIC_NUMBER : STATIC_UNKNOWN;
+    return left && right;
+}
+
+static TypeSet typeBinary(ExprBinary* expr) {
+    if (expr->operator == TOKEN_AND || expr->operator == TOKEN_OR) {
+        typeLogical(expr);
+        return TYPE_NUMBER;
+    }
+
+    TypeSet left = typeExpr(expr->left);
+    TypeSet right = typeExpr(expr->right);
+    expr->staticType = numbers(left, right) ? STATIC_NUMBER : STATIC_UNKNOWN;
+
+    // Only a constant nonzero divisor certainly divides
+    Expr* divisor = expr->right;
+    switch (expr->operator) {
+        case TOKEN_SLASH:
+        case TOKEN_PERCENT:
+            if (divisor->type != EXPR_NUMBER || bigint_is_zero(&((ExprNumber*)divisor)->value)) {
+                mayFail();
+            }
+            break;
+        case TOKEN_STAR_STAR:
+            mayFail();
+            break;
+        default:
+            break;
+    }
+    return TYPE_NUMBER;
+}
+
+static TypeSet typeUnary(ExprUnary* expr) {
+    TypeSet set = typeExpr(expr->right);
+
+    ValueType type;
+    if (single(set, &type) && type != VALUE_NUMBER) {
+        fail("Unary operator can only be applied to numbers.\n"
+                "But got value of type '%s'",
+                typeName(type));
+    } else if (set != TYPE_NUMBER) {
+        mayFail();
+    }
+
+    expr->staticType = set == TYPE_NUMBER ? STATIC_NUMBER : STATIC_UNKNOWN;
+    return TYPE_NUMBER;
+}
+
+static TypeSet typePowMod(ExprPowMod* expr) {
+    TypeSet base = typeExpr(expr->base);
+    TypeSet exponent = typeExpr(expr->exponent);
+    TypeSet modulus = typeExpr(expr->modulus);
+
+    bool checked = numbers(base, exponent);
+    checked = numbers(base, modulus) && checked;
+    expr->staticType = checked ? STATIC_NUMBER : STATIC_UNKNOWN;
+    mayFail();      // On a negative exponent or a zero modulus
+    return TYPE_NUMBER;
+}
+
+// Elements can be of any type, only the category is checked. The VM reads
+// the element first and the tree walker the category, so only a category
+// check after an element that cannot fail is certain.
+static TypeSet typeIn(ExprIn* expr) {
+    bool reached = typer.reached;
+    typer.reached = false;
+    if (expr->element->type == EXPR_MORPHISM) {
+        ExprMorphism* morph = (ExprMorphism*)expr->element;
+        typeExpr(morph->from);
+        typeExpr(morph->to);
+    } else {
+        typeExpr(expr->element);
+    }
+    typer.reached = reached;
+
+    TypeSet set = expr->name->slot >= 0 ? typer.vars[expr->name->slot] : TYPE_ANY;
+
+    ValueType type;
+    if (single(set, &type) && type != VALUE_CATEGORY) {
+        fail("Expected a variable of type category after 'in', but got '%s'.", typeName(type));
+    } else if (set != TYPE_CATEGORY) {
+        mayFail();
+    }
+    expr->name->staticType = staticOf(set);
+
+    expr->expr.staticType = set == TYPE_CATEGORY ? STATIC_NUMBER : STATIC_UNKNOWN;
+    return TYPE_NUMBER;
+}
+
+static TypeSet typeExpr(Expr* expr) {
+    switch (expr->type) {
+        case EXPR_NUMBER:   return TYPE_NUMBER;
+        case EXPR_VAR:      return typeVar((ExprVar*)expr);
+        case EXPR_BINARY:   return typeBinary((ExprBinary*)expr);
+        case EXPR_UNARY:    return typeUnary((ExprUnary*)expr);
+        case EXPR_POWMOD:   return typePowMod((ExprPowMod*)expr);
+        case EXPR_IN:       return typeIn((ExprIn*)expr);
+        default:            return TYPE_NULL;    // Morphisms have no value of their own
+    }
+}
+
+// Mirrors interpretCondition, which checks the operands of `and`, `or` and
+// `not` as conditions. Returns whether no check is needed.
+static bool typeCondition(Expr* expr) {
+    if (expr->type == EXPR_BINARY) {
+        ExprBinary* binary = (ExprBinary*)expr;
+        if (binary->operator == TOKEN_AND || binary->operator == TOKEN_OR) {
+            return typeLogical(binary);
+        }
+    }
+
+    if (expr->type == EXPR_UNARY && ((ExprUnary*)expr)->operator == TOKEN_NOT) {
+        ExprUnary* unary = (ExprUnary*)expr;
+        bool checked = typeCondition(unary->right);
+        unary->staticType = checked ? STATIC_NUMBER : STATIC_UNKNOWN;
+        return checked;
+    }
+
+    TypeSet set = typeExpr(expr);
+
+    ValueType type;
+    if (single(set, &type) && type != VALUE_NUMBER) {
+        fail("Conditions can only be numbers.\n"
+                "But got value of type '%s'",
+                typeName(type));
+    } else if (set != TYPE_NUMBER) {
+        mayFail();
+    }
+    return set == TYPE_NUMBER;
+}
+
+// Categories and templates are only ever read from the variable they were
+// bound to, so that variable names them in the message
+static void typeStorable(Expr* expr, TypeSet set, const char* action) {
+    if (expr->type != EXPR_VAR) return;
+
+    ValueType type;
+    if (single(set, &type) && (type == VALUE_CATEGORY || type == VALUE_CAT_TEMPLATE)) {
+        fail("Cannot %s variable '%s' of type '%s'.",
+             action, ((ExprVar*)expr)->name->chars, typeName(type));
+    } else if (set & (TYPE_CATEGORY | TYPE_TEMPLATE)) {
+        mayFail();
+    }
+}
+
+static void typeCategory(StmtAssign* stmt) {
+    ExprCatInit* init = (ExprCatInit*)stmt->right;
+
+    int slot = findGlobalSlot(&interp.globals, init->callee);
+    TypeSet callee = slot >= 0 ? typer.vars[slot] : TYPE_NULL;
+    ValueType type;
+    if (single(callee, &type) && type != VALUE_CAT_TEMPLATE) {
+        fail("Expected a variable of type 'Category Template', but got '%.*s' of type '%s'.",
+             init->callee->length, init->callee->chars, typeName(type));
+    }
+
+    // The argument count is checked first, and it depends on the template.
+    // Building the category checks its objects and morphisms as well.
+    mayFail();
+    for (int i = 0; i < init->argCount; ++i) {
+        typeExpr(init->args[i]);
+    }
+
+    typer.vars[stmt->left->slot] = TYPE_CATEGORY;
+}
+
+static void typeStmts(Stmt* stmt);
+
+static void typeIf(StmtIf* stmt) {
+    typeCondition(stmt->condition);
+
+    bool reached = typer.reached;
+    typer.reached = false;
+    TypeSet* before = saveVars();
+
+    typeStmts(stmt->thenBranch);
+    TypeSet* afterThen = saveVars();
+
+    memcpy(typer.vars, before, sizeof(TypeSet) * typer.count);
+    typeStmts(stmt->elseBranch);
+
+    for (int i = 0; i < typer.count; ++i) {
+        typer.vars[i] |= afterThen[i];
+    }
+
+    typer.reached = reached;
+    free(before);
+    free(afterThen);
+}
+
+// The body is typed again with the types it leaves behind until they stop
+// growing, so the last pass describes every iteration
+static void typeWhile(StmtWhile* stmt) {
+    bool reached = typer.reached;
+    TypeSet* head = saveVars();
+
+    for (bool first = true;; first = false) {
+        memcpy(typer.vars, head, sizeof(TypeSet) * typer.count);
+
+        typer.reached = reached && first;
+        typeCondition(stmt->condition);
+        typer.reached = false;
+        typeStmts(stmt->body);
+
+        bool grew = false;
+        for (int i = 0; i < typer.count; ++i) {
+            TypeSet joined = head[i] | typer.vars[i];
+            if (joined != head[i]) grew = true;
+            head[i] = joined;
+        }
+        if (!grew) break;
+    }
+
+    memcpy(typer.vars, head, sizeof(TypeSet) * typer.count);
+    free(head);
+
+    // Whether a loop finishes is not known, so code after it may never run
+    // unless the loop never runs at all
+    Expr* condition = stmt->condition;
+    typer.reached = reached && condition->type == EXPR_NUMBER &&
+                    bigint_is_zero(&((ExprNumber*)condition)->value);
+}
+
+static void typeStmts(Stmt* stmt) {
+    for (; stmt != NULL; stmt = stmt->next) {
+        switch (stmt->type) {
+            case STMT_ASSIGN: {
+                StmtAssign* assign = (StmtAssign*)stmt;
+                if (assign->right->type == EXPR_CAT_INIT) {
+                    typeCategory(assign);
+                    break;
+                }
+
+                TypeSet set = typeExpr(assign->right);
+                typeStorable(assign->right, set, "assign");
+                typer.vars[assign->left->slot] = set & (TYPE_NUMBER | TYPE_NULL);
+                break;
+            }
+
+            case STMT_PRINT: {
+                Expr* expr = ((StmtPrint*)stmt)->expr;
+                typeStorable(expr, typeExpr(expr), "print");
+                break;
+            }
+
+            case STMT_IF:
+                typeIf((StmtIf*)stmt);
+                break;
+
+            case STMT_WHILE:
+                typeWhile((StmtWhile*)stmt);
+                break;
+
+            case STMT_CAT: {
+                int slot = findGlobalSlot(&interp.globals, ((StmtCat*)stmt)->name);
+                typer.vars[slot] = TYPE_TEMPLATE;
+                break;
+            }
+        }
+    }
+}
+
+bool inferTypes(Stmt* stmts) {
+    typer.count = interp.globals.count;
+    typer.vars = malloc(sizeof(TypeSet) * (typer.count + 1));
+    for (int i = 0; i < typer.count; ++i) {
+        typer.vars[i] = TYPE(interp.globals.values[i].type);
+    }
+    typer.reached = true;
+    typer.certain = true;
+    typer.failed = false;
+
+    typeStmts(stmts);
+
+    free(typer.vars);
+    typer.vars = NULL;
+    return !typer.failed;
+}
@@ -0,0 +1,14 @@
+#ifndef cryton_typer_h
+#define cryton_typer_h
+
+#include "parser.h"
+
+// Follows the types each variable can hold through the program and sets
+// staticType on every expression whose checks cannot fail. Variables start
+// out with the types of their current values, so a resolved program can be
+// checked again before each run. When a check certainly fails in code that
+// runs whenever the program gets that far, reports it like the runtime
+// error and returns false.
+bool inferTypes(Stmt* stmts);
+
+#endif
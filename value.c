@@ -1,4 +1,7 @@
+#include <stdlib.h>
+
 #include "stdbool.h"
+#include "parser.h"
 #include "value.h"
 
 bool valuesEqual(Value a, Value b) {
@@ -8,9 +11,63 @@ bool valuesEqual(Value a, Value b) {
 
     switch (a.type) {
         case VALUE_NUMBER:
-            return (bigint_abs_compare(&a.number, &b.number) == 0);
+            return bigint_equal(&a.number, &b.number);
         default:
             // compare pointers
             return a.category == b.category;
     }
-}
\ No newline at end of file
+}
+
+Value copyValue(Value value) {
+    switch (value.type) {
+        case VALUE_NUMBER:          value.number = bigint_copy(&value.number); break;
+        case VALUE_CATEGORY:        value.category->refs++; break;
+        case VALUE_CAT_TEMPLATE:    value.template->refs++; break;
+        default:                    break;
+    }
+    return value;
+}
+
+void freeValue(Value* value) {
+    switch (value->type) {
+        case VALUE_NUMBER:
+            bigint_free(&value->number);
+            break;
+        case VALUE_CATEGORY:
+            if (--value->category->refs == 0) freeCategory(value->category);
+            break;
+        case VALUE_CAT_TEMPLATE:
+            if (--value->template->refs == 0) freeTemplate(value->template);
+            break;
+        default:
+            break;
+    }
+}
+
+void freeCategory(RuntimeCategory* cat) {
+    if (cat == NULL) return;
+
+    // Drop the references; the arrays go with the arena
+    for (int i = 0; i < cat->objects.count; i++) {
+        freeValue(&cat->objects.values[i]);
+    }
+
+    for (int i = 0; i < cat->homset.count; i++) {
+        Morphism* m = &cat->homset.morphisms[i];
+        freeValue(&m->from);
+        for (int j = 0; j < m->toCount; j++) {
+            freeValue(&m->to[j]);
+        }
+    }
+
+    // The category itself is in the arena, so copy it out first
+    Arena arena = cat->arena;
+    freeArena(&arena);
+}
+
+void freeTemplate(CategoryTemplate* templ) {
+    if (templ == NULL) return;
+
+    releaseAst(templ->ast);
+    free(templ);
+}
@@ -1,6 +1,7 @@
 #ifndef cryton_value_h
 #define cryton_value_h
 
+#include "arena.h"
 #include "bigint.h"
 
 typedef struct ObjString ObjString;
@@ -15,6 +16,8 @@ typedef enum {
     VALUE_NULL
 } ValueType;
 
+// A 16-byte cell: numbers are either inline or a shared, immutable BigNum,
+// so copying a Value never copies digits.
 typedef struct {
     ValueType type;
     union {
@@ -24,6 +27,8 @@ typedef struct {
     };
 } Value;
 
+_Static_assert(sizeof(Value) == 16, "Value must stay a 16-byte cell");
+
 typedef struct {
     Value* values;
     int count;
@@ -40,10 +45,13 @@ typedef struct {
     int count;
 } HomSet;
 
+// The struct, its arrays and every morphism's targets live in `arena`
 struct RuntimeCategory {
     ObjString* name;
     ObjectList objects;
     HomSet homset;
+    Arena arena;
+    int refs;
 };
 
 typedef struct ExprObjects {
@@ -68,8 +76,17 @@ struct CategoryTemplate {
     int paramCount;
     TmplObjects objects;
     TmplHomSet homset;
+    int toCount;        // Targets across all morphisms
+    struct Ast* ast;    // Holds the nodes above, released with the template
+    int refs;
 };
 
 bool valuesEqual(Value a, Value b);
+// A Value holds a reference to whatever it contains. Categories and
+// templates are freed with their last reference, like heap numbers.
+Value copyValue(Value value);
+void freeValue(Value* value);
+void freeCategory(RuntimeCategory* cat);
+void freeTemplate(CategoryTemplate* templ);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,423 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "common.h"
+#include "interpreter.h"
+#include "object.h"
+#include "vm.h"
+
+// Threaded dispatch needs labels as values, which CompCert lacks
+#if defined(__GNUC__) && !defined(__COMPCERT__) && !defined(VM_NO_COMPUTED_GOTO)
+    #define VM_COMPUTED_GOTO
+#endif
+
+static VM vm;
+
+void freeVM() {
+    if (vm.stack == NULL) return;
+
+    while (vm.stackTop > vm.stack) {
+        freeValue(--vm.stackTop);
+    }
+    free(vm.stack);
+    vm.stack = vm.stackTop = NULL;
+}
+
+static void checkNumbers(Value* a, Value* b) {
+    if (a->type != VALUE_NUMBER || b->type != VALUE_NUMBER) {
+        binaryTypeError(a, false, b, false);
+    }
+}
+
+static void undefinedVariable(uint32_t slot) {
+    ObjString* name = interp.globals.names[slot];
+    runtimeError("Undefined variable '%.*s'.", name->length, name->chars);
+}
+
+static Value* globalValue(uint32_t slot) {
+    Value* value = &interp.globals.values[slot];
+    if (value->type == VALUE_NULL) undefinedVariable(slot);
+    return value;
+}
+
+static Value* directValue(Chunk* chunk, uint8_t kind, uint32_t index) {
+    return kind == OPERAND_GLOBAL ? globalValue(index) : &chunk->constants[index];
+}
+
+// Updates a global in place. Inline values never leave the machine word;
+// the sum spills to the heap only once it outgrows 62 bits.
+static void stepGlobal(uint32_t slot, Value* step, bool subtract) {
+    Value* counter = globalValue(slot);
+    checkNumbers(counter, step);
+
+    BigInt* num = &counter->number;
+    if (BIGINT_IS_SMALL(num) && BIGINT_IS_SMALL(&step->number)) {
+        int64_t a = BIGINT_SMALL_VALUE(num);
+        int64_t b = BIGINT_SMALL_VALUE(&step->number);
+        int64_t result = subtract ? a - b : a + b;
+
+        if (result >= BIGINT_SMALL_MIN && result <= BIGINT_SMALL_MAX) {
+            *num = BIGINT_SMALL(result);
+            return;
+        }
+    }
+
+    if (subtract) {
+        bigint_sub_inplace(num, &step->number);
+    } else {
+        bigint_add_inplace(num, &step->number);
+    }
+}
+
+static bool compareValues(OpCode compare, Value* a, Value* b) {
+    checkNumbers(a, b);
+
+    int order;
+    if (BIGINT_IS_SMALL(&a->number) && BIGINT_IS_SMALL(&b->number)) {
+        int64_t x = BIGINT_SMALL_VALUE(&a->number);
+        int64_t y = BIGINT_SMALL_VALUE(&b->number);
+        order = (x > y) - (x < y);
+    } else {
+        order = bigint_abs_compare(&a->number, &b->number);
+    }
+
+    switch (compare) {
+        case OP_LESS:       return order < 0;
+        case OP_GREATER:    return order > 0;
+        case OP_EQUAL:      return order == 0;
+        default:            return order != 0;
+    }
+}
+
+static void checkNumber(Value* value) {
+    if (value->type != VALUE_NUMBER) {
+        runtimeError("Unary operator can only be applied to numbers.\n"
+                        "But got value of type '%s'",
+                        typeName(value->type));
+    }
+}
+
+static void setBool(Value* slot, bool result) {
+    freeValue(slot);
+    slot->type = VALUE_NUMBER;
+    slot->number = BIGINT_FROM_BOOL(result);
+}
+
+static inline uint32_t readWord(const uint8_t* code) {
+    uint32_t word;
+    memcpy(&word, code, sizeof(word));
+    return word;
+}
+
+// Every value on the stack is owned by it, so an instruction that fails
+// leaves its operands in place for freeVM to release.
+void runVM(Chunk* chunk) {
+    freeVM();
+    vm.stack = malloc(sizeof(Value) * (chunk->maxStack + 1));
+    vm.stackTop = vm.stack;
+
+    uint8_t* ip = chunk->code;
+
+#define READ_WORD()     (ip += 4, readWord(ip - 4))
+#define PEEK(distance)  (vm.stackTop - 1 - (distance))
+#define READ_DIRECT()   (ip += 5, directValue(chunk, ip[-5], readWord(ip - 4)))
+
+#ifdef VM_COMPUTED_GOTO
+    static void* dispatchTable[] = {
+    #define OPCODE_LABEL(name) &&op_##name,
+        OPCODES(OPCODE_LABEL)
+    #undef OPCODE_LABEL
+    };
+
+    #define CASE(name)  op_##name
+    #define DISPATCH()  goto *dispatchTable[*ip++]
+
+    DISPATCH();
+#else
+    #define CASE(name)  case OP_##name
+    #define DISPATCH()  continue
+#endif
+
+    for (;;) {
+        switch (*ip++) {
+            CASE(CONSTANT): {
+                *vm.stackTop++ = copyValue(chunk->constants[READ_WORD()]);
+                DISPATCH();
+            }
+
+            CASE(FALSE): {
+                vm.stackTop->type = VALUE_NUMBER;
+                vm.stackTop->number = BIGINT_ZERO;
+                vm.stackTop++;
+                DISPATCH();
+            }
+
+            CASE(TRUE): {
+                vm.stackTop->type = VALUE_NUMBER;
+                vm.stackTop->number = BIGINT_ONE;
+                vm.stackTop++;
+                DISPATCH();
+            }
+
+            CASE(POP): {
+                freeValue(--vm.stackTop);
+                DISPATCH();
+            }
+
+            CASE(GET_GLOBAL): {
+                *vm.stackTop++ = copyValue(*globalValue(READ_WORD()));
+                DISPATCH();
+            }
+
+            CASE(SET_GLOBAL): {
+                uint32_t slot = READ_WORD();
+                checkStorable(PEEK(0), "assign");
+                setGlobal(&interp.globals, slot, *--vm.stackTop);
+                DISPATCH();
+            }
+
+            CASE(ADD): {
+                Value* a = PEEK(1);
+                Value* b = PEEK(0);
+                checkNumbers(a, b);
+                bigint_add_inplace(&a->number, &b->number);
+                freeValue(--vm.stackTop);
+                DISPATCH();
+            }
+
+            CASE(SUBTRACT): {
+                Value* a = PEEK(1);
+                Value* b = PEEK(0);
+                checkNumbers(a, b);
+                bigint_sub_inplace(&a->number, &b->number);
+                freeValue(--vm.stackTop);
+                DISPATCH();
+            }
+
+            CASE(MULTIPLY): {
+                Value* a = PEEK(1);
+                Value* b = PEEK(0);
+                checkNumbers(a, b);
+                bigint_mul(&a->number, &a->number, &b->number);
+                freeValue(--vm.stackTop);
+                DISPATCH();
+            }
+
+            CASE(DIVIDE): {
+                Value* a = PEEK(1);
+                Value* b = PEEK(0);
+                checkNumbers(a, b);
+                if (!bigint_divmod(&a->number, NULL, &a->number, &b->number)) {
+                    runtimeError("Division by zero.");
+                }
+                freeValue(--vm.stackTop);
+                DISPATCH();
+            }
+
+            CASE(MODULO): {
+                Value* a = PEEK(1);
+                Value* b = PEEK(0);
+                checkNumbers(a, b);
+                if (!bigint_divmod(NULL, &a->number, &a->number, &b->number)) {
+                    runtimeError("Division by zero.");
+                }
+                freeValue(--vm.stackTop);
+                DISPATCH();
+            }
+
+            CASE(POWER): {
+                Value* a = PEEK(1);
+                Value* b = PEEK(0);
+                checkNumbers(a, b);
+                if (bigint_is_negative(&b->number)) runtimeError("Negative exponent.");
+                if (!bigint_pow(&a->number, &a->number, &b->number)) runtimeError("Exponent too large.");
+                freeValue(--vm.stackTop);
+                DISPATCH();
+            }
+
+            CASE(POWMOD): {
+                Value* base = PEEK(2);
+                Value* exponent = PEEK(1);
+                Value* modulus = PEEK(0);
+                checkNumbers(base, exponent);
+                checkNumbers(base, modulus);
+                if (bigint_is_negative(&exponent->number)) runtimeError("Negative exponent.");
+                if (!bigint_powmod(&base->number, &base->number, &exponent->number, &modulus->number)) {
+                    runtimeError("Division by zero.");
+                }
+                freeValue(--vm.stackTop);
+                freeValue(--vm.stackTop);
+                DISPATCH();
+            }
+
+            CASE(LESS): {
+                Value* a = PEEK(1);
+                Value* b = PEEK(0);
+                checkNumbers(a, b);
+                bool result = bigint_abs_compare(&a->number, &b->number) < 0;
+                freeValue(--vm.stackTop);
+                setBool(a, result);
+                DISPATCH();
+            }
+
+            CASE(GREATER): {
+                Value* a = PEEK(1);
+                Value* b = PEEK(0);
+                checkNumbers(a, b);
+                bool result = bigint_abs_compare(&a->number, &b->number) > 0;
+                freeValue(--vm.stackTop);
+                setBool(a, result);
+                DISPATCH();
+            }
+
+            CASE(EQUAL): {
+                Value* a = PEEK(1);
+                Value* b = PEEK(0);
+                checkNumbers(a, b);
+                bool result = bigint_equal(&a->number, &b->number);
+                freeValue(--vm.stackTop);
+                setBool(a, result);
+                DISPATCH();
+            }
+
+            CASE(NOT_EQUAL): {
+                Value* a = PEEK(1);
+                Value* b = PEEK(0);
+                checkNumbers(a, b);
+                bool result = !bigint_equal(&a->number, &b->number);
+                freeValue(--vm.stackTop);
+                setBool(a, result);
+                DISPATCH();
+            }
+
+            CASE(NEGATE): {
+                checkNumber(PEEK(0));
+                bigint_negate(&PEEK(0)->number);
+                DISPATCH();
+            }
+
+            CASE(NOT): {
+                checkNumber(PEEK(0));
+                setBool(PEEK(0), bigint_is_zero(&PEEK(0)->number));
+                DISPATCH();
+            }
+
+            CASE(JUMP): {
+                uint32_t offset = READ_WORD();
+                ip += offset;
+                DISPATCH();
+            }
+
+            CASE(JUMP_IF_FALSE): {
+                uint32_t offset = READ_WORD();
+                if (!conditionValue(PEEK(0))) ip += offset;
+                freeValue(--vm.stackTop);
+                DISPATCH();
+            }
+
+            CASE(JUMP_IF_TRUE): {
+                uint32_t offset = READ_WORD();
+                if (conditionValue(PEEK(0))) ip += offset;
+                freeValue(--vm.stackTop);
+                DISPATCH();
+            }
+
+            CASE(LOOP): {
+                uint32_t offset = READ_WORD();
+                ip -= offset;
+                DISPATCH();
+            }
+
+            CASE(INCREMENT): {
+                uint32_t slot = READ_WORD();
+                stepGlobal(slot, READ_DIRECT(), false);
+                DISPATCH();
+            }
+
+            CASE(DECREMENT): {
+                uint32_t slot = READ_WORD();
+                stepGlobal(slot, READ_DIRECT(), true);
+                DISPATCH();
+            }
+
+            CASE(LOOP_IF): {
+                OpCode compare = *ip++;
+                Value* counter = globalValue(READ_WORD());
+                Value* bound = READ_DIRECT();
+                uint32_t offset = READ_WORD();
+                if (compareValues(compare, counter, bound)) ip -= offset;
+                DISPATCH();
+            }
+
+            CASE(JIT_LOOP): {
+                StmtWhile* loop = (StmtWhile*)chunk->nodes[READ_WORD()];
+                uint32_t offset = READ_WORD();
+                if (runJitLoop(loop)) ip += offset;
+                DISPATCH();
+            }
+
+            CASE(GET_CATEGORY): {
+                ExprIn* in = (ExprIn*)chunk->nodes[READ_WORD()];
+                vm.stackTop->type = VALUE_CATEGORY;
+                vm.stackTop->category = getCategory(in->name);
+                vm.stackTop->category->refs++;
+                vm.stackTop++;
+                DISPATCH();
+            }
+
+            CASE(IN_OBJECT): {
+                RuntimeCategory* cat = PEEK(1)->category;
+
+                Value obj;
+                bool result = canonicalValue(PEEK(0), &obj) && isObjectInCategory(cat, &obj);
+                freeValue(--vm.stackTop);
+                setBool(PEEK(0), result);
+                DISPATCH();
+            }
+
+            CASE(IN_MORPHISM): {
+                RuntimeCategory* cat = PEEK(2)->category;
+
+                Value from, to;
+                bool result = canonicalValue(PEEK(1), &from) && canonicalValue(PEEK(0), &to) &&
+                    (valuesEqual(from, to)
+                        ? isObjectInCategory(cat, &from)
+                        : isMorphismInCategory(cat, &from, &to));
+                freeValue(--vm.stackTop);
+                freeValue(--vm.stackTop);
+                setBool(PEEK(0), result);
+                DISPATCH();
+            }
+
+            CASE(PRINT): {
+                checkStorable(PEEK(0), "print");
+                writeNumber(&interp.out, &PEEK(0)->number);
+                writeNewline(&interp.out);
+                freeValue(--vm.stackTop);
+                DISPATCH();
+            }
+
+            CASE(DEFINE_TEMPLATE): {
+                interpretCategoryTemplate((StmtCat*)chunk->nodes[READ_WORD()]);
+                DISPATCH();
+            }
+
+            CASE(INIT_CATEGORY): {
+                ExprCatInit* init = (ExprCatInit*)chunk->nodes[READ_WORD()];
+                interpretCategory(init, interp.globals.names[READ_WORD()]);
+                DISPATCH();
+            }
+
+            CASE(RETURN): {
+                freeVM();
+                return;
+            }
+        }
+    }
+
+#undef READ_WORD
+#undef PEEK
+#undef READ_DIRECT
+#undef CASE
+#undef DISPATCH
+}
@@ -0,0 +1,17 @@
+#ifndef cryton_vm_h
+#define cryton_vm_h
+
+#include "chunk.h"
+
+typedef struct {
+    Value* stack;
+    Value* stackTop;
+} VM;
+
+// Runs a compiled chunk against the interpreter's globals. Runtime errors
+// unwind through interp.errJmpBuf and leave the stack for freeVM.
+void runVM(Chunk* chunk);
+// Releases whatever the last run left on the stack
+void freeVM();
+
+#endif